@@ -7,6 +7,7 @@
 #include "Serialization/JsonReader.h"
 #include "Dom/JsonObject.h"
 #include "Misc/Base64.h"
+#include "Misc/Paths.h"
 
 #include "WebSocketsModule.h"
 #include "IWebSocket.h"
@@ -593,6 +594,11 @@ void UAudioStreamHttpWsSubsystem::ServerDistributeAudio(const FString& Key, cons
 
 void UAudioStreamHttpWsSubsystem::HandleUdpBinary(const TArray<uint8>& Data, const FIPv4Endpoint& Remote)
 {
+    if (PacketCapture.IsActive())
+    {
+        PacketCapture.Append(MSP_NowMicroseconds(), Data);
+    }
+
     FMediaPacketHeader H;
     if (!MSP_ParseHeader(Data, H)) return;
     const uint8* Payload = Data.GetData() + sizeof(FMediaPacketHeader);
@@ -638,7 +644,7 @@ void UAudioStreamHttpWsSubsystem::HandleUdpBinary(const TArray<uint8>& Data, con
                     FScopeLock L(&StreamCS);
                     StreamIdToKey.FindOrAdd((uint16)StreamId) = Key;
                     FClientStreamState& CS = ClientStreams.FindOrAdd((uint16)StreamId);
-                    CS.SampleRate = SR; CS.Channels = CH; CS.bHasFormat = true; CS.bPreRollReady = false; CS.Frames.Reset();
+                    CS.SampleRate = SR; CS.Channels = CH; CS.bHasFormat = true; CS.Jitter.Reset();
                 }
                 const double LocalUs = FPlatformTime::Seconds()*1000000.0;
                 const double Off = (double)ServerUs - LocalUs;
@@ -675,25 +681,12 @@ void UAudioStreamHttpWsSubsystem::ClientInsertFrame(uint16 StreamId, uint32 Seq,
     }
     if (!CS0) return; // 防御性检查（理论上 FindOrAdd 总是返回有效引用）
 
-    FPendingAudioFrame F; F.Seq = Seq; F.PtsUs = PtsUs; F.Payload.SetNum(PayloadLen); FMemory::Memcpy(F.Payload.GetData(), Payload, PayloadLen);
-
     {
         FScopeLock JL(&JitterCS);
         FClientStreamState& CS = *CS0;
-        int32 InsertIdx = 0;
-        while (InsertIdx < CS.Frames.Num() && (int64)(CS.Frames[InsertIdx].PtsUs - PtsUs) <= 0) { ++InsertIdx; }
-        CS.Frames.Insert(MoveTemp(F), InsertIdx);
-
-        if (!CS.bPreRollReady && CS.Frames.Num() >= 2)
+        if (CS.Jitter.Insert(Seq, PtsUs, Payload, PayloadLen, TargetPreRollMs))
         {
-            const uint64 OldestPts = CS.Frames[0].PtsUs;
-            const uint64 NewestPts = CS.Frames.Last().PtsUs;
-            const int64 DepthUs = (int64)(NewestPts - OldestPts);
-            if (DepthUs >= (int64)TargetPreRollMs * 1000)
-            {
-                CS.bPreRollReady = true;
-                UE_LOG(LogTemp, Log, TEXT("[MediaSync] PreRoll ready: stream=%u depthUs=%lld"), (unsigned)StreamId, (long long)DepthUs);
-            }
+            UE_LOG(LogTemp, Log, TEXT("[MediaSync] PreRoll ready: stream=%u depthUs=%lld"), (unsigned)StreamId, (long long)CS.Jitter.GetDepthUs());
         }
     }
 }
@@ -985,24 +978,14 @@ void UAudioStreamHttpWsSubsystem::ClientDrainFrames(double NowSec)
         if (!CS0) continue;
 
         // 拷贝必要状态以减小持锁时间
-        int32 SR = CS0->SampleRate; int32 CH = CS0->Channels; bool bReady = CS0->bPreRollReady;
+        int32 SR = CS0->SampleRate; int32 CH = CS0->Channels; bool bReady = CS0->Jitter.bPreRollReady;
         if (!bReady) continue; // 还未预热
 
         // 出队符合时间的帧
-        TArray<FPendingAudioFrame> ToPlay;
+        TArray<FMediaPendingAudioFrame> ToPlay;
         {
             FScopeLock JL(&JitterCS);
-            FClientStreamState& CS = *CS0;
-            while (CS.Frames.Num() > 0)
-            {
-                const uint64 PtsUs = CS.Frames[0].PtsUs;
-                if ((double)PtsUs <= ServerNowUs)
-                {
-                    ToPlay.Add(MoveTemp(CS.Frames[0]));
-                    CS.Frames.RemoveAt(0);
-                }
-                else break;
-            }
+            CS0->Jitter.DrainDue(ServerNowUs, ToPlay);
         }
 
         if (ToPlay.Num() > 0)
@@ -1012,7 +995,7 @@ void UAudioStreamHttpWsSubsystem::ClientDrainFrames(double NowSec)
             if (Found && Found->IsValid())
             {
                 UAudioStreamHttpWsComponent* Target = Found->Get();
-                for (FPendingAudioFrame& F : ToPlay)
+                for (FMediaPendingAudioFrame& F : ToPlay)
                 {
                     TArray<uint8> Bytes = MoveTemp(F.Payload);
                     AsyncTask(ENamedThreads::GameThread, [Target, Bytes=MoveTemp(Bytes), SR, CH]() mutable
@@ -1786,6 +1769,21 @@ void UAudioStreamHttpWsSubsystem::PushTestAudioChunk(const FString& TargetKey, i
     }
 }
 
+void UAudioStreamHttpWsSubsystem::StartPacketCapture(int32 MaxPackets)
+{
+    PacketCapture.Start(MaxPackets);
+    UE_LOG(LogTemp, Log, TEXT("[AudioStream] Packet capture started (max=%d, udp=%d)"), MaxPackets, MediaUdpPort);
+}
+
+bool UAudioStreamHttpWsSubsystem::StopPacketCapture(const FString& FilePath)
+{
+    const FString Path = FilePath.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("MediaCapture.mspc") : FilePath;
+    int32 NumPackets = 0;
+    const bool bOk = PacketCapture.StopAndSave(Path, NumPackets);
+    UE_LOG(LogTemp, Log, TEXT("[AudioStream] Packet capture stopped: %d packets -> %s (%s)"), NumPackets, *Path, bOk ? TEXT("ok") : TEXT("write failed"));
+    return bOk;
+}
+
 void UAudioStreamHttpWsSubsystem::PushTestText(const FString& TargetKey, const FString& Text)
 {
     TWeakObjectPtr<UAudioStreamHttpWsComponent>* Found = ComponentMap.Find(TargetKey);
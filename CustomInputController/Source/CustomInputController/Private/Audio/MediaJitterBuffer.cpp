@@ -0,0 +1,37 @@
+﻿#include "Audio/MediaJitterBuffer.h"
+
+bool FMediaJitterBuffer::Insert(uint32 Seq, uint64 PtsUs, const uint8* Payload, int32 PayloadLen, int32 PreRollMs)
+{
+    if (PayloadLen <= 0 || !Payload) return false;
+
+    FMediaPendingAudioFrame F; F.Seq = Seq; F.PtsUs = PtsUs; F.Payload.SetNumUninitialized(PayloadLen); FMemory::Memcpy(F.Payload.GetData(), Payload, PayloadLen);
+
+    // 从尾部向前找插入位置：正常到达的帧总是追加在末尾
+    int32 InsertIdx = Frames.Num();
+    while (InsertIdx > 0 && (int64)(Frames[InsertIdx - 1].PtsUs - PtsUs) > 0) { --InsertIdx; }
+    Frames.Insert(MoveTemp(F), InsertIdx);
+
+    if (!bPreRollReady && Frames.Num() >= 2 && GetDepthUs() >= (int64)PreRollMs * 1000)
+    {
+        bPreRollReady = true;
+        return true;
+    }
+    return false;
+}
+
+int32 FMediaJitterBuffer::DrainDue(double ServerNowUs, TArray<FMediaPendingAudioFrame>& OutFrames)
+{
+    if (!bPreRollReady) return 0;
+
+    int32 Count = 0;
+    while (Count < Frames.Num() && (double)Frames[Count].PtsUs <= ServerNowUs)
+    {
+        OutFrames.Add(MoveTemp(Frames[Count]));
+        ++Count;
+    }
+    if (Count > 0)
+    {
+        Frames.RemoveAt(0, Count, EAllowShrinking::No);
+    }
+    return Count;
+}
@@ -0,0 +1,638 @@
+﻿#include "Audio/MediaStreamReplay.h"
+#include "Audio/MediaStreamPacket.h"
+#include "Audio/MediaJitterBuffer.h"
+#include "Audio/StreamProcSoundWave.h"
+#include "Audio/AudioStreamSettings.h"
+
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Math/RandomStream.h"
+#include "HAL/IConsoleManager.h"
+#include "Common/UdpSocketBuilder.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "IPAddress.h"
+#include "UObject/Package.h"
+
+// 抓包文件：'MSPC' + 版本 + 包数，随后每包 [uint64 时间][int32 长度][字节]
+static constexpr uint32 GMediaTraceMagic = 0x4350534D;
+static constexpr uint32 GMediaTraceVersion = 1;
+
+// ======= 抓包文件 =======
+
+bool FMediaReplayTrace::SaveToFile(const FString& FilePath) const
+{
+    TArray<uint8> Blob;
+    FMemoryWriter Ar(Blob);
+    uint32 Magic = GMediaTraceMagic;
+    uint32 Version = GMediaTraceVersion;
+    int32 Num = Packets.Num();
+    Ar << Magic << Version << Num;
+    for (const FMediaReplayPacket& P : Packets)
+    {
+        uint64 TimeUs = P.SendTimeUs;
+        int32 Len = P.Bytes.Num();
+        Ar << TimeUs << Len;
+        Ar.Serialize(const_cast<uint8*>(P.Bytes.GetData()), Len);
+    }
+    return FFileHelper::SaveArrayToFile(Blob, *FilePath);
+}
+
+bool FMediaReplayTrace::LoadFromFile(const FString& FilePath)
+{
+    Packets.Reset();
+    TArray<uint8> Blob;
+    if (!FFileHelper::LoadFileToArray(Blob, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Cannot read trace %s"), *FilePath);
+        return false;
+    }
+
+    FMemoryReader Ar(Blob);
+    uint32 Magic = 0, Version = 0; int32 Num = 0;
+    Ar << Magic << Version << Num;
+    if (Magic != GMediaTraceMagic || Version != GMediaTraceVersion || Num < 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Bad trace header in %s (magic=%08x ver=%u)"), *FilePath, Magic, Version);
+        return false;
+    }
+
+    Packets.Reserve(Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        FMediaReplayPacket P;
+        int32 Len = 0;
+        Ar << P.SendTimeUs << Len;
+        if (Ar.IsError() || Len < 0 || Len > Ar.TotalSize() - Ar.Tell())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Truncated trace %s at packet %d"), *FilePath, i);
+            return false;
+        }
+        P.Bytes.SetNumUninitialized(Len);
+        Ar.Serialize(P.Bytes.GetData(), Len);
+        Packets.Add(MoveTemp(P));
+    }
+    return true;
+}
+
+static void AppendPacket(TArray<FMediaReplayPacket>& Out, uint64 SendUs, const FMediaPacketHeader& H, const uint8* Payload, int32 Len)
+{
+    FMediaReplayPacket& P = Out.AddDefaulted_GetRef();
+    P.SendTimeUs = SendUs;
+    P.Bytes.SetNumUninitialized(sizeof(H) + Len);
+    FMemory::Memcpy(P.Bytes.GetData(), &H, sizeof(H));
+    if (Len > 0)
+    {
+        FMemory::Memcpy(P.Bytes.GetData() + sizeof(H), Payload, Len);
+    }
+}
+
+FMediaReplayTrace FMediaReplayTrace::MakeSynthetic(const FMediaReplaySyntheticParams& Params)
+{
+    FMediaReplayTrace Trace;
+    const int32 SR = FMath::Clamp(Params.SampleRate, 8000, 48000);
+    const int32 CH = FMath::Clamp(Params.Channels, 1, 8);
+    const int32 FrameMs = FMath::Max(1, Params.FrameDurationMs);
+    const int32 SamplesPerFrame = FMath::Max(1, SR * FrameMs / 1000);
+    const int32 FrameBytes = SamplesPerFrame * CH * 2;
+    const int32 NumFrames = FMath::Max(1, FMath::CeilToInt(Params.DurationSeconds * 1000.f / (float)FrameMs));
+    const uint64 BaseUs = 1000000ULL; // 避免 0 时间戳
+    uint32 Seq = 0;
+
+    TArray<uint8> Pcm; Pcm.SetNumUninitialized(FrameBytes);
+    for (int32 s = 0; s < FMath::Max(1, Params.NumStreams); ++s)
+    {
+        const uint16 StreamId = (uint16)(s + 1);
+        // 各流错开半帧，避免所有包同一时刻到达
+        const uint64 StartUs = BaseUs + (uint64)s * (uint64)FrameMs * 500ULL;
+
+        TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+        Obj->SetStringField(TEXT("op"), TEXT("format"));
+        Obj->SetStringField(TEXT("key"), FString::Printf(TEXT("replay_%d"), StreamId));
+        Obj->SetNumberField(TEXT("stream_id"), (double)StreamId);
+        Obj->SetNumberField(TEXT("sr"), (double)SR);
+        Obj->SetNumberField(TEXT("ch"), (double)CH);
+        Obj->SetNumberField(TEXT("lead_ms"), (double)Params.LeadMs);
+        Obj->SetNumberField(TEXT("frame_ms"), (double)FrameMs);
+        Obj->SetNumberField(TEXT("server_time_us"), (double)StartUs);
+        FString Json; TSharedRef<TJsonWriter<>> W = TJsonWriterFactory<>::Create(&Json); FJsonSerializer::Serialize(Obj, W);
+        FTCHARToUTF8 Conv(*Json);
+        FMediaPacketHeader CtrlH; MSP_FillHeader(CtrlH, EMediaPacketType::Control, StreamId, 0, StartUs, EMediaPacketFlags::Keyframe, (uint32)Conv.Length());
+        AppendPacket(Trace.Packets, StartUs, CtrlH, reinterpret_cast<const uint8*>(Conv.Get()), Conv.Length());
+
+        const float Freq = Params.FrequencyHz * (1.f + 0.25f * (float)s); // 每流不同音高，便于人工回听
+        for (int32 f = 0; f < NumFrames; ++f)
+        {
+            int16* Out = reinterpret_cast<int16*>(Pcm.GetData());
+            for (int32 i = 0; i < SamplesPerFrame; ++i)
+            {
+                const double t = (double)(f * SamplesPerFrame + i) / (double)SR;
+                const int16 V = (int16)(FMath::Sin(2.0 * PI * Freq * t) * 0.3 * 32767.0);
+                for (int32 c = 0; c < CH; ++c) { Out[i * CH + c] = V; }
+            }
+            const uint64 SendUs = StartUs + (uint64)(f + 1) * (uint64)FrameMs * 1000ULL;
+            const uint64 PtsUs = StartUs + (uint64)Params.LeadMs * 1000ULL + (uint64)f * (uint64)FrameMs * 1000ULL;
+            FMediaPacketHeader H; MSP_FillHeader(H, EMediaPacketType::Audio, StreamId, ++Seq, PtsUs, f == 0 ? EMediaPacketFlags::Keyframe : 0, (uint32)FrameBytes);
+            AppendPacket(Trace.Packets, SendUs, H, Pcm.GetData(), FrameBytes);
+        }
+    }
+
+    Trace.Packets.StableSort([](const FMediaReplayPacket& A, const FMediaReplayPacket& B) { return A.SendTimeUs < B.SendTimeUs; });
+    return Trace;
+}
+
+// ======= 抓包 =======
+
+void FMediaPacketCapture::Start(int32 InMaxPackets)
+{
+    FScopeLock L(&CS);
+    Trace.Packets.Reset();
+    MaxPackets = FMath::Max(1, InMaxPackets);
+    bActive.store(true, std::memory_order_relaxed);
+}
+
+void FMediaPacketCapture::Append(uint64 TimeUs, const TArray<uint8>& Data)
+{
+    FScopeLock L(&CS);
+    if (!bActive.load(std::memory_order_relaxed)) return;
+    if (Trace.Packets.Num() >= MaxPackets)
+    {
+        bActive.store(false, std::memory_order_relaxed);
+        UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Capture reached %d packets, further packets ignored"), MaxPackets);
+        return;
+    }
+    FMediaReplayPacket& P = Trace.Packets.AddDefaulted_GetRef();
+    P.SendTimeUs = TimeUs;
+    P.Bytes = Data;
+}
+
+bool FMediaPacketCapture::StopAndSave(const FString& FilePath, int32& OutNumPackets)
+{
+    FScopeLock L(&CS);
+    bActive.store(false, std::memory_order_relaxed);
+    OutNumPackets = Trace.Packets.Num();
+    const bool bOk = Trace.SaveToFile(FilePath);
+    Trace.Packets.Empty();
+    return bOk;
+}
+
+// ======= 回放 =======
+
+namespace MediaReplay
+{
+    struct FScheduledPacket
+    {
+        uint64 ArrivalUs = 0;
+        int32 PacketIndex = 0;
+    };
+
+    /** 已入队字节的播放标记：PlayedBytes 越过 EndByte 时该帧播放完毕 */
+    struct FPlayMark
+    {
+        int64 EndByte = 0;
+        uint64 SendRelUs = 0;
+    };
+
+    struct FStreamState
+    {
+        FMediaReplayStreamReport Report;
+        FMediaJitterBuffer Jitter;
+        UStreamProcSoundWave* Wave = nullptr;
+        bool bPlaying = false;
+        uint64 NextRenderUs = 0;
+        int64 EnqueuedBytes = 0;
+        int32 RemainingPackets = 0;
+        TArray<FPlayMark> Marks;
+        int32 MarkHead = 0;
+        TMap<uint32, uint64> SendRelBySeq;
+        TArray<float> LatenciesMs;
+        TArray<FMediaPendingAudioFrame> Due;
+        TArray<uint8> RenderScratch;
+    };
+
+    static double CyclesToUs(uint64 Cycles)
+    {
+        return FPlatformTime::ToSeconds64(Cycles) * 1000000.0;
+    }
+}
+
+FMediaReplayReport FMediaStreamReplayHarness::Run(const FMediaReplayTrace& Trace)
+{
+    using namespace MediaReplay;
+    check(IsInGameThread());
+
+    FMediaReplayReport Report;
+    if (Trace.Packets.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Empty trace"));
+        return Report;
+    }
+
+    const double WallStart = FPlatformTime::Seconds();
+    const FMediaReplayImpairments& Imp = Config.Impairments;
+    FRandomStream Rng(Imp.Seed);
+    const double DriftScale = 1.0 + (double)Imp.ClockDriftPpm * 1e-6;
+
+    uint64 T0 = Trace.Packets[0].SendTimeUs;
+    for (const FMediaReplayPacket& P : Trace.Packets) { T0 = FMath::Min(T0, P.SendTimeUs); }
+
+    TMap<uint16, FStreamState> Streams;
+
+    // 1) 生成到达时间表（损伤注入）
+    TArray<FScheduledPacket> Schedule;
+    Schedule.Reserve(Trace.Packets.Num());
+    for (int32 i = 0; i < Trace.Packets.Num(); ++i)
+    {
+        const FMediaReplayPacket& P = Trace.Packets[i];
+        FMediaPacketHeader H;
+        if (!MSP_ParseHeader(P.Bytes, H))
+        {
+            ++Report.InvalidPackets;
+            continue;
+        }
+        const bool bAudio = (EMediaPacketType)H.MediaType == EMediaPacketType::Audio;
+        const uint64 SendRelUs = P.SendTimeUs - T0;
+        FStreamState& S = Streams.FindOrAdd(H.StreamId);
+        S.Report.StreamId = H.StreamId;
+
+        if (bAudio)
+        {
+            ++S.Report.PacketsSent;
+            // 抽样顺序固定（丢包->抖动->乱序），保证同 Seed 可复现
+            if (Rng.FRand() < Imp.LossRate)
+            {
+                ++S.Report.PacketsLost;
+                continue;
+            }
+            S.SendRelBySeq.Add(H.Seq, SendRelUs);
+            ++S.RemainingPackets;
+        }
+
+        double ArrivalUs = (double)SendRelUs * DriftScale + (double)Imp.BaseDelayMs * 1000.0;
+        if (Imp.JitterMs > 0.f)
+        {
+            ArrivalUs += (double)Rng.FRandRange(0.f, Imp.JitterMs) * 1000.0;
+        }
+        if (bAudio && Imp.ReorderRate > 0.f && Rng.FRand() < Imp.ReorderRate)
+        {
+            ArrivalUs += (double)Imp.ReorderDelayMs * 1000.0;
+            ++S.Report.PacketsReordered;
+        }
+
+        FScheduledPacket& E = Schedule.AddDefaulted_GetRef();
+        E.ArrivalUs = (uint64)FMath::Max(0.0, ArrivalUs);
+        E.PacketIndex = i;
+    }
+    Schedule.StableSort([](const FScheduledPacket& A, const FScheduledPacket& B) { return A.ArrivalUs < B.ArrivalUs; });
+
+    // 2) 可选：本机回环 UDP
+    FSocket* RecvSock = nullptr;
+    FSocket* SendSock = nullptr;
+    TSharedPtr<FInternetAddr> LoopAddr;
+    ISocketSubsystem* SSS = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (Config.bUseLoopbackUdp && SSS)
+    {
+        RecvSock = FUdpSocketBuilder(TEXT("MediaReplayRecv"))
+            .AsNonBlocking()
+            .BoundToAddress(FIPv4Address(127, 0, 0, 1))
+            .BoundToPort(0)
+            .WithReceiveBufferSize(8 * 1024 * 1024)
+            .Build();
+        SendSock = FUdpSocketBuilder(TEXT("MediaReplaySend"))
+            .AsNonBlocking()
+            .WithSendBufferSize(8 * 1024 * 1024)
+            .Build();
+        if (RecvSock && SendSock)
+        {
+            LoopAddr = SSS->CreateInternetAddr();
+            LoopAddr->SetIp(FIPv4Address(127, 0, 0, 1).Value);
+            LoopAddr->SetPort(RecvSock->GetPortNo());
+            UE_LOG(LogTemp, Log, TEXT("[MediaReplay] Loopback UDP on 127.0.0.1:%d"), RecvSock->GetPortNo());
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[MediaReplay] Loopback sockets unavailable, falling back to in-process delivery"));
+            if (RecvSock) { SSS->DestroySocket(RecvSock); RecvSock = nullptr; }
+            if (SendSock) { SSS->DestroySocket(SendSock); SendSock = nullptr; }
+        }
+    }
+
+    const UAudioStreamSettings* Settings = GetDefault<UAudioStreamSettings>();
+    double OffsetUs = 0.0;
+    bool bHasOffset = false;
+    int32 LoopbackSent = 0, LoopbackReceived = 0;
+
+    auto EnsureWave = [Settings](FStreamState& S, int32 SR, int32 CH)
+    {
+        S.Report.SampleRate = SR;
+        S.Report.Channels = CH;
+        if (!S.Wave)
+        {
+            S.Wave = NewObject<UStreamProcSoundWave>(GetTransientPackage());
+            S.Wave->AddToRoot();
+            if (Settings)
+            {
+                S.Wave->bEnableUnderRunFade = Settings->bEnableUnderRunFadeDefault;
+                S.Wave->FadeMs = Settings->FadeMsDefault;
+                S.Wave->SetCompactThreshold(Settings->ProcCompactThresholdBytes);
+            }
+        }
+        S.Wave->SetParams(SR, CH);
+    };
+
+    // 与 UAudioStreamHttpWsSubsystem::HandleUdpBinary 相同的接收处理
+    auto Deliver = [&](const TArray<uint8>& Bytes, uint64 NowUs)
+    {
+        FMediaPacketHeader H;
+        if (!MSP_ParseHeader(Bytes, H))
+        {
+            ++Report.InvalidPackets;
+            return;
+        }
+        FStreamState* SPtr = Streams.Find(H.StreamId);
+        if (!SPtr) return;
+        FStreamState& S = *SPtr;
+        const uint8* Payload = Bytes.GetData() + sizeof(FMediaPacketHeader);
+        const uint64 C0 = FPlatformTime::Cycles64();
+
+        if ((EMediaPacketType)H.MediaType == EMediaPacketType::Control)
+        {
+            const FString JsonStr = H.PayloadLen > 0 ? FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Payload), (int32)H.PayloadLen)) : FString();
+            TSharedPtr<FJsonObject> Obj; TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(JsonStr);
+            FString Op;
+            if (FJsonSerializer::Deserialize(R, Obj) && Obj.IsValid() && Obj->TryGetStringField(TEXT("op"), Op) && Op == TEXT("format"))
+            {
+                EnsureWave(S, (int32)Obj->GetNumberField(TEXT("sr")), FMath::Clamp((int32)Obj->GetNumberField(TEXT("ch")), 1, 8));
+                S.Jitter.Reset();
+                const double Off = Obj->GetNumberField(TEXT("server_time_us")) - (double)NowUs;
+                if (!bHasOffset) { OffsetUs = Off; bHasOffset = true; }
+                else { OffsetUs = FMath::Lerp(OffsetUs, Off, (double)Config.OffsetLerpAlpha); }
+            }
+        }
+        else if ((EMediaPacketType)H.MediaType == EMediaPacketType::Audio)
+        {
+            if (!S.Wave) { EnsureWave(S, Config.DefaultSampleRate, Config.DefaultChannels); }
+            ++S.Report.PacketsReceived;
+            --S.RemainingPackets;
+            if (bHasOffset && S.Jitter.bPreRollReady && (double)H.PtsUs < (double)NowUs + OffsetUs)
+            {
+                ++S.Report.LateFrames;
+            }
+            S.Jitter.Insert(H.Seq, H.PtsUs, Payload, (int32)H.PayloadLen, Config.PreRollMs);
+        }
+        S.Report.CpuUs += CyclesToUs(FPlatformTime::Cycles64() - C0);
+    };
+
+    auto PollLoopback = [&](uint64 NowUs)
+    {
+        if (!RecvSock) return;
+        uint32 Pending = 0;
+        TArray<uint8> Buf;
+        while (RecvSock->HasPendingData(Pending) && Pending > 0)
+        {
+            Buf.SetNumUninitialized((int32)Pending);
+            int32 Read = 0;
+            TSharedRef<FInternetAddr> From = SSS->CreateInternetAddr();
+            if (!RecvSock->RecvFrom(Buf.GetData(), Buf.Num(), Read, *From) || Read <= 0) break;
+            Buf.SetNum(Read, EAllowShrinking::No);
+            ++LoopbackReceived;
+            Deliver(Buf, NowUs);
+        }
+    };
+
+    // 3) 1ms 量子的确定性仿真
+    const uint64 QuantumUs = 1000;
+    const uint64 TickUs = (uint64)FMath::Max(1, Config.TickMs) * 1000ULL;
+    const uint64 EndUs = Schedule.Num() > 0
+        ? Schedule.Last().ArrivalUs + (uint64)FMath::Max(0, Config.PreRollMs + Config.TailMs) * 1000ULL
+        : 0;
+    int32 NextEvent = 0;
+
+    for (uint64 NowUs = 0; NowUs <= EndUs; NowUs += QuantumUs)
+    {
+        // 到达
+        while (NextEvent < Schedule.Num() && Schedule[NextEvent].ArrivalUs <= NowUs)
+        {
+            const TArray<uint8>& Bytes = Trace.Packets[Schedule[NextEvent].PacketIndex].Bytes;
+            if (SendSock)
+            {
+                int32 Sent = 0;
+                SendSock->SendTo(Bytes.GetData(), Bytes.Num(), Sent, *LoopAddr);
+                ++LoopbackSent;
+            }
+            else
+            {
+                Deliver(Bytes, NowUs);
+            }
+            ++NextEvent;
+        }
+        PollLoopback(NowUs);
+
+        // 出队（同 TickSync -> ClientDrainFrames）
+        if (NowUs % TickUs == 0)
+        {
+            const double ServerNowUs = (double)NowUs + (bHasOffset ? OffsetUs : 0.0);
+            for (TPair<uint16, FStreamState>& Pair : Streams)
+            {
+                FStreamState& S = Pair.Value;
+                if (!S.Wave) continue;
+                const uint64 C0 = FPlatformTime::Cycles64();
+                S.Due.Reset();
+                S.Jitter.DrainDue(ServerNowUs, S.Due);
+                const int32 FrameBytes = 2 * FMath::Max(1, S.Report.Channels);
+                for (FMediaPendingAudioFrame& F : S.Due)
+                {
+                    const int32 Aligned = F.Payload.Num() - (F.Payload.Num() % FrameBytes);
+                    if (Aligned <= 0) continue;
+                    S.Wave->EnqueuePcm(F.Payload.GetData(), Aligned);
+                    S.EnqueuedBytes += Aligned;
+                    FPlayMark& M = S.Marks.AddDefaulted_GetRef();
+                    M.EndByte = S.EnqueuedBytes;
+                    M.SendRelUs = S.SendRelBySeq.FindRef(F.Seq);
+                    ++S.Report.FramesPlayed;
+                }
+                if (!S.bPlaying && S.EnqueuedBytes > 0)
+                {
+                    // 与组件一致：首批数据到达后开始播放
+                    S.bPlaying = true;
+                    S.NextRenderUs = NowUs;
+                }
+                S.Report.CpuUs += CyclesToUs(FPlatformTime::Cycles64() - C0);
+            }
+        }
+
+        // 渲染回调（模拟音频设备按块拉取）
+        for (TPair<uint16, FStreamState>& Pair : Streams)
+        {
+            FStreamState& S = Pair.Value;
+            if (!S.bPlaying || NowUs < S.NextRenderUs) continue;
+
+            const int32 SR = FMath::Max(1, S.Report.SampleRate);
+            const int32 CH = FMath::Max(1, S.Report.Channels);
+            const bool bStreamLive = S.RemainingPackets > 0 || S.Jitter.Frames.Num() > 0 || S.EnqueuedBytes > S.Wave->GetPlayedBytes();
+            const int32 UnderrunsBefore = S.Wave->GetUnderrunCount();
+
+            const uint64 C0 = FPlatformTime::Cycles64();
+            S.RenderScratch.Reset();
+            S.Wave->OnGeneratePCMAudio(S.RenderScratch, Config.RenderBlockFrames * CH);
+            S.Report.CpuUs += CyclesToUs(FPlatformTime::Cycles64() - C0);
+
+            if (bStreamLive && S.Wave->GetUnderrunCount() != UnderrunsBefore)
+            {
+                ++S.Report.Underruns;
+            }
+
+            const int64 Played = S.Wave->GetPlayedBytes();
+            while (S.MarkHead < S.Marks.Num() && S.Marks[S.MarkHead].EndByte <= Played)
+            {
+                S.LatenciesMs.Add((float)((double)(NowUs - FMath::Min(NowUs, S.Marks[S.MarkHead].SendRelUs)) / 1000.0));
+                ++S.MarkHead;
+            }
+            S.NextRenderUs += (uint64)Config.RenderBlockFrames * 1000000ULL / (uint64)SR;
+        }
+    }
+
+    // 4) 汇总
+    for (TPair<uint16, FStreamState>& Pair : Streams)
+    {
+        FStreamState& S = Pair.Value;
+        if (S.Wave)
+        {
+            S.Report.PlayedBytes = S.Wave->GetPlayedBytes();
+            S.Wave->RemoveFromRoot();
+            S.Wave = nullptr;
+        }
+        if (S.LatenciesMs.Num() > 0)
+        {
+            S.LatenciesMs.Sort();
+            double Sum = 0.0;
+            for (float L : S.LatenciesMs) { Sum += L; }
+            const int32 N = S.LatenciesMs.Num();
+            S.Report.LatencyAvgMs = (float)(Sum / (double)N);
+            S.Report.LatencyP50Ms = S.LatenciesMs[N / 2];
+            S.Report.LatencyP95Ms = S.LatenciesMs[FMath::Min(N - 1, (N * 95) / 100)];
+            S.Report.LatencyMaxMs = S.LatenciesMs.Last();
+        }
+        if (S.Report.PacketsSent > 0)
+        {
+            Report.Streams.Add(S.Report);
+        }
+    }
+    Report.Streams.Sort([](const FMediaReplayStreamReport& A, const FMediaReplayStreamReport& B) { return A.StreamId < B.StreamId; });
+
+    if (RecvSock || SendSock)
+    {
+        PollLoopback(EndUs);
+        Report.LoopbackDropped = FMath::Max(0, LoopbackSent - LoopbackReceived);
+        if (RecvSock) { RecvSock->Close(); SSS->DestroySocket(RecvSock); }
+        if (SendSock) { SendSock->Close(); SSS->DestroySocket(SendSock); }
+    }
+
+    Report.SimulatedSeconds = (double)EndUs / 1000000.0;
+    Report.WallSeconds = FPlatformTime::Seconds() - WallStart;
+    return Report;
+}
+
+void FMediaReplayReport::LogSummary() const
+{
+    UE_LOG(LogTemp, Log, TEXT("[MediaReplay] sim=%.2fs wall=%.2fs streams=%d invalid=%d loopbackDropped=%d"),
+        SimulatedSeconds, WallSeconds, Streams.Num(), InvalidPackets, LoopbackDropped);
+    for (const FMediaReplayStreamReport& S : Streams)
+    {
+        const double CpuPerSec = SimulatedSeconds > 0.0 ? S.CpuUs / SimulatedSeconds : 0.0;
+        UE_LOG(LogTemp, Log, TEXT("[MediaReplay] stream=%u sr=%d ch=%d sent=%d lost=%d reordered=%d recv=%d late=%d played=%d underruns=%d latency(avg/p50/p95/max)=%.1f/%.1f/%.1f/%.1fms cpu=%.0fus (%.1fus/s)"),
+            (unsigned)S.StreamId, S.SampleRate, S.Channels, S.PacketsSent, S.PacketsLost, S.PacketsReordered, S.PacketsReceived,
+            S.LateFrames, S.FramesPlayed, S.Underruns, S.LatencyAvgMs, S.LatencyP50Ms, S.LatencyP95Ms, S.LatencyMaxMs, S.CpuUs, CpuPerSec);
+    }
+}
+
+bool FMediaReplayReport::SaveCsv(const FString& FilePath) const
+{
+    FString Csv = TEXT("stream,sr,ch,sent,lost,reordered,received,late,played,underruns,latency_avg_ms,latency_p50_ms,latency_p95_ms,latency_max_ms,cpu_us,sim_s\n");
+    for (const FMediaReplayStreamReport& S : Streams)
+    {
+        Csv += FString::Printf(TEXT("%u,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.1f,%.3f\n"),
+            (unsigned)S.StreamId, S.SampleRate, S.Channels, S.PacketsSent, S.PacketsLost, S.PacketsReordered, S.PacketsReceived,
+            S.LateFrames, S.FramesPlayed, S.Underruns, S.LatencyAvgMs, S.LatencyP50Ms, S.LatencyP95Ms, S.LatencyMaxMs, S.CpuUs, SimulatedSeconds);
+    }
+    return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+// ======= 控制台入口 =======
+// 例：UnrealEditor-Cmd <Project> -nullrhi -nosound -unattended -ExecCmds="AudioStream.Replay Streams=4 Seconds=30 Loss=0.02 JitterMs=40 DriftPpm=200 Csv=/tmp/replay.csv,Quit"
+// 参数：File=<抓包文件> | Streams= Seconds= SampleRate= Channels= FrameMs= SaveTrace=<路径>
+//       Loss= Reorder= ReorderMs= DelayMs= JitterMs= DriftPpm= Seed= PreRollMs= BlockFrames= Loopback=0/1 Csv=<路径>
+static void RunMediaReplayCommand(const TArray<FString>& Args)
+{
+    const FString Cmd = FString::Join(Args, TEXT(" "));
+    const UAudioStreamSettings* S = GetDefault<UAudioStreamSettings>();
+
+    FMediaReplayConfig Config;
+    if (S)
+    {
+        Config.PreRollMs = S->TargetPreRollMs;
+        Config.OffsetLerpAlpha = S->OffsetLerpAlpha;
+        Config.DefaultSampleRate = S->DefaultSampleRate;
+        Config.DefaultChannels = S->DefaultChannels;
+    }
+    FParse::Value(*Cmd, TEXT("Loss="), Config.Impairments.LossRate);
+    FParse::Value(*Cmd, TEXT("Reorder="), Config.Impairments.ReorderRate);
+    FParse::Value(*Cmd, TEXT("ReorderMs="), Config.Impairments.ReorderDelayMs);
+    FParse::Value(*Cmd, TEXT("DelayMs="), Config.Impairments.BaseDelayMs);
+    FParse::Value(*Cmd, TEXT("JitterMs="), Config.Impairments.JitterMs);
+    FParse::Value(*Cmd, TEXT("DriftPpm="), Config.Impairments.ClockDriftPpm);
+    FParse::Value(*Cmd, TEXT("Seed="), Config.Impairments.Seed);
+    FParse::Value(*Cmd, TEXT("PreRollMs="), Config.PreRollMs);
+    FParse::Value(*Cmd, TEXT("BlockFrames="), Config.RenderBlockFrames);
+    FParse::Bool(*Cmd, TEXT("Loopback="), Config.bUseLoopbackUdp);
+    Config.RenderBlockFrames = FMath::Clamp(Config.RenderBlockFrames, 64, 8192);
+
+    FMediaReplayTrace Trace;
+    FString TracePath;
+    if (FParse::Value(*Cmd, TEXT("File="), TracePath))
+    {
+        if (!Trace.LoadFromFile(TracePath)) return;
+    }
+    else
+    {
+        FMediaReplaySyntheticParams P;
+        P.LeadMs = S ? S->TargetPreRollMs : P.LeadMs;
+        P.FrameDurationMs = S ? S->FrameDurationMs : P.FrameDurationMs;
+        FParse::Value(*Cmd, TEXT("Streams="), P.NumStreams);
+        FParse::Value(*Cmd, TEXT("Seconds="), P.DurationSeconds);
+        FParse::Value(*Cmd, TEXT("SampleRate="), P.SampleRate);
+        FParse::Value(*Cmd, TEXT("Channels="), P.Channels);
+        FParse::Value(*Cmd, TEXT("FrameMs="), P.FrameDurationMs);
+        Trace = FMediaReplayTrace::MakeSynthetic(P);
+
+        FString SavePath;
+        if (FParse::Value(*Cmd, TEXT("SaveTrace="), SavePath))
+        {
+            Trace.SaveToFile(SavePath);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[MediaReplay] packets=%d loss=%.3f reorder=%.3f jitter=%.1fms drift=%.0fppm seed=%d preroll=%dms loopback=%d"),
+        Trace.Packets.Num(), Config.Impairments.LossRate, Config.Impairments.ReorderRate, Config.Impairments.JitterMs,
+        Config.Impairments.ClockDriftPpm, Config.Impairments.Seed, Config.PreRollMs, Config.bUseLoopbackUdp ? 1 : 0);
+
+    FMediaStreamReplayHarness Harness(Config);
+    const FMediaReplayReport Report = Harness.Run(Trace);
+    Report.LogSummary();
+
+    FString CsvPath;
+    if (FParse::Value(*Cmd, TEXT("Csv="), CsvPath))
+    {
+        Report.SaveCsv(CsvPath);
+    }
+}
+
+static FAutoConsoleCommand GMediaReplayCommand(
+    TEXT("AudioStream.Replay"),
+    TEXT("Replay a recorded (File=) or synthetic media packet trace through the jitter buffer/procedural wave path with injected loss/reorder/jitter/drift."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RunMediaReplayCommand));
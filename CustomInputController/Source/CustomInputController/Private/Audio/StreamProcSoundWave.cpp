@@ -62,6 +62,7 @@ int32 UStreamProcSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 Nu
     if (Remainder > 0)
     {
         OutAudio.AddZeroed(Remainder);
+        UnderrunCount.fetch_add(1, std::memory_order_relaxed);
     }
 
     // 上一帧欠载 → 本帧有非零产出且启用开关 → 在本帧的最前端做淡入
@@ -92,6 +93,7 @@ int32 UStreamProcSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 Nu
     if (RequestedBytes > 0)
     {
         ConsumedBytes.fetch_add((int64)RequestedBytes, std::memory_order_relaxed);
+        PlayedBytes.fetch_add((int64)CopiedBytes, std::memory_order_relaxed);
     }
 
     // 适度压缩：读偏移跨过阈值且剩余数据量不大时，将未读数据移到开头
@@ -3,11 +3,12 @@
 #include "HandTracking/HandDataListenerComponent.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
-#include "Async/Async.h"
 
 UHandDataListenerComponent::UHandDataListenerComponent()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // 每 Tick 从 InputPlusSubsystem 取一次最新帧（积压帧不排队处理）
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
     InputPlusSubsystem = nullptr;
 }
 
@@ -23,16 +24,15 @@ void UHandDataListenerComponent::EndPlay(const EEndPlayReason::Type EndPlayReaso
     UnbindFromInputPlusSubsystem();
 
     // 清理平滑与过滤缓存
-    PrevLeftPoints.Empty();
-    PrevRightPoints.Empty();
-    PrevLeftPalmSize = 0.f;
-    PrevRightPalmSize = 0.f;
-    LeftAcceptedFrames = 0;
-    RightAcceptedFrames = 0;
+    LeftFilter.Reset();
+    RightFilter.Reset();
+    LeftRotMask = 0;
+    RightRotMask = 0;
     LastLeftTimeSec = 0.0;
     LastRightTimeSec = 0.0;
     bPrevLeftHadRawData = false;
     bPrevRightHadRawData = false;
+    LastHandDataSerial = 0;
     
     Super::EndPlay(EndPlayReason);
 }
@@ -48,8 +48,8 @@ void UHandDataListenerComponent::BindToInputPlusSubsystem()
             
             if (InputPlusSubsystem)
             {
-                // 绑定到新的双手数据动态委托
-                InputPlusSubsystem->OnHandDataReceivedDynamic.AddDynamic(this, &UHandDataListenerComponent::OnBothHandsDataReceived);
+                // 从当前缓存序号开始，只处理之后到达的新帧
+                LastHandDataSerial = InputPlusSubsystem->GetHandDataSerial();
                 
                 UE_LOG(LogTemp, Log, TEXT("HandDataListenerComponent: Successfully bound to InputPlusSubsystem for both hands data"));
             }
@@ -65,9 +65,6 @@ void UHandDataListenerComponent::UnbindFromInputPlusSubsystem()
 {
     if (InputPlusSubsystem)
     {
-        // 从双手数据动态委托解绑
-        InputPlusSubsystem->OnHandDataReceivedDynamic.RemoveDynamic(this, &UHandDataListenerComponent::OnBothHandsDataReceived);
-        
         InputPlusSubsystem = nullptr;
         
         UE_LOG(LogTemp, Log, TEXT("HandDataListenerComponent: Unbound from InputPlusSubsystem"));
@@ -98,65 +95,110 @@ void UHandDataListenerComponent::TransformToRotMap(const TArray<FVector>& Points
         UE_LOG(LogTemp, Warning, TEXT("getHandDir: Points21 array does not contain enough points (expected 21, got %d)"), Points21.Num());
         return;
     }
-    
-    TArray<FVector> UEPoints = Points21;
-    for (int i =0; i < 21; i++)
+
+    FRotator Rel[HAND_NumJoints];
+    FRotator Parent[HAND_NumJoints];
+    uint32 Mask = 0;
+    TransformToRotArrays(Points21.GetData(), isLeft, Rel, Parent, Mask);
+
+    for (int32 j = 0; j < HAND_NumJoints; ++j)
     {
-        FVector locV = FVector(Points21[i].Z, Points21[i].X, Points21[i].Y * (-1));
-        UEPoints[i] = locV;
+        if (Mask & (1u << j))
+        {
+            OutRotParentMap.Add(j, Parent[j]);
+            if (j != 0) OutRotRelativeMap.Add(j, Rel[j]);
+        }
     }
-    FVector Forward, Right, Up;
-    getHandDir(UEPoints, Forward, Right, Up);
-    // ((X=0,Y=5,Z=6),(X=5,Y=6,Z=7),(X=6,Y=7,Z=8),(X=0,Y=9,Z=10),(X=9,Y=10,Z=11),(X=10,Y=11,Z=12),(X=0,Y=13,Z=14),(X=13,Y=14,Z=15),(X=14,Y=15,Z=16),(X=0,Y=17,Z=18),(X=17,Y=18,Z=19),(X=18,Y=19,Z=20),(X=0,Y=1,Z=2),(X=1,Y=2,Z=3),(X=2,Y=3,Z=4),(X=0,Y=0,Z=0))
-    TArray<FIntVector> Rot = {
+}
+
+void UHandDataListenerComponent::TransformToRotArrays(const FVector* Points21, bool isLeft,
+    FRotator (&OutRotRelative)[HAND_NumJoints], FRotator (&OutRotParent)[HAND_NumJoints], uint32& OutMask)
+{
+    // (父, 自身, 子) 三元组
+    static const FIntVector Rot[15] = {
         FIntVector(0, 5, 6), FIntVector(5, 6, 7), FIntVector(6, 7, 8),
         FIntVector(0, 9, 10), FIntVector(9, 10, 11), FIntVector(10, 11, 12),
         FIntVector(0, 13, 14), FIntVector(13, 14, 15),FIntVector(14, 15, 16),
         FIntVector(0, 17, 18), FIntVector(17, 18, 19), FIntVector(18, 19, 20),
         FIntVector(0, 1, 2), FIntVector(1, 2, 3), FIntVector(2, 3, 4)};
 
-    // 手掌基础旋转
-    FRotator BaseRot = FRotationMatrix::MakeFromXZ(Forward, Up).Rotator();
-    OutRotParentMap.Add(0, BaseRot);
-    
-    // 计算每个关节的绝对旋转和相对旋转
-    for (auto i : Rot)
+    // 转到 UE 坐标系
+    FVector UEPoints[HAND_NumJoints];
+    for (int i =0; i < HAND_NumJoints; i++)
     {
-        FVector A = UEPoints[i.X];
-        FVector B = UEPoints[i.Y];
-        FVector C = UEPoints[i.Z];
+        UEPoints[i] = FVector(Points21[i].Z, Points21[i].X, Points21[i].Y * (-1));
+    }
 
-        if (i.X == 0)
-        {
-            FVector ParForward = (B - A).GetSafeNormal();
-            FVector UpOrtho = (Up - FVector::DotProduct(Up, ParForward) * ParForward).GetSafeNormal();
-            // Parent orientation for root can be derived if needed; currently not used further.
-            FRotationMatrix::MakeFromXZ(ParForward, UpOrtho);
-        }
-        // self
+    // 手掌方向（同 getHandDir，左手约定）
+    const FVector Forward = (UEPoints[9] - UEPoints[0]).GetSafeNormal();
+    const FVector Up = FVector::CrossProduct(UEPoints[17] - UEPoints[0], UEPoints[9] - UEPoints[0]).GetSafeNormal();
+    const FVector Right = FVector::CrossProduct(Forward, Up).GetSafeNormal();
 
-        FVector BoneDirection = (C - B).GetSafeNormal();
+    // 手掌基础旋转（对所有关节不变，只算一次）
+    const FMatrix BaseM = FRotationMatrix::MakeFromXZ(Forward, Up);
+    OutRotParent[0] = BaseM.Rotator();
+    const FQuat AqInv = BaseM.ToQuat().Inverse();
+    OutMask = 1u;
 
-        FVector BoneUp = FVector::CrossProduct(Right,BoneDirection).GetSafeNormal();
-        FVector BoneUpOrtho = (BoneUp - FVector::DotProduct(BoneUp, BoneDirection) * BoneDirection).GetSafeNormal();
-        
-        FRotator BoneRot = FRotationMatrix::MakeFromXZ(BoneDirection, BoneUpOrtho).Rotator();
-        OutRotParentMap.Add(i.Y, BoneRot - FRotator(0,0,(isLeft ? 90 : -90)));
+    const double RollOffset = isLeft ? 90 : -90;
+    const double YawSign = isLeft ? 1 : -1;
 
-        //计算子骨骼在父骨骼坐标系下的相对旋转
-        // A、B 都是世���旋转
-        //FQuat Aq = ParentRot.Quaternion();
-        FQuat Aq = FRotationMatrix::MakeFromXZ(Forward, Up).ToQuat();
-        FQuat Bq = BoneRot.Quaternion();
+    // 计算每个关节的绝对旋转和相对旋转
+    for (const FIntVector& i : Rot)
+    {
+        const FVector& B = UEPoints[i.Y];
+        const FVector& C = UEPoints[i.Z];
 
-        // B 相对 A 的局部旋转
-        FQuat RelQ = Aq.Inverse() * Bq ;   // ← 关键公式
-        FRotator Rel = RelQ.Rotator();
+        const FVector BoneDirection = (C - B).GetSafeNormal();
+        const FVector BoneUp = FVector::CrossProduct(Right,BoneDirection).GetSafeNormal();
+        const FVector BoneUpOrtho = (BoneUp - FVector::DotProduct(BoneUp, BoneDirection) * BoneDirection).GetSafeNormal();
 
-        OutRotRelativeMap.Add(i.Y, Rel- FRotator(0,0,(isLeft ? 90 : -90)));
-        OutRotRelativeMap.Add(i.Y, FRotator(Rel.Pitch,Rel.Yaw * (isLeft ? 1: -1),Rel.Roll - (isLeft ? 90 : -90)));
-            
+        const FMatrix BoneM = FRotationMatrix::MakeFromXZ(BoneDirection, BoneUpOrtho);
+        const FRotator BoneRot = BoneM.Rotator();
+        OutRotParent[i.Y] = BoneRot - FRotator(0,0,RollOffset);
+
+        // 子骨骼在手掌坐标系下的相对旋转：Rel = Inverse(A) * B
+        const FRotator Rel = (AqInv * BoneM.ToQuat()).Rotator();
+        OutRotRelative[i.Y] = FRotator(Rel.Pitch, Rel.Yaw * YawSign, Rel.Roll - RollOffset);
+        OutMask |= (1u << i.Y);
+    }
+}
+
+FRotator UHandDataListenerComponent::GetJointRotation(bool bLeft, int32 JointIndex, bool bRelative) const
+{
+    if (JointIndex < 0 || JointIndex >= HAND_NumJoints)
+    {
+        return FRotator::ZeroRotator;
+    }
+    const uint32 Mask = bLeft ? LeftRotMask : RightRotMask;
+    if ((Mask & (1u << JointIndex)) == 0)
+    {
+        return FRotator::ZeroRotator;
+    }
+    if (bLeft)
+    {
+        return bRelative ? LeftRotRelative[JointIndex] : LeftRotWorld[JointIndex];
     }
+    return bRelative ? RightRotRelative[JointIndex] : RightRotWorld[JointIndex];
+}
+
+FHandFilterSettings UHandDataListenerComponent::MakeFilterSettings() const
+{
+    FHandFilterSettings S;
+    S.bEnableSmoothing = bEnableSmoothing;
+    S.SmoothingAlpha = SmoothingAlpha;
+    S.bEnableOutlierFilter = bEnableOutlierFilter;
+    S.OutlierJumpScale = OutlierJumpScale;
+    S.DropFrameBadPointRatio = DropFrameBadPointRatio;
+    S.bDropFrameOnTooManyOutliers = bDropFrameOnTooManyOutliers;
+    S.WarmupAcceptedFrames = WarmupAcceptedFrames;
+    S.bAdaptiveJumpThreshold = bAdaptiveJumpThreshold;
+    S.TargetFrameRate = TargetFrameRate;
+    S.MaxAdaptiveThresholdScale = MaxAdaptiveThresholdScale;
+    S.bVelocityClampEnabled = bVelocityClampEnabled;
+    S.MaxSpeedScalePerSecond = MaxSpeedScalePerSecond;
+    S.bTreatReacquireAsBaseline = bTreatReacquireAsBaseline;
+    return S;
 }
 
 // 计算手掌参考尺寸：使用 0->(5,9,13,17) 的距离均值作为尺度
@@ -270,205 +312,118 @@ bool UHandDataListenerComponent::SmoothAndFilterOneHand(const TArray<FString>& K
     return true;
 }
 
-// 增强版平滑与过滤
-bool UHandDataListenerComponent::SmoothAndFilterOneHandEx(
-    const TArray<FString>& Keys,
-    const TArray<FVector>& InValues,
-    TArray<FVector>& InOutPrevPoints,
-    float& InOutPrevPalmSize,
-    bool bIsLeft,
-    float DeltaTime,
-    bool bJustReacquired,
-    int32 AcceptedCount,
-    TArray<FVector>& OutValues)
+void UHandDataListenerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-    OutValues = InValues;
-    const int32 NumPts = InValues.Num();
-    if (NumPts == 0)
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!InputPlusSubsystem)
     {
-        return false;
+        return;
     }
 
-    // 无有效上一帧或重获跟踪作为基线
-    const bool bNoPrev = (InOutPrevPoints.Num() != NumPts);
-    if ((bJustReacquired && bTreatReacquireAsBaseline) || bNoPrev)
+    // 同一帧内多个组件重复调用时只会生效一次
+    const int64 Serial = InputPlusSubsystem->PumpHandFrames();
+    if (Serial == LastHandDataSerial)
     {
-        InOutPrevPoints = InValues;
-        InOutPrevPalmSize = ComputePalmReferenceSize(InValues);
-        OutValues = InOutPrevPoints;
-        return true;
+        return;
     }
+    LastHandDataSerial = Serial;
 
-    // 计算参考尺寸
-    float PalmRef = ComputePalmReferenceSize(InValues);
-    if (PalmRef <= KINDA_SMALL_NUMBER)
+    FHandLandmarkData LeftHand;
+    FHandLandmarkData RightHand;
+    InputPlusSubsystem->GetLatestHandData(LeftHand, RightHand);
+    ProcessLatestHands(LeftHand, RightHand);
+}
+
+void UHandDataListenerComponent::ProcessLatestHands(const FHandLandmarkData& LeftHand, const FHandLandmarkData& RightHand)
+{
+    UWorld* World = GetWorld();
+    const double Now = World ? World->GetTimeSeconds() : 0.0;
+    const float DefaultDt = 1.0f / FMath::Max(1.0f, TargetFrameRate);
+    const FHandFilterSettings Settings = MakeFilterSettings();
+
+    // 左手时间与状态
+    const bool bLeftHasRaw = LeftHand.Values.Num() >= HAND_NumJoints; // 期望 21 点
+    const bool bLeftJustReacquired = bLeftHasRaw && !bPrevLeftHadRawData;
+    const float LeftDt = (LastLeftTimeSec > 0.0 && World) ? static_cast<float>(Now - LastLeftTimeSec) : DefaultDt;
+
+    // 右手时间与状态
+    const bool bRightHasRaw = RightHand.Values.Num() >= HAND_NumJoints;
+    const bool bRightJustReacquired = bRightHasRaw && !bPrevRightHadRawData;
+    const float RightDt = (LastRightTimeSec > 0.0 && World) ? static_cast<float>(Now - LastRightTimeSec) : DefaultDt;
+
+    // 处理：整只手一次完成过滤（SoA），输出写回到广播用数组
+    TArray<FVector> LeftProcessed = LeftHand.Values;
+    TArray<FVector> RightProcessed = RightHand.Values;
+
+    bool bLeftAccepted = false;
+    bool bRightAccepted = false;
+    FHandJointsSoA In, Out;
+
+    if (bLeftHasRaw)
     {
-        PalmRef = InOutPrevPalmSize > KINDA_SMALL_NUMBER ? InOutPrevPalmSize : 1.f;
+        In.Load(LeftHand.Values.GetData());
+        bLeftAccepted = UHandKinematicsBPLibrary::FilterHandBatch(Settings, LeftFilter, In, LeftDt, bLeftJustReacquired, Out);
+        Out.Store(LeftProcessed.GetData());
+        LastLeftTimeSec = Now;
     }
-    InOutPrevPalmSize = PalmRef;
 
-    // 基础跳变阈值
-    float Threshold = OutlierJumpScale * PalmRef;
-
-    // 自适应阈值（随丢帧放宽）
-    if (bAdaptiveJumpThreshold)
+    if (bRightHasRaw)
     {
-        const float TargetDt = 1.0f / FMath::Max(1.0f, TargetFrameRate);
-        const float Scale = FMath::Clamp(DeltaTime / TargetDt, 1.0f, MaxAdaptiveThresholdScale);
-        Threshold *= Scale;
+        In.Load(RightHand.Values.GetData());
+        bRightAccepted = UHandKinematicsBPLibrary::FilterHandBatch(Settings, RightFilter, In, RightDt, bRightJustReacquired, Out);
+        Out.Store(RightProcessed.GetData());
+        LastRightTimeSec = Now;
     }
 
-    // 预热阶段：放宽或跳过离群��定
-    const bool bInWarmup = AcceptedCount < WarmupAcceptedFrames;
+    // 更新“是否有原始数据”标记
+    bPrevLeftHadRawData = bLeftHasRaw;
+    bPrevRightHadRawData = bRightHasRaw;
 
-    int32 OutlierCount = 0;
-    TArray<FVector> Filtered = InValues;
-    if (bEnableOutlierFilter && !bInWarmup)
+    // 若两侧都未接受新帧，直接返回
+    if (!bLeftAccepted && !bRightAccepted)
     {
-        for (int32 i = 0; i < NumPts; ++i)
-        {
-            const FVector& Prev = InOutPrevPoints[i];
-            const FVector& Cur = InValues[i];
-            const float Delta = FVector::Dist(Prev, Cur);
-            if (Delta > Threshold)
-            {
-                ++OutlierCount;
-                Filtered[i] = Prev; // 抑制离群
-            }
-        }
-
-        if (bDropFrameOnTooManyOutliers && NumPts > 0)
-        {
-            const float Ratio = static_cast<float>(OutlierCount) / static_cast<float>(NumPts);
-            if (Ratio >= DropFrameBadPointRatio)
-            {
-                // 丢弃：维持上一帧
-                OutValues = InOutPrevPoints;
-                return false;
-            }
-        }
+        return;
     }
 
-    // 速度限幅（按 dt）
-    if (bVelocityClampEnabled)
+    // 广播与旋转计算使用处理后的数据
+    OnBothHands.Broadcast(LeftHand.Keys, LeftProcessed, RightHand.Keys, RightProcessed);
+
+    // 旋转写入固定索引数组；TMap 仅在需要兼容旧蓝图时更新
+    if (bLeftHasRaw)
+    {
+        TransformToRotArrays(LeftProcessed.GetData(), true, LeftRotRelative, LeftRotWorld, LeftRotMask);
+    }
+    if (bRightHasRaw)
+    {
+        TransformToRotArrays(RightProcessed.GetData(), false, RightRotRelative, RightRotWorld, RightRotMask);
+    }
+    if (bUpdateRotationMaps)
     {
-        const float MaxDisp = MaxSpeedScalePerSecond * PalmRef * FMath::Max(0.f, DeltaTime);
-        if (MaxDisp > 0.f)
+        for (int32 j = 0; j < HAND_NumJoints; ++j)
         {
-            for (int32 i = 0; i < NumPts; ++i)
+            if (LeftRotMask & (1u << j))
             {
-                const FVector& Prev = InOutPrevPoints[i];
-                const FVector& Target = Filtered[i];
-                const FVector Offset = Target - Prev;
-                const float Len = Offset.Size();
-                if (Len > MaxDisp)
-                {
-                    Filtered[i] = Prev + Offset * (MaxDisp / Len);
-                }
+                LeftRotWorldMap.Add(j, LeftRotWorld[j]);
+                if (j != 0) LeftRotRelativeMap.Add(j, LeftRotRelative[j]);
+            }
+            if (RightRotMask & (1u << j))
+            {
+                RightRotWorldMap.Add(j, RightRotWorld[j]);
+                if (j != 0) RightRotRelativeMap.Add(j, RightRotRelative[j]);
             }
         }
     }
 
-    // 平滑（指数）
-    if (bEnableSmoothing)
+    // 兼容旧委托：优先右手
+    if (RightHand.Keys.Num() > 0)
     {
-        const float Alpha = FMath::Clamp(SmoothingAlpha, 0.f, 1.f);
-        for (int32 i = 0; i < NumPts; ++i)
-        {
-            const FVector& Prev = InOutPrevPoints[i];
-            const FVector& Target = Filtered[i];
-            InOutPrevPoints[i] = FMath::Lerp(Prev, Target, Alpha);
-        }
-        OutValues = InOutPrevPoints;
+        OnHands.Broadcast(RightHand.Keys, RightProcessed);
     }
-    else
+    else if (LeftHand.Keys.Num() > 0)
     {
-        InOutPrevPoints = Filtered;
-        OutValues = Filtered;
+        OnHands.Broadcast(LeftHand.Keys, LeftProcessed);
     }
-
-    return true;
-}
-
-
-
-void UHandDataListenerComponent::OnBothHandsDataReceived(const TArray<FString>& LeftHandKeys, const TArray<FVector>& LeftHandValues,
-                                                       const TArray<FString>& RightHandKeys, const TArray<FVector>& RightHandValues)
-{
-    // 复制数据，因为我们需要跨线程传递
-    TArray<FString> LeftKeysCopy = LeftHandKeys;
-    TArray<FVector> LeftValuesCopy = LeftHandValues;
-    TArray<FString> RightKeysCopy = RightHandKeys;
-    TArray<FVector> RightValuesCopy = RightHandValues;
-    
-    // 使用 AsyncTask 确保在游戏线程执行广播
-    AsyncTask(ENamedThreads::GameThread, [this, LeftKeysCopy, LeftValuesCopy, RightKeysCopy, RightValuesCopy]()
-    {
-        if (!IsValid(this))
-        {
-            return;
-        }
-
-        UWorld* World = GetWorld();
-        const double Now = World ? World->GetTimeSeconds() : 0.0;
-
-        // 左手时间与状态
-        const bool bLeftHasRaw = LeftValuesCopy.Num() >= 21; // 期望 21 点
-        const bool bLeftJustReacquired = bLeftHasRaw && !bPrevLeftHadRawData;
-        const float LeftDt = (LastLeftTimeSec > 0.0 && World) ? static_cast<float>(Now - LastLeftTimeSec) : (1.0f / FMath::Max(1.0f, TargetFrameRate));
-
-        // 右手时间与状态
-        const bool bRightHasRaw = RightValuesCopy.Num() >= 21;
-        const bool bRightJustReacquired = bRightHasRaw && !bPrevRightHadRawData;
-        const float RightDt = (LastRightTimeSec > 0.0 && World) ? static_cast<float>(Now - LastRightTimeSec) : (1.0f / FMath::Max(1.0f, TargetFrameRate));
-
-        // 处理
-        TArray<FVector> LeftProcessed = LeftValuesCopy;
-        TArray<FVector> RightProcessed = RightValuesCopy;
-
-        bool bLeftAccepted = false;
-        bool bRightAccepted = false;
-
-        if (bLeftHasRaw)
-        {
-            bLeftAccepted = SmoothAndFilterOneHandEx(LeftKeysCopy, LeftValuesCopy, PrevLeftPoints, PrevLeftPalmSize, true, LeftDt, bLeftJustReacquired, LeftAcceptedFrames, LeftProcessed);
-            if (bLeftAccepted) { ++LeftAcceptedFrames; }
-            LastLeftTimeSec = Now;
-        }
-
-        if (bRightHasRaw)
-        {
-            bRightAccepted = SmoothAndFilterOneHandEx(RightKeysCopy, RightValuesCopy, PrevRightPoints, PrevRightPalmSize, false, RightDt, bRightJustReacquired, RightAcceptedFrames, RightProcessed);
-            if (bRightAccepted) { ++RightAcceptedFrames; }
-            LastRightTimeSec = Now;
-        }
-
-        // 更新“是否有原始数据”标记
-        bPrevLeftHadRawData = bLeftHasRaw;
-        bPrevRightHadRawData = bRightHasRaw;
-
-        // 若两侧都未接受新帧，直接返回
-        if (!bLeftAccepted && !bRightAccepted)
-        {
-            return;
-        }
-
-        // 广播与旋转计算使用处理后的数据
-        OnBothHands.Broadcast(LeftKeysCopy, LeftProcessed, RightKeysCopy, RightProcessed);
-
-        this->TransformToRotMap(LeftProcessed, LeftRotRelativeMap, LeftRotWorldMap, true);
-        this->TransformToRotMap(RightProcessed, RightRotRelativeMap, RightRotWorldMap, false);
-
-        // 兼容旧委托：优先右手
-        if (RightKeysCopy.Num() > 0)
-        {
-            OnHands.Broadcast(RightKeysCopy, RightProcessed);
-        }
-        else if (LeftKeysCopy.Num() > 0)
-        {
-            OnHands.Broadcast(LeftKeysCopy, LeftProcessed);
-        }
-    });
 }
 
 void UHandDataListenerComponent::GetLatestHandData(FHandLandmarkData& OutLeftHand, FHandLandmarkData& OutRightHand)
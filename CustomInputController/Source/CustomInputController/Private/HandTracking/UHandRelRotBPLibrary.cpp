@@ -23,7 +23,7 @@ FVector UHandKinematicsBPLibrary::NormalizeSafe(const FVector& V)
     return (S > 1e-8) ? V / S : FVector::ZeroVector;
 }
 
-FVector UHandKinematicsBPLibrary::StablePalmZ(const TArray<FVector>& P, bool bIsRightHand, const FVector* PrevPalmZ)
+FVector UHandKinematicsBPLibrary::StablePalmZ(const FVector* P, bool bIsRightHand, const FVector* PrevPalmZ)
 {
     const int idxs[] = {0,5,9,13,17}; // Wrist + 四 MCP
     FVector n(0,0,0);
@@ -155,16 +155,14 @@ FQuat UHandKinematicsBPLibrary::ClampMCP_YZ(const FQuat& Rrel, float FlexMinDeg,
 }
 
 // —— 主计算 —— //
-void UHandKinematicsBPLibrary::BuildRelRotations_Internal(
-    const TArray<FVector>& Points21, bool bIsRight, FHandRuntimeState& State, const FHandLimitsConfig& Limits,
-    TMap<int32, FQuat>& OutQuatMap)
+void UHandKinematicsBPLibrary::BuildRelRotations_Fixed(
+    const FVector* P, bool bIsRight, FHandKinematicsState& State, const FHandLimitsConfig& Limits,
+    FQuat* OutRel, uint32& OutValidMask)
 {
-    OutQuatMap.Reset();
-
-    if (Points21.Num() < 21) return;
+    OutValidMask = 0;
 
     // 1) 稳定掌法向（手背 +Z）
-    const FVector PalmZ = StablePalmZ(Points21, bIsRight, &State.PrevPalmZ);
+    const FVector PalmZ = StablePalmZ(P, bIsRight, &State.PrevPalmZ);
     State.PrevPalmZ = PalmZ;
 
     // 2) 逐指逐段：父->子 相对旋转，维护段内 X 的连续
@@ -180,13 +178,11 @@ void UHandKinematicsBPLibrary::BuildRelRotations_Internal(
             const int32 c = Chain[i+1];
 
             // 取上一帧的 X：父段(p->j) 的 Key=j；子段(j->c) 的 Key=c
-            const FVector* PrevXp = State.PrevXByChildJoint.Find(j);
-            const FVector* PrevXc = State.PrevXByChildJoint.Find(c);
+            const FVector* PrevXp = (State.PrevXValidMask & (1u << j)) ? &State.PrevXByChildJoint[j] : nullptr;
+            const FVector* PrevXc = (State.PrevXValidMask & (1u << c)) ? &State.PrevXByChildJoint[c] : nullptr;
 
             FVector ChildX;
-            FQuat Rrel = RelRotParentToChild(
-                Points21[p], Points21[j], Points21[c],
-                PalmZ, &ChildX, PrevXp, PrevXc);
+            FQuat Rrel = RelRotParentToChild(P[p], P[j], P[c], PalmZ, &ChildX, PrevXp, PrevXc);
 
             // 3) 限位/去扭
             if (IsPIPorDIP(j) && Limits.bLimitPIPDIP)
@@ -203,14 +199,183 @@ void UHandKinematicsBPLibrary::BuildRelRotations_Internal(
             }
 
             Rrel.Normalize();
-            OutQuatMap.Add(j, Rrel);
+            OutRel[j] = Rrel;
+            OutValidMask |= (1u << j);
 
             // 更新子段 X，供下一帧使用
-            State.PrevXByChildJoint.FindOrAdd(c) = ChildX;
+            State.PrevXByChildJoint[c] = ChildX;
+            State.PrevXValidMask |= (1u << c);
+        }
+    }
+}
+
+// 蓝图状态（TMap）<-> 固定索引状态
+static void HandStateToFixed(const FHandRuntimeState& State, FHandKinematicsState& Fixed)
+{
+    Fixed.PrevPalmZ = State.PrevPalmZ;
+    Fixed.PrevXValidMask = 0;
+    for (const auto& KVP : State.PrevXByChildJoint)
+    {
+        if (KVP.Key >= 0 && KVP.Key < HAND_NumJoints)
+        {
+            Fixed.PrevXByChildJoint[KVP.Key] = KVP.Value;
+            Fixed.PrevXValidMask |= (1u << KVP.Key);
         }
     }
 }
 
+static void HandStateFromFixed(const FHandKinematicsState& Fixed, FHandRuntimeState& State)
+{
+    State.PrevPalmZ = Fixed.PrevPalmZ;
+    for (int32 j = 0; j < HAND_NumJoints; ++j)
+    {
+        if (Fixed.PrevXValidMask & (1u << j)) State.PrevXByChildJoint.FindOrAdd(j) = Fixed.PrevXByChildJoint[j];
+    }
+}
+
+void UHandKinematicsBPLibrary::BuildRelRotations_Internal(
+    const TArray<FVector>& Points21, bool bIsRight, FHandRuntimeState& State, const FHandLimitsConfig& Limits,
+    TMap<int32, FQuat>& OutQuatMap)
+{
+    OutQuatMap.Reset();
+
+    if (Points21.Num() < 21) return;
+
+    FHandKinematicsState Fixed;
+    HandStateToFixed(State, Fixed);
+
+    FQuat Rel[HAND_NumJoints];
+    uint32 ValidMask = 0;
+    BuildRelRotations_Fixed(Points21.GetData(), bIsRight, Fixed, Limits, Rel, ValidMask);
+
+    HandStateFromFixed(Fixed, State);
+    for (int32 j = 0; j < HAND_NumJoints; ++j)
+    {
+        if (ValidMask & (1u << j)) OutQuatMap.Add(j, Rel[j]);
+    }
+}
+
+// 手掌参考尺寸：0->(5,9,13,17) 的距离均值
+static float HandPalmSizeSoA(const FHandJointsSoA& P)
+{
+    static const int32 Candidates[4] = {5, 9, 13, 17};
+    float Sum = 0.f;
+    for (int32 k = 0; k < 4; ++k)
+    {
+        const int32 i = Candidates[k];
+        const float dx = P.X[i] - P.X[0];
+        const float dy = P.Y[i] - P.Y[0];
+        const float dz = P.Z[i] - P.Z[0];
+        Sum += FMath::Sqrt(dx*dx + dy*dy + dz*dz);
+    }
+    return Sum * 0.25f;
+}
+
+bool UHandKinematicsBPLibrary::FilterHandBatch(
+    const FHandFilterSettings& S,
+    FHandFilterState& St,
+    const FHandJointsSoA& In,
+    float DeltaTime,
+    bool bJustReacquired,
+    FHandJointsSoA& Out)
+{
+    // 无有效上一帧或重获跟踪作为基线
+    if ((bJustReacquired && S.bTreatReacquireAsBaseline) || !St.bHasPrev)
+    {
+        St.Prev = In;
+        St.PrevPalmSize = HandPalmSizeSoA(In);
+        St.bHasPrev = true;
+        ++St.AcceptedFrames;
+        Out = In;
+        return true;
+    }
+
+    // 计算参考尺寸
+    float PalmRef = HandPalmSizeSoA(In);
+    if (PalmRef <= KINDA_SMALL_NUMBER)
+    {
+        PalmRef = St.PrevPalmSize > KINDA_SMALL_NUMBER ? St.PrevPalmSize : 1.f;
+    }
+    St.PrevPalmSize = PalmRef;
+
+    // 跳变阈值（随丢帧放宽）
+    float Threshold = S.OutlierJumpScale * PalmRef;
+    if (S.bAdaptiveJumpThreshold)
+    {
+        const float TargetDt = 1.0f / FMath::Max(1.0f, S.TargetFrameRate);
+        Threshold *= FMath::Clamp(DeltaTime / TargetDt, 1.0f, S.MaxAdaptiveThresholdScale);
+    }
+    const float Threshold2 = Threshold * Threshold;
+
+    // 第一遍：逐点位移平方，记录离群点（预热阶段不判定）
+    const bool bCheckOutliers = S.bEnableOutlierFilter && St.AcceptedFrames >= S.WarmupAcceptedFrames;
+    uint32 OutlierMask = 0;
+    int32 OutlierCount = 0;
+    if (bCheckOutliers)
+    {
+        for (int32 i = 0; i < HAND_NumJoints; ++i)
+        {
+            const float dx = In.X[i] - St.Prev.X[i];
+            const float dy = In.Y[i] - St.Prev.Y[i];
+            const float dz = In.Z[i] - St.Prev.Z[i];
+            const bool bOut = (dx*dx + dy*dy + dz*dz) > Threshold2;
+            OutlierMask |= (bOut ? 1u : 0u) << i;
+            OutlierCount += bOut ? 1 : 0;
+        }
+
+        if (S.bDropFrameOnTooManyOutliers
+            && static_cast<float>(OutlierCount) / static_cast<float>(HAND_NumJoints) >= S.DropFrameBadPointRatio)
+        {
+            // 丢弃：维持上一帧
+            Out = St.Prev;
+            return false;
+        }
+    }
+
+    // 第二遍：离群抑制 + 速度限幅 + 指数平滑，一次写回
+    const float MaxDisp = S.bVelocityClampEnabled ? S.MaxSpeedScalePerSecond * PalmRef * FMath::Max(0.f, DeltaTime) : 0.f;
+    const float MaxDisp2 = MaxDisp * MaxDisp;
+    const float Alpha = S.bEnableSmoothing ? FMath::Clamp(S.SmoothingAlpha, 0.f, 1.f) : 1.f;
+    for (int32 i = 0; i < HAND_NumJoints; ++i)
+    {
+        const bool bOut = (OutlierMask >> i) & 1u;
+        float dx = bOut ? 0.f : In.X[i] - St.Prev.X[i];
+        float dy = bOut ? 0.f : In.Y[i] - St.Prev.Y[i];
+        float dz = bOut ? 0.f : In.Z[i] - St.Prev.Z[i];
+
+        if (MaxDisp > 0.f)
+        {
+            const float Len2 = dx*dx + dy*dy + dz*dz;
+            if (Len2 > MaxDisp2)
+            {
+                const float K = MaxDisp * FMath::InvSqrt(Len2);
+                dx *= K; dy *= K; dz *= K;
+            }
+        }
+
+        St.Prev.X[i] += dx * Alpha;
+        St.Prev.Y[i] += dy * Alpha;
+        St.Prev.Z[i] += dz * Alpha;
+    }
+
+    ++St.AcceptedFrames;
+    Out = St.Prev;
+    return true;
+}
+
+void UHandKinematicsBPLibrary::ComputeHandRelativeRotationsBatch(
+    const FHandJointsSoA& Points,
+    bool bIsRightHand,
+    FHandKinematicsState& InOutState,
+    const FHandLimitsConfig& Limits,
+    FQuat (&OutRel)[HAND_NumJoints],
+    uint32& OutValidMask)
+{
+    FVector P[HAND_NumJoints];
+    Points.Store(P);
+    BuildRelRotations_Fixed(P, bIsRightHand, InOutState, Limits, OutRel, OutValidMask);
+}
+
 
 // —— 对外：蓝图可见的函数 —— //
 
@@ -238,6 +403,34 @@ void UHandKinematicsBPLibrary::ComputeHandRelativeRotations_Map(
     }
 }
 
+void UHandKinematicsBPLibrary::ComputeHandRelativeRotations_Array(
+    const TArray<FVector>& Points21,
+    bool bIsRightHand,
+    FHandRuntimeState& InOutState,
+    const FHandLimitsConfig& Limits,
+    TArray<FRotator>& OutJointRot21)
+{
+    OutJointRot21.Init(FRotator::ZeroRotator, HAND_NumJoints);
+    if (Points21.Num() < 21)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ComputeHandRelativeRotations_Array: Points21.Num()=%d < 21"), Points21.Num());
+        return;
+    }
+
+    FHandKinematicsState Fixed;
+    HandStateToFixed(InOutState, Fixed);
+
+    FQuat Rel[HAND_NumJoints];
+    uint32 ValidMask = 0;
+    BuildRelRotations_Fixed(Points21.GetData(), bIsRightHand, Fixed, Limits, Rel, ValidMask);
+
+    HandStateFromFixed(Fixed, InOutState);
+    for (int32 j = 0; j < HAND_NumJoints; ++j)
+    {
+        if (ValidMask & (1u << j)) OutJointRot21[j] = Rel[j].Rotator();
+    }
+}
+
 FRotator UHandKinematicsBPLibrary::ComputeWristOrientation(
     const TArray<FVector>& Points21,
     bool bIsRightHand,
@@ -249,7 +442,7 @@ FRotator UHandKinematicsBPLibrary::ComputeWristOrientation(
         return FRotator::ZeroRotator;
     }
     // Z = PalmZ；X = WRIST->MIDDLE_MCP 投影到掌面；Y = Z×X
-    const FVector PalmZ = StablePalmZ(Points21, bIsRightHand, &InOutState.PrevPalmZ);
+    const FVector PalmZ = StablePalmZ(Points21.GetData(), bIsRightHand, &InOutState.PrevPalmZ);
     InOutState.PrevPalmZ = PalmZ;
 
     const FVector A = Points21[0];
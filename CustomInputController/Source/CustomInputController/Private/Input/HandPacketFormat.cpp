@@ -0,0 +1,122 @@
+﻿#include "Input/HandPacketFormat.h"
+
+namespace HandPacketText
+{
+    /** 取下一个非空分段 [OutBegin, OutEnd)，分隔符为 Delim；无更多分段返回 false */
+    static bool NextToken(const char*& Cursor, const char* End, char Delim, const char*& OutBegin, const char*& OutEnd)
+    {
+        while (Cursor < End && *Cursor == Delim) { ++Cursor; }
+        if (Cursor >= End) return false;
+        OutBegin = Cursor;
+        while (Cursor < End && *Cursor != Delim) { ++Cursor; }
+        OutEnd = Cursor;
+        return true;
+    }
+
+    static bool TokenEquals(const char* Begin, const char* End, const char* Literal)
+    {
+        const int32 Len = (int32)FCStringAnsi::Strlen(Literal);
+        return (int32)(End - Begin) == Len && FMemory::Memcmp(Begin, Literal, Len) == 0;
+    }
+
+    /** 解析 [Begin, End) 内完整的十进制浮点数（可带符号/小数/指数，允许首尾空白） */
+    static bool ParseFloat(const char* Begin, const char* End, float& Out)
+    {
+        while (Begin < End && (*Begin == ' ' || *Begin == '\t' || *Begin == '\r' || *Begin == '\n')) { ++Begin; }
+        while (End > Begin && (End[-1] == ' ' || End[-1] == '\t' || End[-1] == '\r' || End[-1] == '\n' || End[-1] == '\0')) { --End; }
+        if (Begin >= End) return false;
+
+        const char* P = Begin;
+        bool bNeg = false;
+        if (*P == '+' || *P == '-') { bNeg = (*P == '-'); ++P; }
+
+        double Mantissa = 0.0;
+        int32 Digits = 0;
+        while (P < End && *P >= '0' && *P <= '9') { Mantissa = Mantissa * 10.0 + (*P - '0'); ++P; ++Digits; }
+        if (P < End && *P == '.')
+        {
+            ++P;
+            double Frac = 0.1;
+            while (P < End && *P >= '0' && *P <= '9') { Mantissa += (*P - '0') * Frac; Frac *= 0.1; ++P; ++Digits; }
+        }
+        if (Digits == 0) return false;
+
+        if (P < End && (*P == 'e' || *P == 'E'))
+        {
+            ++P;
+            bool bExpNeg = false;
+            if (P < End && (*P == '+' || *P == '-')) { bExpNeg = (*P == '-'); ++P; }
+            int32 Exp = 0, ExpDigits = 0;
+            while (P < End && *P >= '0' && *P <= '9') { Exp = FMath::Min(Exp * 10 + (*P - '0'), 400); ++P; ++ExpDigits; }
+            if (ExpDigits == 0) return false;
+            Mantissa *= FMath::Pow(10.0, (double)(bExpNeg ? -Exp : Exp));
+        }
+        if (P != End) return false;
+
+        Out = (float)(bNeg ? -Mantissa : Mantissa);
+        return true;
+    }
+
+    /** 解析一个 "x,y,z" 分段（恰好 3 个非空分量） */
+    static bool ParseVec(const char* Begin, const char* End, FVector3f& Out)
+    {
+        const char* Cursor = Begin;
+        const char* TB = nullptr; const char* TE = nullptr;
+        float C[3];
+        for (int32 i = 0; i < 3; ++i)
+        {
+            if (!NextToken(Cursor, End, ',', TB, TE) || !ParseFloat(TB, TE, C[i])) return false;
+        }
+        if (NextToken(Cursor, End, ',', TB, TE)) return false; // 多余分量
+        Out = FVector3f(C[0], C[1], C[2]);
+        return true;
+    }
+
+    static bool ParseHand(const char*& Cursor, const char* End, FVector3f (&OutJoints)[HPK_NumJoints])
+    {
+        bool bAllOk = true;
+        for (int32 j = 0; j < HPK_NumJoints; ++j)
+        {
+            const char* TB = nullptr; const char* TE = nullptr;
+            if (!NextToken(Cursor, End, '/', TB, TE)) return false;
+            // 与旧实现一致：坏点仍占一个分段位置，但整手视为无效
+            bAllOk &= ParseVec(TB, TE, OutJoints[j]);
+        }
+        return bAllOk;
+    }
+}
+
+bool HPK_ParseText(const uint8* Data, int32 Num, FHandPacketFrame& Out)
+{
+    using namespace HandPacketText;
+    Out.HandMask = 0;
+    Out.Seq = 0;
+    Out.TimestampUs = 0;
+    if (!Data || Num <= 0) return false;
+
+    const char* Cursor = reinterpret_cast<const char*>(Data);
+    const char* End = Cursor + Num;
+    const char* TB = nullptr; const char* TE = nullptr;
+
+    // protocol / version / hand_type
+    if (!NextToken(Cursor, End, '/', TB, TE)) return false;
+    if (!NextToken(Cursor, End, '/', TB, TE)) return false;
+    if (!NextToken(Cursor, End, '/', TB, TE)) return false;
+
+    if (TokenEquals(TB, TE, "left"))
+    {
+        if (ParseHand(Cursor, End, Out.Joints[0])) { Out.HandMask |= EHandPacketMask::Left; }
+    }
+    else if (TokenEquals(TB, TE, "right"))
+    {
+        if (ParseHand(Cursor, End, Out.Joints[1])) { Out.HandMask |= EHandPacketMask::Right; }
+    }
+    else if (TokenEquals(TB, TE, "both"))
+    {
+        const bool bLeftOk = ParseHand(Cursor, End, Out.Joints[0]);
+        const bool bRightOk = ParseHand(Cursor, End, Out.Joints[1]);
+        if (bLeftOk) { Out.HandMask |= EHandPacketMask::Left; }
+        if (bRightOk) { Out.HandMask |= EHandPacketMask::Right; }
+    }
+    return Out.HandMask != 0;
+}
@@ -1,6 +1,8 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Input/InputPlusSubsystem.h"
+#include "Async/Async.h"
+#include "CoreGlobals.h"
 
 void UInputPlusSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -10,19 +12,30 @@ void UInputPlusSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     UDPHandler = NewObject<UUDPHandler>(this);
     if (UDPHandler)
     {
-        UDPHandler->OnDataReceivedDynamic.AddDynamic(this, &UInputPlusSubsystem::OnUDPDataReceivedInternal);
+        // 走原始视图回调：在接收线程按 Magic 区分二进制/文本两种手部包并直接解析
+        UDPHandler->OnRawReceived.AddUObject(this, &UInputPlusSubsystem::OnUDPRawReceivedInternal);
         UDPHandler->StartUDPReceiver(8092);
     }
 
     // 初始化缓存数据
     CachedLeftHandData.Reset();
     CachedRightHandData.Reset();
+
+    // 每帧从最新帧槽取一次数据（无监听组件时也能驱动蓝图事件）
+    PumpTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UInputPlusSubsystem::TickPump), 0.0f);
 }
 
 void UInputPlusSubsystem::Deinitialize()
 {
+    if (PumpTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PumpTickerHandle);
+        PumpTickerHandle = FTSTicker::FDelegateHandle();
+    }
+
     if (UDPHandler)
     {
+        UDPHandler->OnRawReceived.RemoveAll(this);
         UDPHandler->StopUDPReceiver();
         UDPHandler = nullptr;
     }
@@ -35,60 +48,30 @@ void UInputPlusSubsystem::ParseHandLandmarkData(const FString& DataString, FHand
     OutLeftHand.Reset();
     OutRightHand.Reset();
 
-    TArray<FString> Parts;
-    DataString.ParseIntoArray(Parts, TEXT("/"));
-
-    if (Parts.Num() < 3)
+    // 数据格式应该是：protocol/version/hand_type/x1,y1,z1/x2,y2,z2/...
+    // hand_type 为 left / right / both（both 时先左手21点再右手21点）
+    const FTCHARToUTF8 Utf8(*DataString);
+    FHandPacketFrame Frame;
+    if (!HPK_ParseText(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), Frame))
     {
         UE_LOG(LogTemp, Warning, TEXT("Invalid hand data format: %s"), *DataString);
         return;
     }
 
-    // 数据格式应该是：protocol/version/hand_type/x1,y1,z1/x2,y2,z2/...
-    // 对于双手数据，可能的格式：protocol/version/both/left_data.../right_data...
-    // 或者分别接收：protocol/version/left/data... 和 protocol/version/right/data...
+    ApplyHandFrame(Frame);
 
-    FString HandType = Parts[2];
-    
-    if (HandType == TEXT("left"))
+    if (Frame.HandMask & EHandPacketMask::Left)
     {
-        // 处理左手数据
-        OutLeftHand = ParseSingleHandData(Parts, 3);
-        OutLeftHand.bIsValidData = true;
-        CachedLeftHandData = OutLeftHand;
-        
-        UE_LOG(LogTemp, Log, TEXT("Parsed Left Hand Data: %s"), *DataString);
-    }
-    else if (HandType == TEXT("right"))
-    {
-        // 处理右手数据
-        OutRightHand = ParseSingleHandData(Parts, 3);
-        OutRightHand.bIsValidData = true;
-        CachedRightHandData = OutRightHand;
-        
-        UE_LOG(LogTemp, Log, TEXT("Parsed Right Hand Data: %s"), *DataString);
+        OutLeftHand = CachedLeftHandData;
     }
-    else if (HandType == TEXT("both"))
+    if (Frame.HandMask & EHandPacketMask::Right)
     {
-        // 处理双手数据 - 假设格式为：protocol/version/both/left_x1,y1,z1/.../right_x1,y1,z1/...
-        // 需要找到左手和右手数据的分界点
-        int32 LeftHandEndIndex = 3 + HandLandmarkNames.Num(); // 左手数据结束位置
-        
-        if (Parts.Num() >= LeftHandEndIndex + HandLandmarkNames.Num())
-        {
-            OutLeftHand = ParseSingleHandData(Parts, 3);
-            OutLeftHand.bIsValidData = true;
-            CachedLeftHandData = OutLeftHand;
-            
-            OutRightHand = ParseSingleHandData(Parts, LeftHandEndIndex);
-            OutRightHand.bIsValidData = true;
-            CachedRightHandData = OutRightHand;
-            
-            UE_LOG(LogTemp, Log, TEXT("Parsed Both Hands Data: %s"), *DataString);
-        }
+        OutRightHand = CachedRightHandData;
     }
+}
 
-    // 广播双手数据事件
+void UInputPlusSubsystem::BroadcastCachedHands()
+{
     OnHandDataReceivedDynamic.Broadcast(
         CachedLeftHandData.Keys, CachedLeftHandData.Values,
         CachedRightHandData.Keys, CachedRightHandData.Values
@@ -128,7 +111,7 @@ TMap<FString, FVector> UInputPlusSubsystem::ParseSingleHandLandmarkData(const FS
         }
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Parsed Single Hand Landmark Data: %s"), *DataString);
+    UE_LOG(LogTemp, Verbose, TEXT("Parsed Single Hand Landmark Data: %s"), *DataString);
     return LandmarkMap;
 }
 
@@ -138,52 +121,126 @@ void UInputPlusSubsystem::GetLatestHandData(FHandLandmarkData& OutLeftHand, FHan
     OutRightHand = CachedRightHandData;
 }
 
-void UInputPlusSubsystem::OnUDPDataReceivedInternal(const FString& ReceivedData)
+void UInputPlusSubsystem::OnUDPRawReceivedInternal(const uint8* Data, int32 Num, const FIPv4Endpoint& Remote)
 {
-    FHandLandmarkData LeftHandData;
-    FHandLandmarkData RightHandData;
-    
-    ParseHandLandmarkData(ReceivedData, LeftHandData, RightHandData);
-    
-    // UDP数据接收事件广播
-    OnUDPDataReceived.Broadcast(ReceivedData);
+    // 接收线程：RxFrame 预分配，解析过程不产生任何堆分配
+    bool bParsed = false;
+    if (HPK_IsBinary(Data, Num))
+    {
+        bParsed = HPK_Decode(Data, Num, RxFrame);
+        if (!bParsed)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Invalid binary hand packet from %s (bytes=%d)"), *Remote.ToString(), Num);
+        }
+    }
+    else
+    {
+        bParsed = HPK_ParseText(Data, Num, RxFrame);
+        if (!bParsed)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Invalid hand text packet from %s (bytes=%d)"), *Remote.ToString(), Num);
+        }
+    }
+
+    // 发布到每只手的最新帧槽：游戏线程每帧只取最新一帧，积压的中间帧直接覆盖
+    if (bParsed)
+    {
+        for (int32 Hand = 0; Hand < 2; ++Hand)
+        {
+            if (RxFrame.HandMask & (1 << Hand))
+            {
+                LatestHands[Hand].Publish(RxFrame.Seq, RxFrame.TimestampUs, RxFrame.Joints[Hand]);
+            }
+        }
+    }
+
+    // 原始文本仅在蓝图订阅了 OnUDPDataReceived 时才转换并派发（绑定状态由游戏线程镜像到原子标志）
+    if (!bUDPTextBound.load(std::memory_order_relaxed) || HPK_IsBinary(Data, Num))
+    {
+        return;
+    }
+
+    int32 TextLen = Num;
+    while (TextLen > 0 && Data[TextLen - 1] == 0) { --TextLen; }
+    const FUTF8ToTCHAR Conv(reinterpret_cast<const ANSICHAR*>(Data), TextLen);
+    FString Text(Conv.Length(), Conv.Get());
+
+    TWeakObjectPtr<UInputPlusSubsystem> WeakThis(this);
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, Text = MoveTemp(Text)]()
+    {
+        if (UInputPlusSubsystem* Self = WeakThis.Get())
+        {
+            // UDP数据接收事件广播
+            Self->OnUDPDataReceived.Broadcast(Text);
+        }
+    });
 }
 
-FHandLandmarkData UInputPlusSubsystem::ParseSingleHandData(const TArray<FString>& Parts, int32 StartIndex)
+bool UInputPlusSubsystem::TickPump(float DeltaTime)
 {
-    FHandLandmarkData HandData;
-    
-    // 确保有足够的数据点
-    int32 ExpectedEndIndex = StartIndex + HandLandmarkNames.Num();
-    if (Parts.Num() < ExpectedEndIndex)
+    bUDPTextBound.store(OnUDPDataReceived.IsBound(), std::memory_order_relaxed);
+    PumpHandFrames();
+    return true;
+}
+
+int64 UInputPlusSubsystem::PumpHandFrames()
+{
+    check(IsInGameThread());
+    if (LastPumpFrame == GFrameCounter)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Insufficient hand landmark data. Expected %d points, got %d"), 
-               HandLandmarkNames.Num(), Parts.Num() - StartIndex);
-        return HandData;
+        return HandDataSerial;
     }
+    LastPumpFrame = GFrameCounter;
 
-    // 解析从StartIndex开始的手部关键点数据
-    for (int32 i = 0; i < HandLandmarkNames.Num() && (StartIndex + i) < Parts.Num(); ++i)
+    bool bAny = false;
+    FHandJointSample Sample;
+    for (int32 Hand = 0; Hand < 2; ++Hand)
     {
-        TArray<FString> Coords;
-        Parts[StartIndex + i].ParseIntoArray(Coords, TEXT(","));
-        
-        if (Coords.Num() == 3)
+        if (LatestHands[Hand].Consume(Sample))
         {
-            float X = FCString::Atof(*Coords[0]);
-            float Y = FCString::Atof(*Coords[1]);
-            float Z = FCString::Atof(*Coords[2]);
-            
-            HandData.Keys.Add(HandLandmarkNames[i]);
-            HandData.Values.Add(FVector(X, Y, Z));
+            ApplyHandJoints(Hand, Sample.Joints);
+            bAny = true;
         }
-        else
+    }
+
+    if (bAny)
+    {
+        BroadcastCachedHands();
+    }
+    return HandDataSerial;
+}
+
+void UInputPlusSubsystem::GetHandFrameStats(int64& OutPublished, int64& OutDropped) const
+{
+    OutPublished = static_cast<int64>(LatestHands[0].GetPublishedCount() + LatestHands[1].GetPublishedCount());
+    OutDropped = static_cast<int64>(LatestHands[0].GetDroppedCount() + LatestHands[1].GetDroppedCount());
+}
+
+void UInputPlusSubsystem::ApplyHandJoints(int32 Hand, const FVector3f* Joints)
+{
+    FHandLandmarkData& Out = (Hand == 0) ? CachedLeftHandData : CachedRightHandData;
+    if (Out.Keys.Num() != HandLandmarkNames.Num())
+    {
+        Out.Keys = HandLandmarkNames;
+    }
+    Out.Values.SetNumUninitialized(HPK_NumJoints);
+    for (int32 j = 0; j < HPK_NumJoints; ++j)
+    {
+        Out.Values[j] = FVector(Joints[j]);
+    }
+    Out.bIsValidData = true;
+    ++HandDataSerial;
+}
+
+void UInputPlusSubsystem::ApplyHandFrame(const FHandPacketFrame& Frame)
+{
+    for (int32 Hand = 0; Hand < 2; ++Hand)
+    {
+        if (Frame.HandMask & (1 << Hand))
         {
-            UE_LOG(LogTemp, Warning, TEXT("Invalid coordinate format at index %d: %s"), 
-                   StartIndex + i, *Parts[StartIndex + i]);
+            ApplyHandJoints(Hand, Frame.Joints[Hand]);
         }
     }
 
-    HandData.bIsValidData = (HandData.Keys.Num() == HandLandmarkNames.Num());
-    return HandData;
-}
\ No newline at end of file
+    BroadcastCachedHands();
+}
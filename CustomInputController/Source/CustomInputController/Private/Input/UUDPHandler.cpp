@@ -127,33 +127,41 @@ void UUDPHandler::OnUDPMessageReceived(const FArrayReaderPtr& ArrayReaderPtr, co
         return;
     }
 
-    // 先复制原始字节（用于二进制媒体包）
-    TArray<uint8> Raw;
     const int32 DataSize = ArrayReaderPtr->TotalSize();
 
     // 调试：逐包日志（来源与长度）
     UE_LOG(LogTemp, Verbose, TEXT("[UDP] packet from %s, bytes=%d"), *EndPt.ToString(), DataSize);
 
-    if (DataSize > 0)
+    if (DataSize <= 0)
     {
-        Raw.SetNum(DataSize);
-        ArrayReaderPtr->Serialize(Raw.GetData(), DataSize);
+        return;
+    }
 
-        // 广播二进制（C++）
-        if (OnBinaryReceived.IsBound())
-        {
-            OnBinaryReceived.Broadcast(Raw, EndPt);
-        }
+    // 原始视图：直接指向接收缓冲区，不拷贝
+    const uint8* Data = ArrayReaderPtr->GetData();
+    if (OnRawReceived.IsBound())
+    {
+        OnRawReceived.Broadcast(Data, DataSize, EndPt);
     }
 
-    // 兼容旧路径：尝试按UTF-8转字符串
-    FString ReceivedString;
-    if (Raw.Num() > 0)
+    // 仅在有订阅者时复制原始字节（用于二进制媒体包）
+    if (OnBinaryReceived.IsBound())
     {
-        if (Raw.Last() != 0) { Raw.Add(0); }
-        ReceivedString = FString(UTF8_TO_TCHAR(reinterpret_cast<const char*>(Raw.GetData())));
+        TArray<uint8> Raw(Data, DataSize);
+        OnBinaryReceived.Broadcast(Raw, EndPt);
     }
 
+    // 兼容旧路径：仅在有文本订阅者时按UTF-8转字符串并派发到游戏线程
+    if (!OnDataReceived.IsBound() && !OnDataReceivedDynamic.IsBound())
+    {
+        return;
+    }
+
+    int32 TextLen = DataSize;
+    while (TextLen > 0 && Data[TextLen - 1] == 0) { --TextLen; }
+    const FUTF8ToTCHAR Conv(reinterpret_cast<const ANSICHAR*>(Data), TextLen);
+    FString ReceivedString(Conv.Length(), Conv.Get());
+
     AsyncTask(ENamedThreads::GameThread, [this, Msg = MoveTemp(ReceivedString)]()
     {
         if (OnDataReceived.IsBound())
@@ -165,4 +173,4 @@ void UUDPHandler::OnUDPMessageReceived(const FArrayReaderPtr& ArrayReaderPtr, co
             OnDataReceivedDynamic.Broadcast(Msg);
         }
     });
-}
\ No newline at end of file
+}
@@ -10,6 +10,8 @@
 #include "Containers/Ticker.h"
 #include "TimerManager.h" // FTimerHandle
 #include "AudioStreamSettings.h"
+#include "MediaJitterBuffer.h"
+#include "MediaStreamReplay.h"
 #include "AudioStreamHttpWsSubsystem.generated.h"
 
 class UAudioStreamHttpWsComponent;
@@ -68,6 +70,12 @@ public:
     UFUNCTION(BlueprintCallable, Category="AudioStream|Test")
     TArray<uint8> GenerateTestSineWave(int32 SampleRate, int32 Channels, float FrequencyHz, float DurationSeconds);
 
+    // 抓包：记录媒体UDP接收路径的原始包，供 AudioStream.Replay 离线回放压测
+    UFUNCTION(BlueprintCallable, Category="AudioStream|Test")
+    void StartPacketCapture(int32 MaxPackets = 200000);
+    UFUNCTION(BlueprintCallable, Category="AudioStream|Test")
+    bool StopPacketCapture(const FString& FilePath);
+
 protected:
     bool TickSync(float DeltaTime);
     FDelegateHandle TickHandle;
@@ -184,19 +192,19 @@ private:
     TMap<uint16, FServerStreamInfo> ServerStreams;
 
     // 客户端流缓冲
-    struct FPendingAudioFrame { uint32 Seq; uint64 PtsUs; TArray<uint8> Payload; };
     struct FClientVisPoint { uint64 PtsUs; uint8 Id; uint8 Conf; };
     struct FClientStreamState
     {
         int32 SampleRate = 16000;
         int32 Channels = 1;
         bool bHasFormat = false;
-        bool bPreRollReady = false;
-        TArray<FPendingAudioFrame> Frames; // 音频
+        FMediaJitterBuffer Jitter; // 音频
         TArray<FClientVisPoint> VisemePoints; // 嘴型点
     };
     TMap<uint16, FClientStreamState> ClientStreams;
 
+    FMediaPacketCapture PacketCapture; // UDP接收线程写入
+
     FCriticalSection StreamCS; // 保护映射
     FCriticalSection JitterCS; // 保护帧与viseme缓冲
 
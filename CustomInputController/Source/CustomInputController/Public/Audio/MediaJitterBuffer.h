@@ -0,0 +1,39 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+
+/** 待播放的音频帧（按 PTS 排序） */
+struct FMediaPendingAudioFrame
+{
+    uint32 Seq = 0;
+    uint64 PtsUs = 0;
+    TArray<uint8> Payload;
+};
+
+/**
+ * 客户端抖动缓冲：按 PTS 有序缓存音频帧，深度达到预热目标后按服务器时间线出队。
+ * 从 UAudioStreamHttpWsSubsystem 中拆出，供实时接收路径与回放压测（FMediaStreamReplayHarness）共用。
+ * 非线程安全：调用方负责加锁（子系统使用 JitterCS）。
+ */
+struct CUSTOMINPUTCONTROLLER_API FMediaJitterBuffer
+{
+    TArray<FMediaPendingAudioFrame> Frames;
+    bool bPreRollReady = false;
+
+    void Reset()
+    {
+        Frames.Reset();
+        bPreRollReady = false;
+    }
+
+    /** 按 PTS 插入一帧；返回 true 表示本次插入使预热就绪 */
+    bool Insert(uint32 Seq, uint64 PtsUs, const uint8* Payload, int32 PayloadLen, int32 PreRollMs);
+
+    /** 出队 PTS<=ServerNowUs 的帧并追加到 OutFrames；未预热时不出队。返回出队帧数 */
+    int32 DrainDue(double ServerNowUs, TArray<FMediaPendingAudioFrame>& OutFrames);
+
+    /** 当前缓冲深度（最新与最旧帧 PTS 之差，微秒） */
+    int64 GetDepthUs() const
+    {
+        return Frames.Num() >= 2 ? (int64)(Frames.Last().PtsUs - Frames[0].PtsUs) : 0;
+    }
+};
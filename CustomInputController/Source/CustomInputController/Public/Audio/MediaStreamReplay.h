@@ -0,0 +1,130 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * 媒体流抓包/回放压测工具（无音频设备、可在 Linux 上无头运行）。
+ * - FMediaReplayTrace：记录或合成的 UDP 媒体包序列（FMediaPacketHeader + 负载）。
+ * - FMediaPacketCapture：从实时接收路径抓包，保存为回放文件。
+ * - FMediaStreamReplayHarness：按确定性仿真时钟回放包序列，注入丢包/乱序/抖动/时钟漂移，
+ *   经 MSP_ParseHeader -> FMediaJitterBuffer -> UStreamProcSoundWave 的接收路径，
+ *   统计每流端到端延迟、欠载与 CPU 耗时。
+ * 控制台：AudioStream.Replay（参数见 MediaStreamReplay.cpp）。
+ */
+
+/** 单个包：发送端时间（微秒）+ 原始字节 */
+struct FMediaReplayPacket
+{
+    uint64 SendTimeUs = 0;
+    TArray<uint8> Bytes;
+};
+
+/** 合成流参数 */
+struct FMediaReplaySyntheticParams
+{
+    int32 NumStreams = 1;
+    int32 SampleRate = 16000;
+    int32 Channels = 1;
+    int32 FrameDurationMs = 20;
+    int32 LeadMs = 180;           // 服务器给的 PTS 提前量（同 TargetPreRollMs）
+    float DurationSeconds = 10.f;
+    float FrequencyHz = 440.f;
+};
+
+struct CUSTOMINPUTCONTROLLER_API FMediaReplayTrace
+{
+    TArray<FMediaReplayPacket> Packets;
+
+    bool LoadFromFile(const FString& FilePath);
+    bool SaveToFile(const FString& FilePath) const;
+
+    /** 生成与 ServerDistributeAudio 相同封包方式的合成流（含 format 控制包） */
+    static FMediaReplayTrace MakeSynthetic(const FMediaReplaySyntheticParams& Params);
+};
+
+/** 线程安全抓包器：UDP 接收线程 Append，游戏线程 Start/StopAndSave */
+class CUSTOMINPUTCONTROLLER_API FMediaPacketCapture
+{
+public:
+    void Start(int32 InMaxPackets);
+    void Append(uint64 TimeUs, const TArray<uint8>& Data);
+    bool IsActive() const { return bActive.load(std::memory_order_relaxed); }
+    /** 停止并写文件；返回是否写入成功 */
+    bool StopAndSave(const FString& FilePath, int32& OutNumPackets);
+
+private:
+    FCriticalSection CS;
+    FMediaReplayTrace Trace;
+    std::atomic<bool> bActive{false};
+    int32 MaxPackets = 0;
+};
+
+/** 网络损伤注入（同一 Seed 下结果完全可复现） */
+struct FMediaReplayImpairments
+{
+    float LossRate = 0.f;          // 丢包概率 [0,1]（控制包不丢，避免流无法建立）
+    float ReorderRate = 0.f;       // 乱序概率 [0,1]：被选中的包额外延迟 ReorderDelayMs
+    float ReorderDelayMs = 40.f;
+    float BaseDelayMs = 1.f;       // 固定单程延迟
+    float JitterMs = 0.f;          // 均匀分布附加延迟 [0, JitterMs]
+    float ClockDriftPpm = 0.f;     // 接收端时钟相对发送端的偏差（ppm，正数=接收端更快）
+    int32 Seed = 1;
+};
+
+struct FMediaReplayConfig
+{
+    FMediaReplayImpairments Impairments;
+    int32 PreRollMs = 180;         // 抖动缓冲预热目标（同 TargetPreRollMs）
+    int32 TickMs = 10;             // 出队节拍（同子系统 TickSync）
+    int32 RenderBlockFrames = 512; // 每次 OnGeneratePCMAudio 请求的帧数
+    float OffsetLerpAlpha = 0.1f;
+    int32 TailMs = 1000;           // 最后一个包到达后继续仿真的时长
+    bool bUseLoopbackUdp = false;  // 经 127.0.0.1 实际收发一遍，覆盖内核 UDP 路径
+    int32 DefaultSampleRate = 16000;
+    int32 DefaultChannels = 1;
+};
+
+struct FMediaReplayStreamReport
+{
+    uint16 StreamId = 0;
+    int32 SampleRate = 0;
+    int32 Channels = 0;
+    int32 PacketsSent = 0;
+    int32 PacketsLost = 0;
+    int32 PacketsReordered = 0;
+    int32 PacketsReceived = 0;
+    int32 LateFrames = 0;          // 到达时 PTS 已过期的帧
+    int32 FramesPlayed = 0;
+    int32 Underruns = 0;           // 流存活期间的欠载回调数
+    int64 PlayedBytes = 0;
+    float LatencyAvgMs = 0.f;
+    float LatencyP50Ms = 0.f;
+    float LatencyP95Ms = 0.f;
+    float LatencyMaxMs = 0.f;
+    double CpuUs = 0.0;            // 解析+入缓冲+出队+渲染 的累计 CPU 时间
+};
+
+struct CUSTOMINPUTCONTROLLER_API FMediaReplayReport
+{
+    TArray<FMediaReplayStreamReport> Streams;
+    int32 InvalidPackets = 0;
+    int32 LoopbackDropped = 0;
+    double SimulatedSeconds = 0.0;
+    double WallSeconds = 0.0;
+
+    void LogSummary() const;
+    bool SaveCsv(const FString& FilePath) const;
+};
+
+class CUSTOMINPUTCONTROLLER_API FMediaStreamReplayHarness
+{
+public:
+    explicit FMediaStreamReplayHarness(const FMediaReplayConfig& InConfig) : Config(InConfig) {}
+
+    /** 同步运行整段回放（游戏线程，需要 UObject 环境以创建 UStreamProcSoundWave） */
+    FMediaReplayReport Run(const FMediaReplayTrace& Trace);
+
+private:
+    FMediaReplayConfig Config;
+};
@@ -28,8 +28,21 @@ public:
 	UFUNCTION(BlueprintCallable)
 	int64 GetConsumedBytes() const { return ConsumedBytes.load(std::memory_order_relaxed); }
 
+	// 实际送出的PCM字节（不含欠载零填）
 	UFUNCTION(BlueprintCallable)
-	void ResetCounters() { ConsumedBytes.store(0, std::memory_order_relaxed); }
+	int64 GetPlayedBytes() const { return PlayedBytes.load(std::memory_order_relaxed); }
+
+	// 欠载次数：请求未被完全满足的回调数
+	UFUNCTION(BlueprintCallable)
+	int32 GetUnderrunCount() const { return UnderrunCount.load(std::memory_order_relaxed); }
+
+	UFUNCTION(BlueprintCallable)
+	void ResetCounters()
+	{
+		ConsumedBytes.store(0, std::memory_order_relaxed);
+		PlayedBytes.store(0, std::memory_order_relaxed);
+		UnderrunCount.store(0, std::memory_order_relaxed);
+	}
 
 	// 外部入队PCM（任意线程安全）
 	// 非UFUNCTION：指针参数不暴露给UHT/蓝图
@@ -54,6 +67,8 @@ public:
 
 private:
 	std::atomic<int64> ConsumedBytes{0};
+	std::atomic<int64> PlayedBytes{0};
+	std::atomic<int32> UnderrunCount{0};
 	std::atomic<bool> bInGenerate{false};
 
 	// 生产者(音频线程命令) → 渲染线程：无锁队列
@@ -7,6 +7,7 @@
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "Input/InputPlusSubsystem.h"
+#include "HandTracking/UHandRelRotBPLibrary.h"
 #include "HandDataListenerComponent.generated.h"
 
 // 保留旧版本兼容性委托
@@ -43,6 +44,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hand Data")
     void GetLatestHandData(FHandLandmarkData& OutLeftHand, FHandLandmarkData& OutRightHand);
 
+    /**
+     * 获取关节旋转（按关节索引 0-20 的固定数组读取，不依赖下方 TMap）
+     * @param bRelative true=相对旋转（对应 *RotRelativeMap），false=世界旋转（对应 *RotWorldMap）
+     */
+    UFUNCTION(BlueprintPure, Category = "Hand Data")
+    FRotator GetJointRotation(bool bLeft, int32 JointIndex, bool bRelative = true) const;
+
+    /** 是否同时更新下方四个旋转 TMap（兼容旧蓝图；关闭可省去每帧的 Map 写入） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand Data")
+    bool bUpdateRotationMaps = true;
+
     UPROPERTY(BlueprintReadWrite, Category = "Hand Data")
     TMap<int32, FRotator> LeftRotRelativeMap;
     UPROPERTY(BlueprintReadWrite, Category = "Hand Data")
@@ -113,6 +125,9 @@ protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+public:
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 private:
     /**
      * 缓存的 InputPlusSubsystem 引用
@@ -121,19 +136,20 @@ private:
     UInputPlusSubsystem* InputPlusSubsystem;
     
     /**
-     * 处理从 InputPlusSubsystem 接收到的双手数据
+     * 处理 InputPlusSubsystem 缓存中的最新双手数据（每 Tick 最多一次）
      */
-    UFUNCTION()
-    void OnBothHandsDataReceived(const TArray<FString>& LeftHandKeys, const TArray<FVector>& LeftHandValues,
-                               const TArray<FString>& RightHandKeys, const TArray<FVector>& RightHandValues);
+    void ProcessLatestHands(const FHandLandmarkData& LeftHand, const FHandLandmarkData& RightHand);
+
+    /** 上次处理时 InputPlusSubsystem 的缓存序号 */
+    int64 LastHandDataSerial = 0;
 
     /**
-     * 绑定到 InputPlusSubsystem 的委托
+     * 获取 InputPlusSubsystem（改为每 Tick 轮询最新帧，不再绑定委托）
      */
     void BindToInputPlusSubsystem();
 
     /**
-     * 从 InputPlusSubsystem 解绑委托
+     * 释放 InputPlusSubsystem 引用
      */
     void UnbindFromInputPlusSubsystem();
 
@@ -155,14 +171,29 @@ private:
     bool isLeft
     );
 
-    // --- 平滑与过滤内部缓存 ---
-    /** 上一帧左手 21 点 */
-    TArray<FVector> PrevLeftPoints;
-    /** 上一帧右手 21 点 */
-    TArray<FVector> PrevRightPoints;
-    /** 上一帧左、右手掌参考尺寸 */
-    float PrevLeftPalmSize = 0.f;
-    float PrevRightPalmSize = 0.f;
+    /** 固定索引版本：一次计算整只手（UE 坐标系转换后）的相对/世界旋转，已写入的关节在 OutMask 中置位 */
+    static void TransformToRotArrays(
+    const FVector* Points21,
+    bool isLeft,
+    FRotator (&OutRotRelative)[HAND_NumJoints],
+    FRotator (&OutRotParent)[HAND_NumJoints],
+    uint32& OutMask
+    );
+
+    // --- 固定索引旋转结果 [关节索引] ---
+    FRotator LeftRotRelative[HAND_NumJoints];
+    FRotator LeftRotWorld[HAND_NumJoints];
+    FRotator RightRotRelative[HAND_NumJoints];
+    FRotator RightRotWorld[HAND_NumJoints];
+    uint32 LeftRotMask = 0;
+    uint32 RightRotMask = 0;
+
+    // --- 平滑与过滤内部缓存（SoA，见 UHandKinematicsBPLibrary::FilterHandBatch） ---
+    FHandFilterState LeftFilter;
+    FHandFilterState RightFilter;
+
+    /** 由当前属性生成批量过滤参数 */
+    FHandFilterSettings MakeFilterSettings() const;
 
     /** 计算手掌参考尺寸（用于自适应阈值） */
     static float ComputePalmReferenceSize(const TArray<FVector>& Points21);
@@ -174,20 +205,7 @@ private:
                                 float& InOutPrevPalmSize,
                                 TArray<FVector>& OutValues);
 
-    /** 增强版：加入时间/预热/自适应阈值/速度限幅；bIsLeft 仅供将来差异化使用 */
-    bool SmoothAndFilterOneHandEx(const TArray<FString>& Keys,
-                                  const TArray<FVector>& InValues,
-                                  TArray<FVector>& InOutPrevPoints,
-                                  float& InOutPrevPalmSize,
-                                  bool bIsLeft,
-                                  float DeltaTime,
-                                  bool bJustReacquired,
-                                  int32 AcceptedCount,
-                                  TArray<FVector>& OutValues);
-
     // 每只手的运行时状态
-    int32 LeftAcceptedFrames = 0;
-    int32 RightAcceptedFrames = 0;
     double LastLeftTimeSec = 0.0;
     double LastRightTimeSec = 0.0;
     bool bPrevLeftHadRawData = false;
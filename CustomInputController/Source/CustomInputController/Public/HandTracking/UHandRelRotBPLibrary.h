@@ -70,6 +70,67 @@ struct FHandCalibOffsets
     TMap<int32, FRotator> OffsetByJoint; // 存 Rotator，内部会转 Quat 运算
 };
 
+// —— 批量（SoA）接口：整只手一次处理，固定索引输出，不经过 TMap —— //
+
+static constexpr int32 HAND_NumJoints = 21;
+
+/** 21 点 SoA 布局（X/Y/Z 各自连续，便于编译器向量化） */
+struct FHandJointsSoA
+{
+    alignas(16) float X[HAND_NumJoints];
+    alignas(16) float Y[HAND_NumJoints];
+    alignas(16) float Z[HAND_NumJoints];
+
+    void Load(const FVector* P)
+    {
+        for (int32 i = 0; i < HAND_NumJoints; ++i) { X[i] = (float)P[i].X; Y[i] = (float)P[i].Y; Z[i] = (float)P[i].Z; }
+    }
+    void Store(FVector* P) const
+    {
+        for (int32 i = 0; i < HAND_NumJoints; ++i) { P[i] = FVector(X[i], Y[i], Z[i]); }
+    }
+    FVector Get(int32 i) const { return FVector(X[i], Y[i], Z[i]); }
+};
+
+/** 批量过滤参数（与 UHandDataListenerComponent 的过滤属性一一对应） */
+struct FHandFilterSettings
+{
+    bool  bEnableSmoothing = true;
+    float SmoothingAlpha = 0.5f;
+    bool  bEnableOutlierFilter = true;
+    float OutlierJumpScale = 1.5f;
+    float DropFrameBadPointRatio = 0.6f;
+    bool  bDropFrameOnTooManyOutliers = true;
+    int32 WarmupAcceptedFrames = 2;
+    bool  bAdaptiveJumpThreshold = true;
+    float TargetFrameRate = 30.f;
+    float MaxAdaptiveThresholdScale = 4.f;
+    bool  bVelocityClampEnabled = true;
+    float MaxSpeedScalePerSecond = 12.f;
+    bool  bTreatReacquireAsBaseline = true;
+};
+
+/** 批量过滤的每只手状态 */
+struct FHandFilterState
+{
+    FHandJointsSoA Prev;
+    float PrevPalmSize = 0.f;
+    bool  bHasPrev = false;
+    int32 AcceptedFrames = 0;
+
+    void Reset() { PrevPalmSize = 0.f; bHasPrev = false; AcceptedFrames = 0; }
+};
+
+/** 批量相对旋转的帧间连续性状态（FHandRuntimeState 的固定索引版本） */
+struct FHandKinematicsState
+{
+    FVector PrevPalmZ = FVector::ZeroVector;
+    FVector PrevXByChildJoint[HAND_NumJoints];
+    uint32  PrevXValidMask = 0; // 第 j 位表示 PrevXByChildJoint[j] 有效
+
+    void Reset() { PrevPalmZ = FVector::ZeroVector; PrevXValidMask = 0; }
+};
+
 UCLASS()
 class CUSTOMINPUTCONTROLLER_API UHandKinematicsBPLibrary : public UBlueprintFunctionLibrary
 {
@@ -92,6 +153,41 @@ public:
         const FHandLimitsConfig& Limits,
         UPARAM(ref) TMap<int32, FRotator>& OutJointRotMap);
 
+    /**
+     * 同 ComputeHandRelativeRotations_Map，但输出为按关节索引的 21 元数组（未输出的关节为零旋转），避免 TMap 开销
+     */
+    UFUNCTION(BlueprintCallable, Category="HandKinematics")
+    static void ComputeHandRelativeRotations_Array(
+        const TArray<FVector>& Points21,
+        bool bIsRightHand,
+        UPARAM(ref) FHandRuntimeState& InOutState,
+        const FHandLimitsConfig& Limits,
+        UPARAM(ref) TArray<FRotator>& OutJointRot21);
+
+    /**
+     * 批量（C++）：对整只手做离群过滤/速度限幅/指数平滑（SoA 上逐分量处理）
+     * @return 是否采用了新帧（false 表示整帧丢弃，Out 为上一帧结果）
+     */
+    static bool FilterHandBatch(
+        const FHandFilterSettings& Settings,
+        FHandFilterState& InOutState,
+        const FHandJointsSoA& In,
+        float DeltaTime,
+        bool bJustReacquired,
+        FHandJointsSoA& Out);
+
+    /**
+     * 批量（C++）：一次计算 15 个关节的父->子相对旋转（四元数），按关节索引写入 OutRel，
+     * 已写入的关节在 OutValidMask 中置位
+     */
+    static void ComputeHandRelativeRotationsBatch(
+        const FHandJointsSoA& Points,
+        bool bIsRightHand,
+        FHandKinematicsState& InOutState,
+        const FHandLimitsConfig& Limits,
+        FQuat (&OutRel)[HAND_NumJoints],
+        uint32& OutValidMask);
+
     /** 计算腕/手掌整体朝向（可用于 hand_r/hand_l），同样遵循 Z=手背、X=WRIST->MIDDLE_MCP 的投影 */
     UFUNCTION(BlueprintCallable, Category="HandKinematics")
     static FRotator ComputeWristOrientation(
@@ -136,7 +232,7 @@ public:
 private:
     // —— 内部工具 —— //
     static FORCEINLINE FVector NormalizeSafe(const FVector& V);
-    static FVector StablePalmZ(const TArray<FVector>& P, bool bIsRightHand, const FVector* PrevPalmZ);
+    static FVector StablePalmZ(const FVector* P, bool bIsRightHand, const FVector* PrevPalmZ);
     static FQuat   BoneFrameQuat_ZisPalmXisProj(const FVector& A, const FVector& B, const FVector& PalmZ, const FVector* PrevX);
     static FQuat   RelRotParentToChild(const FVector& P, const FVector& J, const FVector& C, const FVector& PalmZ, FVector* OutChildX, const FVector* PrevParentX, const FVector* PrevChildX);
 
@@ -151,6 +247,10 @@ private:
         const TArray<FVector>& Points21, bool bIsRight, FHandRuntimeState& State, const FHandLimitsConfig& Limits,
         TMap<int32, FQuat>& OutQuatMap);
 
+    static void    BuildRelRotations_Fixed(
+        const FVector* P, bool bIsRight, FHandKinematicsState& State, const FHandLimitsConfig& Limits,
+        FQuat* OutRel, uint32& OutValidMask);
+
 
 
 
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+#include "Containers/TripleBuffer.h"
+#include "Input/HandPacketFormat.h"
+#include <atomic>
+
+/** 单只手的一帧关节（固定大小，不含堆分配） */
+struct FHandJointSample
+{
+    uint32 Seq = 0;
+    uint64 TimestampUs = 0;
+    uint64 PublishIndex = 0; // 生产者发布序号（从 1 开始），用于统计被覆盖的中间帧
+    FVector3f Joints[HPK_NumJoints];
+};
+
+/**
+ * 单只手的“最新值”槽：单生产者（UDP 接收线程）/ 单消费者（游戏线程）的无锁三缓冲。
+ * 生产者每包直接覆盖，消费者每帧最多取一次最新帧；两次读取之间被覆盖的帧计入 Dropped，不排队、不补处理。
+ */
+class FHandLatestFrameSlot
+{
+public:
+    /** 生产者：写入并发布一帧 */
+    void Publish(uint32 Seq, uint64 TimestampUs, const FVector3f* Joints)
+    {
+        FHandJointSample& W = Buffer.GetWriteBuffer();
+        W.Seq = Seq;
+        W.TimestampUs = TimestampUs;
+        W.PublishIndex = Published.fetch_add(1, std::memory_order_relaxed) + 1;
+        FMemory::Memcpy(W.Joints, Joints, sizeof(W.Joints));
+        Buffer.SwapWriteBuffers();
+    }
+
+    /** 消费者：有新帧时返回 true 并输出最新帧 */
+    bool Consume(FHandJointSample& Out)
+    {
+        if (!Buffer.IsDirty())
+        {
+            return false;
+        }
+        Buffer.SwapReadBuffers();
+        const FHandJointSample& R = Buffer.Read();
+        if (R.PublishIndex > LastConsumedIndex + 1)
+        {
+            Dropped.fetch_add(R.PublishIndex - LastConsumedIndex - 1, std::memory_order_relaxed);
+        }
+        LastConsumedIndex = R.PublishIndex;
+        Out = R;
+        return true;
+    }
+
+    uint64 GetPublishedCount() const { return Published.load(std::memory_order_relaxed); }
+    uint64 GetDroppedCount() const { return Dropped.load(std::memory_order_relaxed); }
+
+private:
+    TTripleBuffer<FHandJointSample> Buffer;
+    std::atomic<uint64> Published{0};
+    std::atomic<uint64> Dropped{0};
+    uint64 LastConsumedIndex = 0; // 仅消费者访问
+};
@@ -0,0 +1,150 @@
+﻿#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * 手部关键点二进制包（与文本协议 "protocol/version/left|right|both/x,y,z/..." 并存）。
+ * 以 Magic 'H','P' + 不可打印的 Version 字节识别，文本发送端无需改动。
+ *
+ * 布局（小端）：
+ *   FHandPacketHeader（24 字节）
+ *   按 HandMask 位序（先左后右）依次为每只手 NumJoints 个关节 * (x,y,z)
+ *     Encoding=Float32：每分量 float
+ *     Encoding=Int16  ：每分量 int16，真实值 = q * Scale
+ */
+enum class EHandPacketEncoding : uint8
+{
+    Float32 = 0,
+    Int16 = 1
+};
+
+namespace EHandPacketMask
+{
+    static const uint8 Left = 1 << 0;
+    static const uint8 Right = 1 << 1;
+}
+
+static constexpr int32 HPK_NumJoints = 21;
+static constexpr uint8 HPK_Version = 1;
+
+#pragma pack(push,1)
+struct FHandPacketHeader
+{
+    char   Magic[2];       // 'H','P'
+    uint8  Version;        // 1
+    uint8  Encoding;       // EHandPacketEncoding
+    uint8  HandMask;       // EHandPacketMask
+    uint8  NumJoints;      // 21
+    uint16 Flags;          // 保留
+    uint32 Seq;            // 递增序号
+    uint64 TimestampUs;    // 发送端采集时间（微秒）
+    float  Scale;          // Int16 反量化系数
+};
+#pragma pack(pop)
+static_assert(sizeof(FHandPacketHeader)==24, "Hand packet header size mismatch");
+
+/** 解码结果：固定大小，不含堆分配 */
+struct FHandPacketFrame
+{
+    uint32 Seq = 0;
+    uint64 TimestampUs = 0;
+    uint8  HandMask = 0;
+    FVector3f Joints[2][HPK_NumJoints]; // [0]=左手 [1]=右手
+};
+
+inline bool HPK_IsBinary(const uint8* Data, int32 Num)
+{
+    return Data && Num >= (int32)sizeof(FHandPacketHeader) && Data[0] == 'H' && Data[1] == 'P' && Data[2] == HPK_Version;
+}
+
+inline int32 HPK_PayloadBytes(uint8 HandMask, uint8 Encoding, int32 NumJoints)
+{
+    const int32 Hands = ((HandMask & EHandPacketMask::Left) ? 1 : 0) + ((HandMask & EHandPacketMask::Right) ? 1 : 0);
+    const int32 Elem = (Encoding == (uint8)EHandPacketEncoding::Int16) ? 2 : 4;
+    return Hands * NumJoints * 3 * Elem;
+}
+
+inline bool HPK_Decode(const uint8* Data, int32 Num, FHandPacketFrame& Out)
+{
+    if (!HPK_IsBinary(Data, Num)) return false;
+    FHandPacketHeader H;
+    FMemory::Memcpy(&H, Data, sizeof(H));
+    if (H.NumJoints != HPK_NumJoints) return false;
+    if (H.Encoding > (uint8)EHandPacketEncoding::Int16) return false;
+    if ((H.HandMask & (EHandPacketMask::Left | EHandPacketMask::Right)) == 0) return false;
+    if (Num < (int32)sizeof(H) + HPK_PayloadBytes(H.HandMask, H.Encoding, H.NumJoints)) return false;
+
+    Out.Seq = H.Seq;
+    Out.TimestampUs = H.TimestampUs;
+    Out.HandMask = H.HandMask & (EHandPacketMask::Left | EHandPacketMask::Right);
+
+    const uint8* P = Data + sizeof(H);
+    for (int32 Hand = 0; Hand < 2; ++Hand)
+    {
+        if ((Out.HandMask & (1 << Hand)) == 0) continue;
+        if (H.Encoding == (uint8)EHandPacketEncoding::Float32)
+        {
+            FMemory::Memcpy(&Out.Joints[Hand][0], P, HPK_NumJoints * 3 * sizeof(float));
+            P += HPK_NumJoints * 3 * sizeof(float);
+        }
+        else
+        {
+            int16 Q[HPK_NumJoints * 3];
+            FMemory::Memcpy(Q, P, sizeof(Q));
+            P += sizeof(Q);
+            for (int32 j = 0; j < HPK_NumJoints; ++j)
+            {
+                Out.Joints[Hand][j] = FVector3f((float)Q[j*3+0] * H.Scale, (float)Q[j*3+1] * H.Scale, (float)Q[j*3+2] * H.Scale);
+            }
+        }
+    }
+    return true;
+}
+
+/** 编码（发送端/回放工具使用）；Int16 时 Scale 为量化步长，例如 1/16384 覆盖 ±2 */
+inline void HPK_Encode(const FHandPacketFrame& Frame, EHandPacketEncoding Encoding, float Scale, TArray<uint8>& Out)
+{
+    FHandPacketHeader H;
+    H.Magic[0] = 'H'; H.Magic[1] = 'P';
+    H.Version = HPK_Version;
+    H.Encoding = (uint8)Encoding;
+    H.HandMask = Frame.HandMask & (EHandPacketMask::Left | EHandPacketMask::Right);
+    H.NumJoints = (uint8)HPK_NumJoints;
+    H.Flags = 0;
+    H.Seq = Frame.Seq;
+    H.TimestampUs = Frame.TimestampUs;
+    H.Scale = (Encoding == EHandPacketEncoding::Int16) ? FMath::Max(Scale, UE_SMALL_NUMBER) : 1.f;
+
+    Out.SetNumUninitialized(sizeof(H) + HPK_PayloadBytes(H.HandMask, H.Encoding, H.NumJoints));
+    FMemory::Memcpy(Out.GetData(), &H, sizeof(H));
+    uint8* P = Out.GetData() + sizeof(H);
+    for (int32 Hand = 0; Hand < 2; ++Hand)
+    {
+        if ((H.HandMask & (1 << Hand)) == 0) continue;
+        if (Encoding == EHandPacketEncoding::Float32)
+        {
+            FMemory::Memcpy(P, &Frame.Joints[Hand][0], HPK_NumJoints * 3 * sizeof(float));
+            P += HPK_NumJoints * 3 * sizeof(float);
+        }
+        else
+        {
+            int16 Q[HPK_NumJoints * 3];
+            const float Inv = 1.f / H.Scale;
+            for (int32 j = 0; j < HPK_NumJoints; ++j)
+            {
+                const FVector3f& V = Frame.Joints[Hand][j];
+                Q[j*3+0] = (int16)FMath::Clamp(FMath::RoundToInt(V.X * Inv), -32767, 32767);
+                Q[j*3+1] = (int16)FMath::Clamp(FMath::RoundToInt(V.Y * Inv), -32767, 32767);
+                Q[j*3+2] = (int16)FMath::Clamp(FMath::RoundToInt(V.Z * Inv), -32767, 32767);
+            }
+            FMemory::Memcpy(P, Q, sizeof(Q));
+            P += sizeof(Q);
+        }
+    }
+}
+
+/**
+ * 文本协议零分配解析："protocol/version/left|right|both/x,y,z/..."（空段忽略，与 ParseIntoArray 行为一致）。
+ * 直接在原始字节上解析，可在 UDP 接收线程调用；某只手 21 点未全部解析成功则不置该手的 HandMask 位。
+ * 返回是否至少解析出一只手。
+ */
+CUSTOMINPUTCONTROLLER_API bool HPK_ParseText(const uint8* Data, int32 Num, FHandPacketFrame& Out);
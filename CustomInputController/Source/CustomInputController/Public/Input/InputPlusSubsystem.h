@@ -5,6 +5,12 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Input/UUDPHandler.h"
+#include "Input/HandPacketFormat.h"
+#include "Input/HandLatestFrame.h"
+#include "Containers/Ticker.h"
+
+#include <atomic>
+
 #include "InputPlusSubsystem.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSubsystemUDPDataReceived, const FString&, ReceivedData);
@@ -91,6 +97,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hand Landmark")
 	void GetLatestHandData(FHandLandmarkData& OutLeftHand, FHandLandmarkData& OutRightHand);
 
+	/**
+	 * 游戏线程：从每只手的最新帧槽取出新数据并更新缓存/广播。
+	 * 每个引擎帧最多生效一次（重复调用直接返回），由内部 Ticker 与监听组件的 Tick 调用。
+	 * @return 缓存序号（每次有新数据被应用时递增），消费者可据此判断是否需要处理
+	 */
+	int64 PumpHandFrames();
+
+	/** 当前缓存序号（见 PumpHandFrames） */
+	int64 GetHandDataSerial() const { return HandDataSerial; }
+
+	/**
+	 * 最新帧交换统计：接收线程发布的帧数与未被消费即被覆盖的帧数（左右手合计）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hand Landmark")
+	void GetHandFrameStats(int64& OutPublished, int64& OutDropped) const;
+
 	/**
 	 * 双手数据接收事件
 	 */
@@ -125,15 +147,46 @@ private:
 	FHandLandmarkData CachedRightHandData;
 
 	/**
-	 * 处理接收到的UDP数据
+	 * 接收线程解析用的预分配帧（仅接收线程访问）
+	 */
+	FHandPacketFrame RxFrame;
+
+	/**
+	 * 每只手的最新帧槽：接收线程覆盖写入，游戏线程每帧读取一次 [0]=左手 [1]=右手
+	 */
+	FHandLatestFrameSlot LatestHands[2];
+
+	/**
+	 * OnUDPDataReceived 是否有绑定：游戏线程每帧在 TickPump 中更新，接收线程只读此标志而不读动态委托
+	 */
+	std::atomic<bool> bUDPTextBound{false};
+
+	/** PumpHandFrames 状态 */
+	uint64 LastPumpFrame = MAX_uint64;
+	int64 HandDataSerial = 0;
+	FTSTicker::FDelegateHandle PumpTickerHandle;
+
+	bool TickPump(float DeltaTime);
+
+	/**
+	 * 游戏线程：写入一只手的缓存数据（不广播）
+	 */
+	void ApplyHandJoints(int32 Hand, const FVector3f* Joints);
+
+	/**
+	 * UDP 接收线程回调：直接在接收缓冲区上解析二进制/文本手部包，并发布到最新帧槽
+	 */
+	void OnUDPRawReceivedInternal(const uint8* Data, int32 Num, const FIPv4Endpoint& Remote);
+
+	/**
+	 * 游戏线程：应用解析完成的一帧并广播
 	 */
-	UFUNCTION()
-	void OnUDPDataReceivedInternal(const FString& ReceivedData);
+	void ApplyHandFrame(const FHandPacketFrame& Frame);
 
 	/**
-	 * 解析单个手部数据
+	 * 广播当前缓存的双手数据
 	 */
-	FHandLandmarkData ParseSingleHandData(const TArray<FString>& Parts, int32 StartIndex);
+	void BroadcastCachedHands();
 
 	const TArray<FString> HandLandmarkNames = {
 		TEXT("WRIST"),
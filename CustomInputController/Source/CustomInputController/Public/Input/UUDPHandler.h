@@ -13,6 +13,9 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FOnUDPDataReceived, const FString&);
 // 新增：二进制数据回调（带远端地址）
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnUDPBinaryReceived, const TArray<uint8>& /*Data*/, const FIPv4Endpoint& /*Remote*/);
 
+// 原始字节视图回调：在接收线程直接调用，数据指向接收缓冲区，仅在回调期间有效（零拷贝）
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnUDPRawReceived, const uint8* /*Data*/, int32 /*Num*/, const FIPv4Endpoint& /*Remote*/);
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUDPDataReceivedDynamic, const FString&, ReceivedData);
 
 UCLASS(BlueprintType, Blueprintable)
@@ -37,6 +40,8 @@ public:
 	FOnUDPDataReceived OnDataReceived;
 	// 新增：二进制数据委托（仅C++）
 	FOnUDPBinaryReceived OnBinaryReceived;
+	// 原始视图委托（仅C++，接收线程调用，不做任何拷贝；需要保留数据请自行复制）
+	FOnUDPRawReceived OnRawReceived;
 
 	UPROPERTY(BlueprintAssignable, Category = "UDP")
 	FOnUDPDataReceivedDynamic OnDataReceivedDynamic;
@@ -3,15 +3,19 @@
 #include "AnimNode_KawaiiPhysics.h"
 
 #include "AnimationRuntime.h"
+#include "Async/ParallelFor.h"
 #include "KawaiiPhysicsBoneConstraintsDataAsset.h"
 #include "KawaiiPhysicsCustomExternalForce.h"
 #include "KawaiiPhysicsExternalForce.h"
 #include "KawaiiPhysicsLimitsDataAsset.h"
+#include "KawaiiPhysicsSimulateContext.h"
 #include "Animation/AnimInstanceProxy.h"
 #include "Curves/CurveFloat.h"
+#include "Misc/ScopeExit.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "SceneInterface.h"
 #include "PhysicsEngine/PhysicsAsset.h"
+#include "UObject/GarbageCollection.h"
 
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
 #include "PhysicsEngine/SkeletalBodySetup.h"
@@ -30,14 +34,34 @@ TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsDebug(
 TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsDebugLengthRate(
 	TEXT("a.AnimNode.KawaiiPhysics.Debug.LengthRate"), false,
 	TEXT("Turn on visualization debugging for KawaiiPhysics Bone's LengthRate"));
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsUseSolver(
+	TEXT("a.AnimNode.KawaiiPhysics.UseSolver"), true,
+	TEXT("Use the SoA solver for integration and bone length restore (false = per-bone path, for comparison)"));
+TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsParallelIslands(
+	TEXT("a.AnimNode.KawaiiPhysics.ParallelIslands"), true,
+	TEXT("Simulate independent bone islands with ParallelFor (see ParallelSimulationBoneThreshold)"));
 #endif
 
+const TArray<float> XPBDComplianceValues =
+{
+	0.00000000004f, // 0.04 x 10^(-9) (M^2/N) Concrete
+	0.00000000016f, // 0.16 x 10^(-9) (M^2/N) Wood
+	0.000000001f, // 1.0  x 10^(-8) (M^2/N) Leather
+	0.000000002f, // 0.2  x 10^(-7) (M^2/N) Tendon
+	0.0000001f, // 1.0  x 10^(-6) (M^2/N) Rubber
+	0.00002f, // 0.2  x 10^(-3) (M^2/N) Muscle
+	0.0001f, // 1.0  x 10^(-3) (M^2/N) Fat
+};
+
+/** Frequency (1/s) and per-bone offset of the wind gust noise */
+static constexpr float KawaiiPhysicsWindGustFrequency = 1.5f;
+static constexpr float KawaiiPhysicsWindGustBoneOffset = 7.31f;
+
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_InitModifyBones"), STAT_KawaiiPhysics_InitModifyBones, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_Eval"), STAT_KawaiiPhysics_Eval, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SimulatemodifyBones"), STAT_KawaiiPhysics_SimulatemodifyBones, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_Simulate"), STAT_KawaiiPhysics_Simulate, STATGROUP_Anim);
-DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_GetWindVelocity"), STAT_KawaiiPhysics_GetWindVelocity, STATGROUP_Anim);
-DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_WorldCollision"), STAT_KawaiiPhysics_WorldCollision, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SampleWind"), STAT_KawaiiPhysics_SampleWind, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_AdjustByCollision"), STAT_KawaiiPhysics_AdjustByCollision, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_AdjustByBoneConstraint"), STAT_KawaiiPhysics_AdjustByBoneConstraint,
                    STATGROUP_Anim);
@@ -47,6 +71,8 @@ DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_WarmUp"), STAT_KawaiiPhysics_WarmUp, STAT
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_UpdatePhysicsSetting"), STAT_KawaiiPhysics_UpdatePhysicsSetting, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_UpdateCapsuleLimit"), STAT_KawaiiPhysics_UpdateCapsuleLimit, STATGROUP_Anim);
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_UpdateBoxLimit"), STAT_KawaiiPhysics_UpdateBoxLimit, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_UpdateCollisionBroadphase"), STAT_KawaiiPhysics_UpdateCollisionBroadphase,
+                   STATGROUP_Anim);
 
 FAnimNode_KawaiiPhysics::FAnimNode_KawaiiPhysics()
 	: DeltaTime(0)
@@ -71,6 +97,13 @@ void FAnimNode_KawaiiPhysics::Initialize_AnyThread(const FAnimationInitializeCon
 
 	ModifyBones.Empty();
 
+	// Ignored bodies are resolved again for the new bones
+	WorldCollisionQuery.ResolvedNumBones = INDEX_NONE;
+
+	// Contacts of a running latent sweep belong to the previous bone setup
+	LatentWorldCollisionTask = UE::Tasks::FTask();
+	LatentWorldCollision.Reset();
+
 	// For Avoiding Zero Divide in the first frame
 	DeltaTimeOld = 1.0f / TargetFramerate;
 
@@ -220,6 +253,19 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 
 	check(OutBoneTransforms.Num() == 0);
 
+	// Reported to the significance manager in the next PreUpdate
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	ON_SCOPE_EXIT
+	{
+		LastEvaluationCostMs.Store(static_cast<float>(FPlatformTime::ToMilliseconds64(
+			FPlatformTime::Cycles64() - StartCycles)));
+	};
+
+	if (SignificanceTier == EKawaiiPhysicsSignificanceTier::Frozen)
+	{
+		return;
+	}
+
 	if (bResetDynamics)
 	{
 		ModifyBones.Empty(ModifyBones.Num());
@@ -261,6 +307,7 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 	{
 		InitModifyBones(Output, BoneContainer);
 		InitBoneConstraints();
+		InitIslands();
 		PreSkelCompTransform = ComponentTransform;
 	}
 
@@ -284,21 +331,47 @@ void FAnimNode_KawaiiPhysics::EvaluateSkeletalControl_AnyThread(FComponentSpaceP
 	UpdateBoxLimits(BoxLimitsData, Output, BoneContainer, ComponentTransform);
 	UpdatePlanerLimits(PlanarLimits, Output, BoneContainer, ComponentTransform);
 	UpdatePlanerLimits(PlanarLimitsData, Output, BoneContainer, ComponentTransform);
+	UpdateCollisionBroadphase();
 
 	// Update Bone Pose Transform
 	UpdateModifyBonesPoseTransform(Output, BoneContainer);
 
-	// Update SkeletalMeshComponent movement in World Space
-	UpdateSkelCompMove(ComponentTransform);
+	// Lower significance tiers step less often and extrapolate in between
+	const int32 UpdateInterval = SignificanceTier == EKawaiiPhysicsSignificanceTier::Reduced
+		                             ? 2
+		                             : SignificanceTier == EKawaiiPhysicsSignificanceTier::Low
+		                             ? 4
+		                             : 1;
 
-	// Simulate Physics and Apply
-	if (bNeedWarmUp && WarmUpFrames > 0)
+	// Offsets and accumulated time of another path or tier would be replayed (and extrapolated) by the new one
+	const int32 SimulationPath = UpdateInterval * 2 + (bUseFixedTimeStep ? 1 : 0);
+	if (SimulationPath != LastSimulationPath)
 	{
-		WarmUp(Output, BoneContainer, ComponentTransform);
-		bNeedWarmUp = false;
+		LastSimulationPath = SimulationPath;
+		FixedTimeStepAccumulator = 0.0f;
+		FixedStepOffsets.Reset();
+	}
+
+	if (bUseFixedTimeStep || UpdateInterval > 1)
+	{
+		const float StepRate = (bUseFixedTimeStep ? FixedTimeStepRate : TargetFramerate) / UpdateInterval;
+		SimulateFixedTimeStep(Output, BoneContainer, ComponentTransform, OutBoneTransforms, StepRate,
+		                      !bUseFixedTimeStep);
+	}
+	else
+	{
+		// Update SkeletalMeshComponent movement in World Space
+		UpdateSkelCompMove(ComponentTransform);
+
+		// Simulate Physics and Apply
+		if (bNeedWarmUp && WarmUpFrames > 0)
+		{
+			WarmUp(Output, BoneContainer, ComponentTransform);
+			bNeedWarmUp = false;
+		}
+		SimulateModifyBones(Output, ComponentTransform);
+		ApplySimulateResult(Output, BoneContainer, OutBoneTransforms);
 	}
-	SimulateModifyBones(Output, ComponentTransform);
-	ApplySimulateResult(Output, BoneContainer, OutBoneTransforms);
 
 #if ENABLE_ANIM_DEBUG
 
@@ -338,11 +411,8 @@ bool FAnimNode_KawaiiPhysics::IsValidToEvaluate(const USkeleton* Skeleton, const
 
 bool FAnimNode_KawaiiPhysics::HasPreUpdate() const
 {
-#if WITH_EDITOR
+	// Wind is sampled in PreUpdate. bEnableWind can be changed by pin after the node is registered, so always true
 	return true;
-#else
-	return false;
-#endif
 }
 
 void FAnimNode_KawaiiPhysics::PreUpdate(const UAnimInstance* InAnimInstance)
@@ -357,6 +427,87 @@ void FAnimNode_KawaiiPhysics::PreUpdate(const UAnimInstance* InAnimInstance)
 		}
 	}
 #endif
+
+	const USkeletalMeshComponent* SkelComp = InAnimInstance->GetSkelMeshComponent();
+
+	// Quality tier from the significance manager
+	EKawaiiPhysicsSignificanceTier NewTier = EKawaiiPhysicsSignificanceTier::Full;
+	if (bUseSignificance && SkelComp && UKawaiiPhysicsSignificanceSubsystem::IsEnabled())
+	{
+		if (const UWorld* World = SkelComp->GetWorld())
+		{
+			if (UKawaiiPhysicsSignificanceSubsystem* Significance =
+				World->GetSubsystem<UKawaiiPhysicsSignificanceSubsystem>())
+			{
+				NewTier = Significance->UpdateInstance(SkelComp, LastEvaluationCostMs.Load(), SignificanceTier);
+			}
+		}
+	}
+	if (SignificanceTier == EKawaiiPhysicsSignificanceTier::Frozen && NewTier != SignificanceTier)
+	{
+		// Restart from the current pose instead of the state before freezing
+		bResetDynamics = true;
+	}
+	SignificanceTier = NewTier;
+
+	if (bEnableWind && SignificanceTier != EKawaiiPhysicsSignificanceTier::Frozen)
+	{
+		SampleWind(SkelComp);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::SampleWind(const USkeletalMeshComponent* SkelComp)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SampleWind);
+
+	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
+	const FSceneInterface* Scene = World ? World->Scene : nullptr;
+	if (!Scene)
+	{
+		WindVelocity = FVector::ZeroVector;
+		for (FKawaiiPhysicsIsland& Island : Islands)
+		{
+			Island.WindVelocity = FVector::ZeroVector;
+		}
+		return;
+	}
+
+	auto Sample = [Scene](const FVector& Location)
+	{
+		FVector WindDirection = FVector::ZeroVector;
+		float WindSpeed = 0.0f;
+		float WindMinGust = 0.0f;
+		float WindMaxGust = 0.0f;
+		Scene->GetWindParameters_GameThread(Location, WindDirection, WindSpeed, WindMinGust, WindMaxGust);
+		return WindDirection * WindSpeed;
+	};
+
+	// One sample per island at the center of its bones (last simulated locations)
+	const FTransform& ComponentTransform = SkelComp->GetComponentTransform();
+	bool bAllIslandsSampled = Islands.Num() > 0;
+	for (FKawaiiPhysicsIsland& Island : Islands)
+	{
+		FBox Bounds(ForceInit);
+		if (Island.Solver.IsBuiltFor(ModifyBones))
+		{
+			for (const int32 BoneIndex : Island.BoneIndices)
+			{
+				Bounds += ModifyBones[BoneIndex].Location;
+			}
+		}
+		Island.bWindSampled = Bounds.IsValid != 0;
+		if (Island.bWindSampled)
+		{
+			Island.WindVelocity = Sample(ComponentTransform.TransformPosition(Bounds.GetCenter()));
+		}
+		bAllIslandsSampled &= Island.bWindSampled;
+	}
+
+	// Islands that are not built yet use the wind at the component
+	if (!bAllIslandsSampled)
+	{
+		WindVelocity = Sample(ComponentTransform.GetLocation());
+	}
 }
 
 void FAnimNode_KawaiiPhysics::InitializeBoneReferences(const FBoneContainer& RequiredBones)
@@ -398,6 +549,38 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 	const USkeleton* Skeleton = BoneContainer.GetSkeletonAsset();
 	auto& RefSkeleton = Skeleton->GetReferenceSkeleton();
 
+	// The output order is built again for the new bones
+	OutputBoneSlots.Reset();
+
+	// Child lists of the whole skeleton in one pass, instead of a scan of all later bones per added bone
+	const int32 NumRefBones = RefSkeleton.GetNum();
+	RefSkeletonChildOffsets.Reset(NumRefBones + 1);
+	RefSkeletonChildOffsets.AddZeroed(NumRefBones + 1);
+	for (int32 BoneIndex = 1; BoneIndex < NumRefBones; ++BoneIndex)
+	{
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		if (ParentIndex >= 0)
+		{
+			++RefSkeletonChildOffsets[ParentIndex + 1];
+		}
+	}
+	for (int32 BoneIndex = 0; BoneIndex < NumRefBones; ++BoneIndex)
+	{
+		RefSkeletonChildOffsets[BoneIndex + 1] += RefSkeletonChildOffsets[BoneIndex];
+	}
+	RefSkeletonChildren.SetNumUninitialized(RefSkeletonChildOffsets[NumRefBones]);
+	{
+		TArray<int32, TInlineAllocator<256>> NextChild(RefSkeletonChildOffsets.GetData(), NumRefBones);
+		for (int32 BoneIndex = 1; BoneIndex < NumRefBones; ++BoneIndex)
+		{
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			if (ParentIndex >= 0)
+			{
+				RefSkeletonChildren[NextChild[ParentIndex]++] = BoneIndex;
+			}
+		}
+	}
+
 	auto InitRootBone = [&](const FName& RootBoneName, const TArray<FBoneReference>& InExcludeBones)
 	{
 		TArray<FKawaiiPhysicsModifyBone> Bones;
@@ -438,15 +621,29 @@ void FAnimNode_KawaiiPhysics::InitModifyBones(FComponentSpacePoseContext& Output
 			             ? AdditionalRootBone.OverrideExcludeBones
 			             : ExcludeBones);
 	}
+
+	// The first ModifyBone of a name wins, like the linear search it replaces
+	ModifyBoneIndices.Reset();
+	ModifyBoneIndices.Reserve(ModifyBones.Num());
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		if (!ModifyBones[i].bDummy)
+		{
+			ModifyBoneIndices.FindOrAdd(ModifyBones[i].BoneRef.BoneName, i);
+		}
+	}
 }
 
 void FAnimNode_KawaiiPhysics::ApplyLimitsDataAsset(const FBoneContainer& RequiredBones)
 {
-	auto Initialize = [&RequiredBones](auto& Targets)
+	// Only the appended limits need their bones initialized, the others already are
+	auto Append = [&RequiredBones](auto& Targets, const auto& Sources)
 	{
-		for (auto& Target : Targets)
+		const int32 FirstNew = Targets.Num();
+		Targets.Append(Sources);
+		for (int32 i = FirstNew; i < Targets.Num(); ++i)
 		{
-			Target.DrivingBone.Initialize(RequiredBones);
+			Targets[i].DrivingBone.Initialize(RequiredBones);
 		}
 	};
 	auto RemoveAllSourceDataAssets = [](auto& Targets)
@@ -464,15 +661,10 @@ void FAnimNode_KawaiiPhysics::ApplyLimitsDataAsset(const FBoneContainer& Require
 
 	if (LimitsDataAsset)
 	{
-		SphericalLimitsData.Append(LimitsDataAsset->SphericalLimits);
-		CapsuleLimitsData.Append(LimitsDataAsset->CapsuleLimits);
-		BoxLimitsData.Append(LimitsDataAsset->BoxLimits);
-		PlanarLimitsData.Append(LimitsDataAsset->PlanarLimits);
-
-		Initialize(SphericalLimitsData);
-		Initialize(CapsuleLimitsData);
-		Initialize(BoxLimitsData);
-		Initialize(PlanarLimitsData);
+		Append(SphericalLimitsData, LimitsDataAsset->SphericalLimits);
+		Append(CapsuleLimitsData, LimitsDataAsset->CapsuleLimits);
+		Append(BoxLimitsData, LimitsDataAsset->BoxLimits);
+		Append(PlanarLimitsData, LimitsDataAsset->PlanarLimits);
 	}
 }
 
@@ -552,7 +744,7 @@ void FAnimNode_KawaiiPhysics::ApplyBoneConstraintDataAsset(const FBoneContainer&
 	BoneConstraintsData.Empty();
 	if (BoneConstraintsDataAsset)
 	{
-		BoneConstraintsData = BoneConstraintsDataAsset->GenerateBoneConstraints();
+		BoneConstraintsData = *BoneConstraintsDataAsset->GetCompiledBoneConstraints(RequiredBones.GetSkeletonAsset());
 		for (auto& BoneConstraint : BoneConstraintsData)
 		{
 			BoneConstraint.InitializeBone(RequiredBones);
@@ -646,6 +838,13 @@ int32 FAnimNode_KawaiiPhysics::CollectChildBones(const FReferenceSkeleton& RefSk
 	Children.Reset();
 
 	const int32 NumBones = RefSkeleton.GetNum();
+	if (RefSkeletonChildOffsets.Num() == NumBones + 1 && ParentBoneIndex >= 0 && ParentBoneIndex < NumBones)
+	{
+		Children.Append(RefSkeletonChildren.GetData() + RefSkeletonChildOffsets[ParentBoneIndex],
+		                RefSkeletonChildOffsets[ParentBoneIndex + 1] - RefSkeletonChildOffsets[ParentBoneIndex]);
+		return Children.Num();
+	}
+
 	for (int32 ChildIndex = ParentBoneIndex + 1; ChildIndex < NumBones; ChildIndex++)
 	{
 		if (ParentBoneIndex == RefSkeleton.GetParentIndex(ChildIndex))
@@ -885,6 +1084,22 @@ void FAnimNode_KawaiiPhysics::UpdatePlanerLimits(TArray<FPlanarLimit>& Limits, F
 	}
 }
 
+void FAnimNode_KawaiiPhysics::UpdateCollisionBroadphase()
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_UpdateCollisionBroadphase);
+
+	// Same order as the narrowphase : inline limits first, then data asset / physics asset limits
+	CollisionBroadphase.Reset();
+	CollisionBroadphase.AddSphericalLimits(SphericalLimits);
+	CollisionBroadphase.AddSphericalLimits(SphericalLimitsData);
+	CollisionBroadphase.AddCapsuleLimits(CapsuleLimits);
+	CollisionBroadphase.AddCapsuleLimits(CapsuleLimitsData);
+	CollisionBroadphase.AddBoxLimits(BoxLimits);
+	CollisionBroadphase.AddBoxLimits(BoxLimitsData);
+	CollisionBroadphase.AddPlanarLimits(PlanarLimits);
+	CollisionBroadphase.AddPlanarLimits(PlanarLimitsData);
+}
+
 void FAnimNode_KawaiiPhysics::UpdateModifyBonesPoseTransform(FComponentSpacePoseContext& Output,
                                                              const FBoneContainer& BoneContainer)
 {
@@ -924,17 +1139,53 @@ void FAnimNode_KawaiiPhysics::UpdateSkelCompMove(const FTransform& ComponentTran
 }
 
 void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Output,
-                                                  const FTransform& ComponentTransform)
+                                                  const FTransform& ComponentTransform, int32 NumSubSteps)
 {
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SimulatemodifyBones);
 
-	if (DeltaTime <= 0.0f)
+	if (DeltaTime <= 0.0f || NumSubSteps <= 0)
 	{
 		return;
 	}
 
 	const USkeletalMeshComponent* SkelComp = Output.AnimInstanceProxy->GetSkelMeshComponent();
 
+	BeginSimulateModifyBones(SkelComp, NumSubSteps);
+
+	// The pose doesn't change between substeps : bone transforms for the forces are fetched once
+	UpdateExternalForceBoneTransforms(Output);
+
+	if (Islands.Num() == 0 || !Islands[0].Solver.IsBuiltFor(ModifyBones))
+	{
+		InitIslands();
+	}
+
+	bool bUseSolver = true;
+#if ENABLE_ANIM_DEBUG
+	bUseSolver = CVarAnimNodeKawaiiPhysicsUseSolver.GetValueOnAnyThread();
+#endif
+	FKawaiiPhysicsSimulateContext Context{Output, ComponentTransform};
+	InitSimulateContext(Context, SkelComp, bUseSolver);
+
+	if (Context.bWorldCollision)
+	{
+		UpdateWorldCollisionQuery(SkelComp);
+		if (bWorldCollisionOneFrameLatency)
+		{
+			WaitForLatentWorldCollision();
+		}
+	}
+
+	SimulateSubSteps(Context, NumSubSteps);
+
+	if (Context.bWorldCollision && bWorldCollisionOneFrameLatency)
+	{
+		LaunchLatentWorldCollision(Context);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::BeginSimulateModifyBones(const USkeletalMeshComponent* SkelComp, int32 NumSubSteps)
+{
 	// Save Prev/Pose Info , Check SkipSimulate
 	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
 	{
@@ -956,6 +1207,9 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 	}
 
 	// External Force : PreApply
+	// Forces advance their own time in PreApply, so they see the time of all substeps at once
+	const float StepDeltaTime = DeltaTime;
+	DeltaTime = StepDeltaTime * NumSubSteps;
 	// NOTE: if use foreach, you may get issue ( Array has changed during ranged-for iteration )
 	for (int i = 0; i < CustomExternalForces.Num(); ++i)
 	{
@@ -972,434 +1226,931 @@ void FAnimNode_KawaiiPhysics::SimulateModifyBones(FComponentSpacePoseContext& Ou
 			Force.PreApply(*this, SkelComp);
 		}
 	}
+	DeltaTime = StepDeltaTime;
+}
 
-	// Simulate
-	const float Exponent = TargetFramerate * DeltaTime;
-	const FVector GravityCS = ComponentTransform.InverseTransformVector(Gravity);
-	const UWorld* World = SkelComp ? SkelComp->GetWorld() : nullptr;
-	const FSceneInterface* Scene = World ? World->Scene : nullptr;
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+void FAnimNode_KawaiiPhysics::InitSimulateContext(FKawaiiPhysicsSimulateContext& Context,
+                                                  const USkeletalMeshComponent* SkelComp, bool bUseSolver) const
+{
+	Context.SkelComp = SkelComp;
+	Context.World = SkelComp ? SkelComp->GetWorld() : nullptr;
+	Context.GravityCS = Context.ComponentTransform.InverseTransformVector(Gravity);
+	Context.Exponent = TargetFramerate * DeltaTime;
+	Context.PlaneAxis = static_cast<int32>(PlanarConstraint);
+	Context.bUseSolver = bUseSolver;
+	Context.bUseSolverIntegration = Context.bUseSolver && CanUseSolverIntegration();
+
+	// Lower significance tiers skip world collision and cut the constraint iterations
+	Context.bWorldCollision = bAllowWorldCollision && SignificanceTier == EKawaiiPhysicsSignificanceTier::Full;
+	Context.BoneConstraintIterations =
+		SignificanceTier == EKawaiiPhysicsSignificanceTier::Full
+			? BoneConstraintIterationCountAfterCollision
+			: SignificanceTier == EKawaiiPhysicsSignificanceTier::Reduced
+			? FMath::Min(BoneConstraintIterationCountAfterCollision, 1)
+			: 0;
+}
+
+void FAnimNode_KawaiiPhysics::SimulateSubSteps(const FKawaiiPhysicsSimulateContext& Context, int32 NumSubSteps,
+                                               FKawaiiPhysicsStageCycles* StageCycles)
+{
+	// Islands never touch each other's bones. External forces may read any bone and are not thread safe,
+	// so islands only run in parallel while no force is enabled
+	bool bParallel = false;
+#if ENABLE_ANIM_DEBUG
+	if (CVarAnimNodeKawaiiPhysicsParallelIslands.GetValueOnAnyThread())
+#endif
 	{
-		if (Bone.bSkipSimulate)
-		{
-			continue;
-		}
-		Simulate(Bone, Scene, ComponentTransform, GravityCS, Exponent, SkelComp, Output);
+		bParallel = ParallelSimulationBoneThreshold > 0 && Islands.Num() > 1 && CanUseSolverIntegration();
 	}
 
-	// External Force : PostApply
-	for (int i = 0; i < ExternalForces.Num(); ++i)
+	TArray<TArray<int32, TInlineAllocator<8>>, TInlineAllocator<8>> Tasks;
+	if (bParallel)
 	{
-		if (ExternalForces[i].IsValid())
+		// Large islands get a task each, the small ones share one
+		TArray<int32, TInlineAllocator<8>> SmallIslands;
+		for (int32 IslandIndex = 0; IslandIndex < Islands.Num(); ++IslandIndex)
 		{
-			auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
-			Force.PostApply(*this);
+			if (Islands[IslandIndex].BoneIndices.Num() >= ParallelSimulationBoneThreshold)
+			{
+				Tasks.AddDefaulted_GetRef().Add(IslandIndex);
+			}
+			else
+			{
+				SmallIslands.Add(IslandIndex);
+			}
+		}
+		if (SmallIslands.Num() > 0)
+		{
+			Tasks.Add(SmallIslands);
 		}
+		bParallel = Tasks.Num() > 1;
 	}
 
-	// Adjust by collisions
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
+	// Stage timings for the benchmark, parallel islands are counted as integration
+	uint64 Cycles = StageCycles ? FPlatformTime::Cycles64() : 0;
+	auto Lap = [StageCycles, &Cycles](uint64 FKawaiiPhysicsStageCycles::* Stage)
 	{
-		if (Bone.bSkipSimulate)
+		if (StageCycles)
 		{
-			continue;
+			const uint64 Now = FPlatformTime::Cycles64();
+			StageCycles->*Stage += Now - Cycles;
+			Cycles = Now;
 		}
+	};
 
-		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByCollision);
+	// Component movement is split evenly between the substeps
+	const FVector FrameMoveVector = SkelCompMoveVector;
+	const FQuat FrameMoveRotation = SkelCompMoveRotation;
+	if (NumSubSteps > 1)
+	{
+		SkelCompMoveVector = FrameMoveVector / NumSubSteps;
+		SkelCompMoveRotation = FQuat::Slerp(FQuat::Identity, FrameMoveRotation, 1.0f / NumSubSteps);
+	}
 
-		AdjustBySphereCollision(Bone, SphericalLimits);
-		AdjustBySphereCollision(Bone, SphericalLimitsData);
-		AdjustByCapsuleCollision(Bone, CapsuleLimits);
-		AdjustByCapsuleCollision(Bone, CapsuleLimitsData);
-		AdjustByBoxCollision(Bone, BoxLimits);
-		AdjustByBoxCollision(Bone, BoxLimitsData);
-		AdjustByPlanerCollision(Bone, PlanarLimits);
-		AdjustByPlanerCollision(Bone, PlanarLimitsData);
-		if (bAllowWorldCollision)
+	for (int32 SubStep = 0; SubStep < NumSubSteps; ++SubStep)
+	{
+		// Fixed time step output is interpolated from the state before the last substep
+		if (SubStep > 0 && SubStep == NumSubSteps - 1)
 		{
-			AdjustByWorldCollision(Bone, SkelComp);
+			FixedStepPrevOffsets.SetNumUninitialized(ModifyBones.Num());
+			for (int32 i = 0; i < ModifyBones.Num(); ++i)
+			{
+				FixedStepPrevOffsets[i] = ModifyBones[i].Location - ModifyBones[i].PoseLocation;
+			}
 		}
-	}
 
-	// Adjust by Bone Constraints After Collision
-	if (BoneConstraintIterationCountAfterCollision > 0)
-	{
-		for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
+		if (bParallel)
 		{
-			BoneConstraint.Lambda = 0.0f;
+			ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+			{
+				for (const int32 IslandIndex : Tasks[TaskIndex])
+				{
+					FKawaiiPhysicsIsland& Island = Islands[IslandIndex];
+					SimulateIsland(Island, Context);
+					AdjustIslandByCollisions(Island, Context);
+					AdjustIslandByBoneConstraints(Island, Context);
+					AdjustIslandByLimitsAndBoneLength(Island, Context);
+				}
+			});
 		}
-		for (int i = 0; i < BoneConstraintIterationCountAfterCollision; ++i)
+		else
 		{
-			AdjustByBoneConstraints();
+			// Simulate
+			for (FKawaiiPhysicsIsland& Island : Islands)
+			{
+				SimulateIsland(Island, Context);
+			}
 		}
-	}
+		Lap(&FKawaiiPhysicsStageCycles::Integrate);
 
-	// Adjust by Limits ane Bone Length
-	for (FKawaiiPhysicsModifyBone& Bone : ModifyBones)
-	{
-		if (Bone.bSkipSimulate)
+		// External Force : PostApply (one shot forces are removed, so only after the last substep)
+		if (SubStep == NumSubSteps - 1)
 		{
-			continue;
+			for (int i = 0; i < ExternalForces.Num(); ++i)
+			{
+				if (ExternalForces[i].IsValid())
+				{
+					auto& Force = ExternalForces[i].GetMutable<FKawaiiPhysics_ExternalForce>();
+					Force.PostApply(*this);
+				}
+			}
 		}
+		Cycles = StageCycles ? FPlatformTime::Cycles64() : 0;
 
-		auto& ParentBone = ModifyBones[Bone.ParentIndex];
+		if (!bParallel)
+		{
+			// Adjust by collisions
+			for (FKawaiiPhysicsIsland& Island : Islands)
+			{
+				AdjustIslandByCollisions(Island, Context);
+			}
+			Lap(&FKawaiiPhysicsStageCycles::Collision);
 
-		// Adjust by angle limit
-		AdjustByAngleLimit(Bone, ParentBone);
+			// Adjust by Bone Constraints After Collision
+			for (FKawaiiPhysicsIsland& Island : Islands)
+			{
+				AdjustIslandByBoneConstraints(Island, Context);
+			}
+			Lap(&FKawaiiPhysicsStageCycles::BoneConstraint);
 
-		// Adjust by Planar Constraint
-		AdjustByPlanarConstraint(Bone, ParentBone);
+			// Adjust by Limits ane Bone Length
+			for (FKawaiiPhysicsIsland& Island : Islands)
+			{
+				AdjustIslandByLimitsAndBoneLength(Island, Context);
+			}
+			Lap(&FKawaiiPhysicsStageCycles::LimitsAndBoneLength);
+		}
 
-		// Restore Bone Length
-		const float BoneLength = (Bone.PoseLocation - ParentBone.PoseLocation).Size();
-		Bone.Location = (Bone.Location - ParentBone.Location).GetSafeNormal() * BoneLength + ParentBone.Location;
+		// Phase of the per-bone gust noise. PerlinNoise1D repeats every 256
+		WindGustPhase = FMath::Fmod(WindGustPhase + DeltaTime * KawaiiPhysicsWindGustFrequency, 256.0f);
+
+		DeltaTimeOld = DeltaTime;
 	}
 
-	DeltaTimeOld = DeltaTime;
+	SkelCompMoveVector = FrameMoveVector;
+	SkelCompMoveRotation = FrameMoveRotation;
 }
 
-void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FSceneInterface* Scene,
-                                       const FTransform& ComponentTransform, const FVector& GravityCS,
-                                       const float& Exponent, const USkeletalMeshComponent* SkelComp,
-                                       FComponentSpacePoseContext& Output)
+void FAnimNode_KawaiiPhysics::SimulateFixedTimeStep(FComponentSpacePoseContext& Output,
+                                                    const FBoneContainer& BoneContainer,
+                                                    FTransform& ComponentTransform,
+                                                    TArray<FBoneTransform>& OutBoneTransforms,
+                                                    float StepRate, bool bExtrapolate)
 {
-	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
-
-	const FKawaiiPhysicsModifyBone& ParentBone = ModifyBones[Bone.ParentIndex];
-
-	// Move using Velocity( = movement amount in pre frame ) and Damping
-	FVector Velocity = (Bone.Location - Bone.PrevLocation) / DeltaTimeOld;
-	Bone.PrevLocation = Bone.Location;
-	Velocity *= (1.0f - Bone.PhysicsSettings.Damping);
+	const float StepTime = 1.0f / FMath::Max(StepRate, 1.0f);
+	const float FrameDeltaTime = DeltaTime;
 
-	// wind
-	if (bEnableWind && Scene)
+	FixedTimeStepAccumulator += FMath::Max(FrameDeltaTime, 0.0f);
+	int32 NumSubSteps = FMath::FloorToInt32(FixedTimeStepAccumulator / StepTime);
+	if (NumSubSteps > MaxSubSteps)
 	{
-		Velocity += GetWindVelocity(Scene, ComponentTransform, Bone) * TargetFramerate;
+		// Drop the time we can not catch up with
+		NumSubSteps = FMath::Max(MaxSubSteps, 1);
+		FixedTimeStepAccumulator = NumSubSteps * StepTime;
 	}
-	Bone.Location += Velocity * DeltaTime;
-
-	// Follow Translation
-	Bone.Location += SkelCompMoveVector * (1.0f - Bone.PhysicsSettings.WorldDampingLocation);
-
-	// Follow Rotation
-	Bone.Location += (SkelCompMoveRotation.RotateVector(Bone.PrevLocation) - Bone.PrevLocation)
-		* (1.0f - Bone.PhysicsSettings.WorldDampingRotation);
-
-	// Gravity
-	// TODO:Migrate if there are more good method (Currently copying AnimDynamics implementation)
-	Bone.Location += 0.5 * GravityCS * DeltaTime * DeltaTime;
+	FixedTimeStepAccumulator -= NumSubSteps * StepTime;
 
-	// External Force
-	// NOTE: if use foreach, you may get issue ( Array has changed during ranged-for iteration )
-	for (int i = 0; i < CustomExternalForces.Num(); ++i)
+	auto StoreOffsets = [this](TArray<FVector>& Offsets)
 	{
-		if (CustomExternalForces[i] && CustomExternalForces[i]->bIsEnabled)
+		Offsets.SetNumUninitialized(ModifyBones.Num());
+		for (int32 i = 0; i < ModifyBones.Num(); ++i)
 		{
-			FTransform BoneTM = FTransform::Identity;
-			if (Bone.bDummy)
-			{
-				BoneTM = Output.Pose.GetComponentSpaceTransform(
-					ParentBone.BoneRef.GetCompactPoseIndex(Output.Pose.GetPose().GetBoneContainer()));
-			}
-			else
-			{
-				BoneTM = Output.Pose.GetComponentSpaceTransform(
-					Bone.BoneRef.GetCompactPoseIndex(Output.Pose.GetPose().GetBoneContainer()));
-			}
-			CustomExternalForces[i]->Apply(*this, Bone.Index, SkelComp, BoneTM);
+			Offsets[i] = ModifyBones[i].Location - ModifyBones[i].PoseLocation;
 		}
+	};
+	// Also reset by EvaluateSkeletalControl_AnyThread when the tier or the path changes
+	if (FixedStepOffsets.Num() != ModifyBones.Num())
+	{
+		StoreOffsets(FixedStepOffsets);
+		FixedStepPrevOffsets = FixedStepOffsets;
 	}
 
-	for (int i = 0; i < ExternalForces.Num(); ++i)
+	if (NumSubSteps > 0)
 	{
-		if (ExternalForces[i].IsValid())
-		{
-			if (const auto ExForce = ExternalForces[i].GetMutablePtr<FKawaiiPhysics_ExternalForce>();
-				ExForce->bIsEnabled)
-			{
-				if (ExForce->ExternalForceSpace == EExternalForceSpace::BoneSpace)
-				{
-					FTransform BoneTM = FTransform::Identity;
-					if (Bone.bDummy)
-					{
-						BoneTM = Output.Pose.GetComponentSpaceTransform(
-							ParentBone.BoneRef.GetCompactPoseIndex(Output.Pose.GetPose().GetBoneContainer()));
-					}
-					else
-					{
-						BoneTM = Output.Pose.GetComponentSpaceTransform(
-							Bone.BoneRef.GetCompactPoseIndex(Output.Pose.GetPose().GetBoneContainer()));
-					}
+		// Component movement since the last step (frames without a step leave PreSkelCompTransform as is)
+		UpdateSkelCompMove(ComponentTransform);
 
-					ExForce->Apply(Bone, *this, Output, BoneTM);
-				}
-				else
-				{
-					ExForce->Apply(Bone, *this, Output);
-				}
-			}
+		DeltaTime = StepTime;
+		if (bNeedWarmUp && WarmUpFrames > 0)
+		{
+			WarmUp(Output, BoneContainer, ComponentTransform);
+			bNeedWarmUp = false;
 		}
+
+		// SimulateModifyBones overwrites FixedStepPrevOffsets when it runs more than one substep
+		Swap(FixedStepPrevOffsets, FixedStepOffsets);
+		SimulateModifyBones(Output, ComponentTransform, NumSubSteps);
+		StoreOffsets(FixedStepOffsets);
+		DeltaTime = FrameDeltaTime;
 	}
 
-	// // Pull to Pose Location
-	const FVector BaseLocation = ParentBone.Location + (Bone.PoseLocation - ParentBone.PoseLocation);
-	Bone.Location += (BaseLocation - Bone.Location) *
-		(1.0f - FMath::Pow(1.0f - Bone.PhysicsSettings.Stiffness, Exponent));
+	// Apply the pose interpolated between (or extrapolated from) the last two steps, then restore the simulated state
+	const float Alpha = FMath::Clamp(FixedTimeStepAccumulator / StepTime, 0.0f, 1.0f) + (bExtrapolate ? 1.0f : 0.0f);
+	FixedStepSimulatedLocations.SetNumUninitialized(ModifyBones.Num());
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		FixedStepSimulatedLocations[i] = Bone.Location;
+		Bone.Location = Bone.PoseLocation + FMath::Lerp(FixedStepPrevOffsets[i], FixedStepOffsets[i], Alpha);
+	}
+	ApplySimulateResult(Output, BoneContainer, OutBoneTransforms);
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		ModifyBones[i].Location = FixedStepSimulatedLocations[i];
+	}
 }
 
-FVector FAnimNode_KawaiiPhysics::GetWindVelocity(const FSceneInterface* Scene, const FTransform& ComponentTransform,
-                                                 const FKawaiiPhysicsModifyBone& Bone) const
+void FAnimNode_KawaiiPhysics::SimulateIsland(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context)
 {
-	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_GetWindVelocity);
+	Island.bSolverGathered = false;
 
-	FVector WindDirection = FVector::ZeroVector;
-	float WindSpeed = 0.0f;
-	float WindMinGust = 0.0f;
-	float WindMaxGust = 0.0f;
+	// wind : sampled on the game thread in PreUpdate, once per island
+	FVector WindVelocityCS = FVector::ZeroVector;
+	if (bEnableWind)
+	{
+		WindVelocityCS = Context.ComponentTransform.InverseTransformVector(
+			Island.bWindSampled ? Island.WindVelocity : WindVelocity) * WindScale;
+	}
 
-	Scene->GetWindParameters_GameThread(ComponentTransform.TransformPosition(Bone.PoseLocation), WindDirection,
-	                                    WindSpeed, WindMinGust, WindMaxGust);
-	WindDirection = ComponentTransform.Inverse().TransformVector(WindDirection);
-	FVector WindVelocity = WindDirection * WindSpeed * WindScale;
+	if (Context.bUseSolverIntegration)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
 
-	// TODO:Migrate if there are more good method (Currently copying AnimDynamics implementation)
-	WindVelocity *= FMath::FRandRange(0.0f, 2.0f);
+		FKawaiiPhysicsSolver& IslandSolver = Island.Solver;
+		IslandSolver.Gather(ModifyBones, Context.PlaneAxis);
+		Island.bSolverGathered = true;
 
-	return WindVelocity;
-}
+		FKawaiiPhysicsSolverParams Params;
+		Params.DeltaTime = DeltaTime;
+		Params.DeltaTimeOld = DeltaTimeOld;
+		Params.Exponent = Context.Exponent;
+		Params.GravityCS = FVector3f(Context.GravityCS);
+		Params.SkelCompMoveVector = FVector3f(SkelCompMoveVector);
+		Params.SkelCompMoveRotation = FQuat4f(SkelCompMoveRotation);
 
-void FAnimNode_KawaiiPhysics::AdjustByWorldCollision(FKawaiiPhysicsModifyBone& Bone,
-                                                     const USkeletalMeshComponent* OwningComp)
-{
-	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollision);
+		// wind
+		if (!WindVelocityCS.IsZero())
+		{
+			Params.bUseWind = true;
+			for (int32 Slot = 0; Slot < IslandSolver.Num(); ++Slot)
+			{
+				if (IslandSolver.Active[Slot] != 0.0f)
+				{
+					IslandSolver.SetWindVelocity(
+						Slot, GetWindVelocity(WindVelocityCS, IslandSolver.BoneIndices[Slot]) * TargetFramerate);
+				}
+			}
+		}
 
-	if (!OwningComp || Bone.ParentIndex < 0)
-	{
+		IslandSolver.Integrate(Params);
+		IslandSolver.ScatterLocations(ModifyBones, true);
 		return;
 	}
 
-	/** the trace is not done in game thread, so TraceTag does not draw debug traces*/
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(KawaiiCollision));
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_Simulate);
 
-	if (bIgnoreSelfComponent)
+	TArray<int32, TInlineAllocator<64>> SimulatedBoneIndices;
+	for (const int32 BoneIndex : Island.BoneIndices)
 	{
-		Params.AddIgnoredComponent(OwningComp);
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		if (!Bone.bSkipSimulate)
+		{
+			Simulate(Bone, WindVelocityCS, Context.GravityCS);
+			SimulatedBoneIndices.Add(BoneIndex);
+		}
 	}
 
-	// Get collision settings from component	
-	ECollisionChannel TraceChannel = bOverrideCollisionParams
-		                                 ? CollisionChannelSettings.GetObjectType()
-		                                 : OwningComp->GetCollisionObjectType();
-	FCollisionResponseParams ResponseParams = bOverrideCollisionParams
-		                                          ? FCollisionResponseParams(
-			                                          CollisionChannelSettings.GetResponseToChannels())
-		                                          : FCollisionResponseParams(
-			                                          OwningComp->GetCollisionResponseToChannels());
-	auto CompTransform = OwningComp->GetComponentTransform();
-
-	if (const UWorld* World = OwningComp->GetWorld())
-	{
-		if (bIgnoreSelfComponent)
-		{
-			// Do sphere sweep
-			FHitResult Result;
-			bool bHit = World->SweepSingleByChannel(Result, CompTransform.TransformPosition(Bone.PrevLocation),
-			                                        CompTransform.TransformPosition(Bone.Location), FQuat::Identity,
-			                                        TraceChannel,
-			                                        FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params,
-			                                        ResponseParams);
-			if (bHit)
+	// External Force : each force is applied to the whole island at once
+	ApplyExternalForces(SimulatedBoneIndices, Context.SkelComp, Context.Output);
+
+	// Parents first, so every bone is pulled relative to its final parent location
+	for (const int32 BoneIndex : SimulatedBoneIndices)
+	{
+		PullToPose(ModifyBones[BoneIndex], Context.Exponent);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustIslandByCollisions(FKawaiiPhysicsIsland& Island,
+                                                       const FKawaiiPhysicsSimulateContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByCollision);
+
+	const TArray<FKawaiiPhysicsLimitProxy>& Proxies = CollisionBroadphase.Proxies;
+	if (Proxies.Num() > 0)
+	{
+		FKawaiiPhysicsCollisionCandidates& Candidates = Island.CollisionCandidates;
+		CollisionBroadphase.BuildCandidates(ModifyBones, Island.BoneIndices, Candidates);
+
+		for (int32 Chunk = 0; Chunk < Candidates.ChunkBounds.Num(); ++Chunk)
+		{
+			const FBox& ChunkBounds = Candidates.ChunkBounds[Chunk];
+			const int32 CandidateBegin = Candidates.CandidateStarts[Chunk];
+			const int32 CandidateEnd = Candidates.CandidateStarts[Chunk + 1];
+
+			for (int32 i = Candidates.ChunkBoneStarts[Chunk]; i < Candidates.ChunkBoneStarts[Chunk + 1]; ++i)
 			{
-				if (Result.bStartPenetrating)
-				{
-					Bone.Location = CompTransform.InverseTransformPosition(
-						CompTransform.TransformPosition(Bone.Location) + (Result.Normal * Result.PenetrationDepth));
-				}
-				else
+				FKawaiiPhysicsModifyBone& Bone = ModifyBones[Island.BoneIndices[i]];
+				if (Bone.bSkipSimulate)
 				{
-					Bone.Location = CompTransform.InverseTransformPosition(Result.Location);
+					continue;
 				}
-			}
-		}
-		else
-		{
-			// Do sphere sweep and ignore bones later
-			TArray<FHitResult> Results;
-			bool bHit = World->SweepMultiByChannel(Results, CompTransform.TransformPosition(Bone.PrevLocation),
-			                                       CompTransform.TransformPosition(Bone.Location), FQuat::Identity,
-			                                       TraceChannel,
-			                                       FCollisionShape::MakeSphere(Bone.PhysicsSettings.Radius), Params,
-			                                       ResponseParams);
-			if (bHit)
-			{
-				bool IsIgnoreHit;
-				for (const auto& Hit : Results)
+
+				const float Radius = Bone.PhysicsSettings.Radius;
+				for (int32 c = CandidateBegin; c < CandidateEnd; ++c)
 				{
-					if (Hit.bBlockingHit)
+					const int32 ProxyIndex = Candidates.Candidates[c];
+					if (!FKawaiiPhysicsBroadphase::MayTouch(Proxies[ProxyIndex], Bone.Location, Radius))
 					{
-						//should we ignore this hit?
-						IsIgnoreHit = false;
-						if (Hit.Component == OwningComp && Hit.BoneName != NAME_None)
-						{
-							IsIgnoreHit = Hit.BoneName == Bone.BoneRef.BoneName;
-							if (!IsIgnoreHit)
-							{
-								for (auto BoneRef : IgnoreBones)
-								{
-									if (BoneRef.BoneName == Hit.BoneName)
-									{
-										IsIgnoreHit = true;
-										break;
-									}
-								}
-							}
-							if (!IsIgnoreHit)
-							{
-								for (auto BoneNamePrefix : IgnoreBoneNamePrefix)
-								{
-									if (Hit.BoneName.ToString().StartsWith(BoneNamePrefix.ToString()))
-									{
-										IsIgnoreHit = true;
-										break;
-									}
-								}
-							}
-						}
-						//found the blocking hit we shouldn't ignore!
-						if (!IsIgnoreHit)
+						continue;
+					}
+					AdjustByCollisionLimit(Bone, Proxies[ProxyIndex]);
+
+					// Pushed out of the chunk : the candidate list no longer covers this bone, test the rest
+					if (!ChunkBounds.IsInsideOrOn(Bone.Location))
+					{
+						for (int32 Rest = ProxyIndex + 1; Rest < Proxies.Num(); ++Rest)
 						{
-							if (Hit.bStartPenetrating)
+							if (FKawaiiPhysicsBroadphase::MayTouch(Proxies[Rest], Bone.Location, Radius))
 							{
-								Bone.Location = CompTransform.InverseTransformPosition(
-									CompTransform.TransformPosition(Bone.Location) + (Hit.Normal * Hit.
-										PenetrationDepth));
+								AdjustByCollisionLimit(Bone, Proxies[Rest]);
 							}
-							else
-							{
-								Bone.Location = CompTransform.InverseTransformPosition(Hit.Location);
-							}
-							break;
 						}
+						break;
 					}
 				}
 			}
 		}
 	}
+
+	if (Context.bWorldCollision)
+	{
+		AdjustIslandByWorldCollision(Island, Context);
+	}
 }
 
-void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits)
+void FAnimNode_KawaiiPhysics::AdjustIslandByBoneConstraints(FKawaiiPhysicsIsland& Island,
+                                                            const FKawaiiPhysicsSimulateContext& Context)
 {
-	for (auto& Sphere : Limits)
+	if (Context.BoneConstraintIterations <= 0 || Island.ConstraintIndices.Num() == 0)
 	{
-		if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+		return;
+	}
+
+	if (Context.bUseSolver)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByBoneConstraint);
+
+		FKawaiiPhysicsConstraintSolver& ConstraintSolver = Island.ConstraintSolver;
+		ConstraintSolver.Gather(ModifyBones, MergedBoneConstraints, XPBDComplianceValues,
+		                        static_cast<int32>(BoneConstraintGlobalComplianceType));
+		ConstraintSolver.Solve(DeltaTime, Context.BoneConstraintIterations);
+		ConstraintSolver.Scatter(ModifyBones);
+		return;
+	}
+
+	for (const int32 ConstraintIndex : Island.ConstraintIndices)
+	{
+		MergedBoneConstraints[ConstraintIndex].Lambda = 0.0f;
+	}
+	for (int i = 0; i < Context.BoneConstraintIterations; ++i)
+	{
+		AdjustByBoneConstraints(Island.ConstraintIndices);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustIslandByLimitsAndBoneLength(FKawaiiPhysicsIsland& Island,
+                                                                const FKawaiiPhysicsSimulateContext& Context)
+{
+	if (Context.bUseSolver)
+	{
+		FKawaiiPhysicsSolver& IslandSolver = Island.Solver;
+		if (Island.bSolverGathered)
+		{
+			IslandSolver.GatherLocations(ModifyBones);
+		}
+		else
+		{
+			IslandSolver.Gather(ModifyBones, Context.PlaneAxis);
+		}
+		IslandSolver.AdjustByLimitsAndRestoreLength();
+		IslandSolver.ScatterLocations(ModifyBones, false);
+		return;
+	}
+
+	for (const int32 BoneIndex : Island.BoneIndices)
+	{
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		if (Bone.bSkipSimulate)
 		{
 			continue;
 		}
 
-		const float LimitDistance = Bone.PhysicsSettings.Radius + Sphere.Radius;
-		if (Sphere.LimitType == ESphericalLimitType::Outer)
+		auto& ParentBone = ModifyBones[Bone.ParentIndex];
+
+		// Adjust by angle limit
+		AdjustByAngleLimit(Bone, ParentBone);
+
+		// Adjust by Planar Constraint
+		AdjustByPlanarConstraint(Bone, ParentBone);
+
+		// Restore Bone Length
+		const float BoneLength = (Bone.PoseLocation - ParentBone.PoseLocation).Size();
+		Bone.Location = (Bone.Location - ParentBone.Location).GetSafeNormal() * BoneLength + ParentBone.Location;
+	}
+}
+
+void FAnimNode_KawaiiPhysics::Simulate(FKawaiiPhysicsModifyBone& Bone, const FVector& WindVelocityCS,
+                                       const FVector& GravityCS)
+{
+	// Move using Velocity( = movement amount in pre frame ) and Damping
+	FVector Velocity = (Bone.Location - Bone.PrevLocation) / DeltaTimeOld;
+	Bone.PrevLocation = Bone.Location;
+	Velocity *= (1.0f - Bone.PhysicsSettings.Damping);
+
+	// wind
+	if (!WindVelocityCS.IsZero())
+	{
+		Velocity += GetWindVelocity(WindVelocityCS, Bone.Index) * TargetFramerate;
+	}
+	Bone.Location += Velocity * DeltaTime;
+
+	// Follow Translation
+	Bone.Location += SkelCompMoveVector * (1.0f - Bone.PhysicsSettings.WorldDampingLocation);
+
+	// Follow Rotation
+	Bone.Location += (SkelCompMoveRotation.RotateVector(Bone.PrevLocation) - Bone.PrevLocation)
+		* (1.0f - Bone.PhysicsSettings.WorldDampingRotation);
+
+	// Gravity
+	// TODO:Migrate if there are more good method (Currently copying AnimDynamics implementation)
+	Bone.Location += 0.5 * GravityCS * DeltaTime * DeltaTime;
+}
+
+void FAnimNode_KawaiiPhysics::ApplyExternalForces(TConstArrayView<int32> BoneIndices,
+                                                  const USkeletalMeshComponent* SkelComp,
+                                                  FComponentSpacePoseContext& Output)
+{
+	// NOTE: if use foreach, you may get issue ( Array has changed during ranged-for iteration )
+	for (int i = 0; i < CustomExternalForces.Num(); ++i)
+	{
+		if (CustomExternalForces[i] && CustomExternalForces[i]->bIsEnabled)
 		{
-			if ((Bone.Location - Sphere.Location).SizeSquared() > LimitDistance * LimitDistance)
-			{
-				continue;
-			}
-			Bone.Location += (LimitDistance - (Bone.Location - Sphere.Location).Size())
-				* (Bone.Location - Sphere.Location).GetSafeNormal();
+			CustomExternalForces[i]->ApplyBatch(*this, BoneIndices, SkelComp, ExternalForceBoneTransforms);
 		}
-		else
+	}
+
+	for (int i = 0; i < ExternalForces.Num(); ++i)
+	{
+		if (ExternalForces[i].IsValid())
 		{
-			if ((Bone.Location - Sphere.Location).SizeSquared() < LimitDistance * LimitDistance)
+			if (const auto ExForce = ExternalForces[i].GetMutablePtr<FKawaiiPhysics_ExternalForce>();
+				ExForce->bIsEnabled)
 			{
-				continue;
+				ExForce->ApplyBatch(BoneIndices, ExternalForceBoneTransforms, *this, Output);
 			}
-			Bone.Location = Sphere.Location + (Sphere.Radius - Bone.PhysicsSettings.Radius) * (Bone.Location - Sphere.
-				Location).GetSafeNormal();
 		}
 	}
 }
 
-void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FCapsuleLimit>& Limits)
+void FAnimNode_KawaiiPhysics::PullToPose(FKawaiiPhysicsModifyBone& Bone, float Exponent)
 {
-	for (auto& Capsule : Limits)
+	const FKawaiiPhysicsModifyBone& ParentBone = ModifyBones[Bone.ParentIndex];
+
+	// // Pull to Pose Location
+	const FVector BaseLocation = ParentBone.Location + (Bone.PoseLocation - ParentBone.PoseLocation);
+	Bone.Location += (BaseLocation - Bone.Location) *
+		(1.0f - FMath::Pow(1.0f - Bone.PhysicsSettings.Stiffness, Exponent));
+}
+
+void FAnimNode_KawaiiPhysics::UpdateExternalForceBoneTransforms(FComponentSpacePoseContext& Output)
+{
+	bool bNeedBoneTransforms = false;
+	for (const auto& CustomExternalForce : CustomExternalForces)
+	{
+		bNeedBoneTransforms |= CustomExternalForce && CustomExternalForce->bIsEnabled;
+	}
+	for (const auto& ExternalForce : ExternalForces)
+	{
+		const auto ExForce = ExternalForce.GetPtr<FKawaiiPhysics_ExternalForce>();
+		bNeedBoneTransforms |= ExForce && ExForce->bIsEnabled &&
+			ExForce->ExternalForceSpace == EExternalForceSpace::BoneSpace;
+	}
+
+	if (!bNeedBoneTransforms)
 	{
-		if (!Capsule.bEnable || Capsule.Radius <= 0 || Capsule.Length <= 0)
+		ExternalForceBoneTransforms.Reset();
+		return;
+	}
+
+	const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
+	ExternalForceBoneTransforms.SetNumUninitialized(ModifyBones.Num());
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		const FKawaiiPhysicsModifyBone& PoseBone = Bone.bDummy && Bone.ParentIndex >= 0
+			                                           ? ModifyBones[Bone.ParentIndex]
+			                                           : Bone;
+		const FCompactPoseBoneIndex CompactPoseIndex = PoseBone.BoneRef.GetCompactPoseIndex(BoneContainer);
+		ExternalForceBoneTransforms[i] = CompactPoseIndex.IsValid()
+			                                 ? Output.Pose.GetComponentSpaceTransform(CompactPoseIndex)
+			                                 : FTransform::Identity;
+	}
+}
+
+bool FAnimNode_KawaiiPhysics::CanUseSolverIntegration() const
+{
+	for (const auto& CustomExternalForce : CustomExternalForces)
+	{
+		if (CustomExternalForce && CustomExternalForce->bIsEnabled)
 		{
-			continue;
+			return false;
 		}
+	}
+	for (const auto& ExternalForce : ExternalForces)
+	{
+		if (const auto ExForce = ExternalForce.GetPtr<FKawaiiPhysics_ExternalForce>(); ExForce && ExForce->bIsEnabled)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FVector FAnimNode_KawaiiPhysics::GetWindVelocity(const FVector& WindVelocityCS, int32 BoneIndex) const
+{
+	// Smooth gust in [0, 2] (average 1) instead of a random factor per bone and frame.
+	// Bones are offset in the noise so that neighbours do not sway in lockstep
+	const float Noise = FMath::PerlinNoise1D(WindGustPhase + BoneIndex * KawaiiPhysicsWindGustBoneOffset);
+	return WindVelocityCS * (1.0f + FMath::Clamp(Noise, -1.0f, 1.0f));
+}
 
-		FVector StartPoint = Capsule.Location + Capsule.Rotation.GetAxisZ() * Capsule.Length * 0.5f;
-		FVector EndPoint = Capsule.Location + Capsule.Rotation.GetAxisZ() * Capsule.Length * -0.5f;
-		const float DistSquared = FMath::PointDistToSegmentSquared(Bone.Location, StartPoint, EndPoint);
+void FAnimNode_KawaiiPhysics::UpdateWorldCollisionQuery(const USkeletalMeshComponent* OwningComp)
+{
+	FKawaiiPhysicsWorldCollisionQuery& Query = WorldCollisionQuery;
+
+	/** the trace is not done in game thread, so TraceTag does not draw debug traces*/
+	Query.Params = FCollisionQueryParams(SCENE_QUERY_STAT(KawaiiCollision));
+	Query.OwningComp = OwningComp;
+	Query.bIgnoreSelfComponent = bIgnoreSelfComponent;
+	if (!OwningComp)
+	{
+		return;
+	}
+
+	if (bIgnoreSelfComponent)
+	{
+		Query.Params.AddIgnoredComponent(OwningComp);
+	}
+
+	// Get collision settings from component	
+	Query.TraceChannel = bOverrideCollisionParams
+		                     ? CollisionChannelSettings.GetObjectType()
+		                     : OwningComp->GetCollisionObjectType();
+	Query.ResponseParams = bOverrideCollisionParams
+		                       ? FCollisionResponseParams(CollisionChannelSettings.GetResponseToChannels())
+		                       : FCollisionResponseParams(OwningComp->GetCollisionResponseToChannels());
+	Query.CompTransform = OwningComp->GetComponentTransform();
+
+	if (!bIgnoreSelfComponent)
+	{
+		// IgnoreBones / IgnoreBoneNamePrefix can be edited while running, they are few so hashing them is cheap
+		uint32 IgnoreHash = 0;
+		for (const FBoneReference& IgnoreBone : IgnoreBones)
+		{
+			IgnoreHash = HashCombineFast(IgnoreHash, GetTypeHash(IgnoreBone.BoneName));
+		}
+		for (const FName& BoneNamePrefix : IgnoreBoneNamePrefix)
+		{
+			IgnoreHash = HashCombineFast(IgnoreHash, GetTypeHash(BoneNamePrefix));
+		}
 
-		const float LimitDistance = Bone.PhysicsSettings.Radius + Capsule.Radius;
-		if (DistSquared < LimitDistance * LimitDistance)
+		const UPhysicsAsset* PhysicsAsset = OwningComp->GetPhysicsAsset();
+		if (Query.ResolvedNumBones != ModifyBones.Num() || Query.ResolvedPhysicsAsset.Get() != PhysicsAsset ||
+			Query.ResolvedIgnoreHash != IgnoreHash)
 		{
-			FVector ClosestPoint = FMath::ClosestPointOnSegment(Bone.Location, StartPoint, EndPoint);
-			Bone.Location = ClosestPoint + (Bone.Location - ClosestPoint).GetSafeNormal() * LimitDistance;
+			ResolveWorldCollisionIgnoredBodies(PhysicsAsset);
+			Query.ResolvedIgnoreHash = IgnoreHash;
 		}
 	}
 }
 
-void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FBoxLimit>& Limits)
+void FAnimNode_KawaiiPhysics::ResolveWorldCollisionIgnoredBodies(const UPhysicsAsset* PhysicsAsset)
 {
-	for (auto& Box : Limits)
+	FKawaiiPhysicsWorldCollisionQuery& Query = WorldCollisionQuery;
+	Query.ResolvedPhysicsAsset = PhysicsAsset;
+	Query.ResolvedNumBones = ModifyBones.Num();
+	Query.IgnoredBodies.Init(false, PhysicsAsset ? PhysicsAsset->SkeletalBodySetups.Num() : 0);
+	Query.BoneBodyIndices.Init(INDEX_NONE, ModifyBones.Num());
+	if (!PhysicsAsset)
+	{
+		return;
+	}
+
+	TArray<FString, TInlineAllocator<8>> Prefixes;
+	for (const FName& BoneNamePrefix : IgnoreBoneNamePrefix)
 	{
-		FTransform BoxTransform(Box.Rotation, Box.Location);
-		float SphereRadius = Bone.PhysicsSettings.Radius;
+		Prefixes.Add(BoneNamePrefix.ToString());
+	}
 
-		FVector LocalSphereCenter = BoxTransform.InverseTransformPosition(Bone.Location);
-		FBox LocalBox(-Box.Extent, Box.Extent);
-		if (FMath::SphereAABBIntersection(FSphere(LocalSphereCenter, SphereRadius), LocalBox))
+	for (int32 BodyIndex = 0; BodyIndex < PhysicsAsset->SkeletalBodySetups.Num(); ++BodyIndex)
+	{
+		const USkeletalBodySetup* BodySetup = PhysicsAsset->SkeletalBodySetups[BodyIndex];
+		if (!BodySetup)
 		{
-			// Calculate the point of the Box closest to the center of the Sphere
-			FVector ClosestPoint = LocalSphereCenter;
-			ClosestPoint.X = FMath::Clamp(ClosestPoint.X, LocalBox.Min.X, LocalBox.Max.X);
-			ClosestPoint.Y = FMath::Clamp(ClosestPoint.Y, LocalBox.Min.Y, LocalBox.Max.Y);
-			ClosestPoint.Z = FMath::Clamp(ClosestPoint.Z, LocalBox.Min.Z, LocalBox.Max.Z);
+			continue;
+		}
 
-			FVector PushOutVector = LocalSphereCenter - ClosestPoint;
-			float Distance = PushOutVector.Size();
+		const FName BodyBoneName = BodySetup->BoneName;
+		bool bIgnore = IgnoreBones.ContainsByPredicate([&BodyBoneName](const FBoneReference& BoneRef)
+		{
+			return BoneRef.BoneName == BodyBoneName;
+		});
+		if (!bIgnore && Prefixes.Num() > 0)
+		{
+			const FString BodyBoneString = BodyBoneName.ToString();
+			bIgnore = Prefixes.ContainsByPredicate([&BodyBoneString](const FString& Prefix)
+			{
+				return BodyBoneString.StartsWith(Prefix);
+			});
+		}
+		Query.IgnoredBodies[BodyIndex] = bIgnore;
+	}
 
-			// When the bone sphere is completely buried inside the box, forced to push.
-			if (PushOutVector.IsNearlyZero())
+	for (int32 BoneIndex = 0; BoneIndex < ModifyBones.Num(); ++BoneIndex)
+	{
+		Query.BoneBodyIndices[BoneIndex] = PhysicsAsset->FindBodyIndex(ModifyBones[BoneIndex].BoneRef.BoneName);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustIslandByWorldCollision(FKawaiiPhysicsIsland& Island,
+                                                           const FKawaiiPhysicsSimulateContext& Context)
+{
+	if (!Context.SkelComp || !Context.World)
+	{
+		return;
+	}
+
+	const FTransform& CompTransform = WorldCollisionQuery.CompTransform;
+
+	if (bWorldCollisionOneFrameLatency)
+	{
+		// Contacts of the previous step : keep the bones on the front side of each contact plane
+		if (!LatentWorldCollision.IsValid() || LatentWorldCollision->NumBones != ModifyBones.Num() ||
+			!Island.Solver.IsBuiltFor(ModifyBones))
+		{
+			return;
+		}
+		for (const FKawaiiPhysicsWorldContact& Contact : LatentWorldCollision->Contacts)
+		{
+			if (Island.Solver.BoneToSlot[Contact.BoneIndex] == INDEX_NONE)
 			{
-				PushOutVector = LocalSphereCenter;
-				Distance = SphereRadius;
+				continue;
+			}
+			FKawaiiPhysicsModifyBone& Bone = ModifyBones[Contact.BoneIndex];
+			if (Bone.bSkipSimulate)
+			{
+				continue;
 			}
 
-			// push
-			if (Distance <= SphereRadius)
+			const FVector Location = CompTransform.TransformPosition(Bone.Location);
+			const double Distance = FVector::DotProduct(Location - Contact.Location, Contact.Normal);
+			if (Distance < 0.0)
 			{
-				FVector PushOutDirection = PushOutVector.GetSafeNormal();
-				FVector NewLocalSphereCenter = ClosestPoint + PushOutDirection * SphereRadius;
-				Bone.Location = BoxTransform.TransformPosition(NewLocalSphereCenter);
+				Bone.Location = CompTransform.InverseTransformPosition(Location - Contact.Normal * Distance);
 			}
 		}
+		return;
+	}
+
+	FKawaiiPhysicsWorldCollisionBatch& Batch = Island.WorldCollisionBatch;
+	Batch.Reset();
+	for (const int32 BoneIndex : Island.BoneIndices)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		if (!Bone.bSkipSimulate)
+		{
+			Batch.AddSweep(BoneIndex, CompTransform.TransformPosition(Bone.PrevLocation),
+			               CompTransform.TransformPosition(Bone.Location), Bone.PhysicsSettings.Radius);
+		}
+	}
+
+	Batch.Execute(Context.World, WorldCollisionQuery);
+
+	for (const FKawaiiPhysicsWorldContact& Contact : Batch.Contacts)
+	{
+		ModifyBones[Contact.BoneIndex].Location = CompTransform.InverseTransformPosition(Contact.Location);
 	}
 }
 
-void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FPlanarLimit>& Limits)
+void FAnimNode_KawaiiPhysics::WaitForLatentWorldCollision()
 {
-	for (auto& Planar : Limits)
+	if (LatentWorldCollisionTask.IsValid())
+	{
+		LatentWorldCollisionTask.Wait();
+		LatentWorldCollisionTask = UE::Tasks::FTask();
+	}
+}
+
+void FAnimNode_KawaiiPhysics::LaunchLatentWorldCollision(const FKawaiiPhysicsSimulateContext& Context)
+{
+	if (!Context.SkelComp || !Context.World)
 	{
-		if (!Planar.bEnable)
+		return;
+	}
+
+	WaitForLatentWorldCollision();
+	if (!LatentWorldCollision.IsValid())
+	{
+		LatentWorldCollision = MakeShared<FKawaiiPhysicsWorldCollisionBatch, ESPMode::ThreadSafe>();
+	}
+
+	// The task owns a copy of everything it reads, the node may be re-initialized before it finishes
+	FKawaiiPhysicsWorldCollisionBatch& Batch = *LatentWorldCollision;
+	Batch.Reset();
+	Batch.Query = WorldCollisionQuery;
+	Batch.NumBones = ModifyBones.Num();
+
+	const FTransform& CompTransform = WorldCollisionQuery.CompTransform;
+	for (int32 BoneIndex = 0; BoneIndex < ModifyBones.Num(); ++BoneIndex)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		if (!Bone.bSkipSimulate)
 		{
-			continue;
+			Batch.AddSweep(BoneIndex, CompTransform.TransformPosition(Bone.PrevLocation),
+			               CompTransform.TransformPosition(Bone.Location), Bone.PhysicsSettings.Radius);
 		}
+	}
+	if (Batch.Sweeps.Num() == 0)
+	{
+		return;
+	}
 
-		FVector PointOnPlane = FVector::PointPlaneProject(Bone.Location, Planar.Plane);
-		const float DistSquared = (Bone.Location - PointOnPlane).SizeSquared();
+	LatentWorldCollisionTask = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[BatchPtr = LatentWorldCollision, WeakWorld = TWeakObjectPtr<const UWorld>(Context.World)]()
+		{
+			// The world must not be collected while its scene is queried outside of the animation evaluation
+			FGCScopeGuard GCGuard;
+			if (const UWorld* World = WeakWorld.Get())
+			{
+				BatchPtr->Execute(World, BatchPtr->Query);
+			}
+		});
+}
 
-		FVector IntersectionPoint;
-		if (DistSquared < Bone.PhysicsSettings.Radius * Bone.PhysicsSettings.Radius ||
-			FMath::SegmentPlaneIntersection(Bone.Location, Bone.PrevLocation, Planar.Plane, IntersectionPoint))
+void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits)
+{
+	for (auto& Sphere : Limits)
+	{
+		AdjustBySphereCollision(Bone, Sphere);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, const FSphericalLimit& Sphere)
+{
+	if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+	{
+		return;
+	}
+
+	const float LimitDistance = Bone.PhysicsSettings.Radius + Sphere.Radius;
+	if (Sphere.LimitType == ESphericalLimitType::Outer)
+	{
+		if ((Bone.Location - Sphere.Location).SizeSquared() > LimitDistance * LimitDistance)
+		{
+			return;
+		}
+		Bone.Location += (LimitDistance - (Bone.Location - Sphere.Location).Size())
+			* (Bone.Location - Sphere.Location).GetSafeNormal();
+	}
+	else
+	{
+		if ((Bone.Location - Sphere.Location).SizeSquared() < LimitDistance * LimitDistance)
+		{
+			return;
+		}
+		Bone.Location = Sphere.Location + (Sphere.Radius - Bone.PhysicsSettings.Radius) * (Bone.Location - Sphere.
+			Location).GetSafeNormal();
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FCapsuleLimit>& Limits)
+{
+	for (auto& Capsule : Limits)
+	{
+		AdjustByCapsuleCollision(Bone, Capsule);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, const FCapsuleLimit& Capsule)
+{
+	if (!Capsule.bEnable || Capsule.Radius <= 0 || Capsule.Length <= 0)
+	{
+		return;
+	}
+
+	FVector StartPoint = Capsule.Location + Capsule.Rotation.GetAxisZ() * Capsule.Length * 0.5f;
+	FVector EndPoint = Capsule.Location + Capsule.Rotation.GetAxisZ() * Capsule.Length * -0.5f;
+	const float DistSquared = FMath::PointDistToSegmentSquared(Bone.Location, StartPoint, EndPoint);
+
+	const float LimitDistance = Bone.PhysicsSettings.Radius + Capsule.Radius;
+	if (DistSquared < LimitDistance * LimitDistance)
+	{
+		FVector ClosestPoint = FMath::ClosestPointOnSegment(Bone.Location, StartPoint, EndPoint);
+		Bone.Location = ClosestPoint + (Bone.Location - ClosestPoint).GetSafeNormal() * LimitDistance;
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FBoxLimit>& Limits)
+{
+	for (auto& Box : Limits)
+	{
+		AdjustByBoxCollision(Bone, Box);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, const FBoxLimit& Box)
+{
+	FTransform BoxTransform(Box.Rotation, Box.Location);
+	float SphereRadius = Bone.PhysicsSettings.Radius;
+
+	FVector LocalSphereCenter = BoxTransform.InverseTransformPosition(Bone.Location);
+	FBox LocalBox(-Box.Extent, Box.Extent);
+	if (FMath::SphereAABBIntersection(FSphere(LocalSphereCenter, SphereRadius), LocalBox))
+	{
+		// Calculate the point of the Box closest to the center of the Sphere
+		FVector ClosestPoint = LocalSphereCenter;
+		ClosestPoint.X = FMath::Clamp(ClosestPoint.X, LocalBox.Min.X, LocalBox.Max.X);
+		ClosestPoint.Y = FMath::Clamp(ClosestPoint.Y, LocalBox.Min.Y, LocalBox.Max.Y);
+		ClosestPoint.Z = FMath::Clamp(ClosestPoint.Z, LocalBox.Min.Z, LocalBox.Max.Z);
+
+		FVector PushOutVector = LocalSphereCenter - ClosestPoint;
+		float Distance = PushOutVector.Size();
+
+		// When the bone sphere is completely buried inside the box, forced to push.
+		if (PushOutVector.IsNearlyZero())
+		{
+			PushOutVector = LocalSphereCenter;
+			Distance = SphereRadius;
+		}
+
+		// push
+		if (Distance <= SphereRadius)
 		{
-			Bone.Location = PointOnPlane + Planar.Rotation.GetUpVector() * Bone.PhysicsSettings.Radius;
+			FVector PushOutDirection = PushOutVector.GetSafeNormal();
+			FVector NewLocalSphereCenter = ClosestPoint + PushOutDirection * SphereRadius;
+			Bone.Location = BoxTransform.TransformPosition(NewLocalSphereCenter);
 		}
 	}
 }
 
+void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FPlanarLimit>& Limits)
+{
+	for (auto& Planar : Limits)
+	{
+		AdjustByPlanerCollision(Bone, Planar);
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, const FPlanarLimit& Planar)
+{
+	if (!Planar.bEnable)
+	{
+		return;
+	}
+
+	FVector PointOnPlane = FVector::PointPlaneProject(Bone.Location, Planar.Plane);
+	const float DistSquared = (Bone.Location - PointOnPlane).SizeSquared();
+
+	FVector IntersectionPoint;
+	if (DistSquared < Bone.PhysicsSettings.Radius * Bone.PhysicsSettings.Radius ||
+		FMath::SegmentPlaneIntersection(Bone.Location, Bone.PrevLocation, Planar.Plane, IntersectionPoint))
+	{
+		Bone.Location = PointOnPlane + Planar.Rotation.GetUpVector() * Bone.PhysicsSettings.Radius;
+	}
+}
+
+void FAnimNode_KawaiiPhysics::AdjustByCollisionLimit(FKawaiiPhysicsModifyBone& Bone,
+                                                     const FKawaiiPhysicsLimitProxy& Proxy)
+{
+	switch (Proxy.Shape)
+	{
+	case EKawaiiPhysicsLimitShape::Sphere:
+		AdjustBySphereCollision(Bone, *static_cast<const FSphericalLimit*>(Proxy.Limit));
+		break;
+	case EKawaiiPhysicsLimitShape::Capsule:
+		AdjustByCapsuleCollision(Bone, *static_cast<const FCapsuleLimit*>(Proxy.Limit));
+		break;
+	case EKawaiiPhysicsLimitShape::Box:
+		AdjustByBoxCollision(Bone, *static_cast<const FBoxLimit*>(Proxy.Limit));
+		break;
+	case EKawaiiPhysicsLimitShape::Planar:
+		AdjustByPlanerCollision(Bone, *static_cast<const FPlanarLimit*>(Proxy.Limit));
+		break;
+	default: ;
+	}
+}
+
 void FAnimNode_KawaiiPhysics::AdjustByAngleLimit(
 	FKawaiiPhysicsModifyBone& Bone,
 	const FKawaiiPhysicsModifyBone& ParentBone)
@@ -1447,23 +2198,14 @@ void FAnimNode_KawaiiPhysics::AdjustByPlanarConstraint(FKawaiiPhysicsModifyBone&
 	}
 }
 
-const TArray<float> XPBDComplianceValues =
-{
-	0.00000000004f, // 0.04 x 10^(-9) (M^2/N) Concrete
-	0.00000000016f, // 0.16 x 10^(-9) (M^2/N) Wood
-	0.000000001f, // 1.0  x 10^(-8) (M^2/N) Leather
-	0.000000002f, // 0.2  x 10^(-7) (M^2/N) Tendon
-	0.0000001f, // 1.0  x 10^(-6) (M^2/N) Rubber
-	0.00002f, // 0.2  x 10^(-3) (M^2/N) Muscle
-	0.0001f, // 1.0  x 10^(-3) (M^2/N) Fat
-};
-
-void FAnimNode_KawaiiPhysics::AdjustByBoneConstraints()
+void FAnimNode_KawaiiPhysics::AdjustByBoneConstraints(const TArray<int32>& ConstraintIndices)
 {
-	for (FModifyBoneConstraint& BoneConstraint : MergedBoneConstraints)
+	for (const int32 ConstraintIndex : ConstraintIndices)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_AdjustByBoneConstraint);
 
+		FModifyBoneConstraint& BoneConstraint = MergedBoneConstraints[ConstraintIndex];
+
 		if (!BoneConstraint.IsValid())
 		{
 			continue;
@@ -1516,24 +2258,23 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 	MergedBoneConstraints = BoneConstraints;
 	MergedBoneConstraints.Append(BoneConstraintsData);
 
+	// A dummy bone is only added to bones without other children, so it is always the only child
+	auto FindChildDummyBone = [this](int32 ModifyBoneIndex)
+	{
+		const TArray<int32>& ChildIndices = ModifyBones[ModifyBoneIndex].ChildIndices;
+		return ChildIndices.Num() == 1 && ModifyBones[ChildIndices[0]].bDummy ? ChildIndices[0] : INDEX_NONE;
+	};
+
 	TArray<FModifyBoneConstraint> DummyBoneConstraint;
 	for (FModifyBoneConstraint& Constraint : MergedBoneConstraints)
 	{
-		Constraint.ModifyBoneIndex1 =
-			ModifyBones.IndexOfByPredicate([Constraint](const FKawaiiPhysicsModifyBone& ModifyBone)
-			{
-				return ModifyBone.BoneRef == Constraint.Bone1;
-			});
+		Constraint.ModifyBoneIndex1 = FindModifyBoneIndex(Constraint.Bone1);
 		if (Constraint.ModifyBoneIndex1 < 0)
 		{
 			continue;
 		}
 
-		Constraint.ModifyBoneIndex2 =
-			ModifyBones.IndexOfByPredicate([Constraint](const FKawaiiPhysicsModifyBone& ModifyBone)
-			{
-				return ModifyBone.BoneRef == Constraint.Bone2;
-			});
+		Constraint.ModifyBoneIndex2 = FindModifyBoneIndex(Constraint.Bone2);
 		if (Constraint.ModifyBoneIndex2 < 0)
 		{
 			continue;
@@ -1546,24 +2287,14 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 		// DummyBone"s constraint
 		if (bAutoAddChildDummyBoneConstraint)
 		{
-			const int32 ChildDummyBoneIndex1 = ModifyBones[Constraint.ModifyBoneIndex1].ChildIndices.IndexOfByPredicate(
-				[&](int32 Index)
-				{
-					return Index >= 0 && ModifyBones[Index].bDummy == true;
-				});
-			const int32 ChildDummyBoneIndex2 = ModifyBones[Constraint.ModifyBoneIndex2].ChildIndices.IndexOfByPredicate(
-				[&](int32 Index)
-				{
-					return Index >= 0 && ModifyBones[Index].bDummy == true;
-				});
+			const int32 ChildDummyBoneIndex1 = FindChildDummyBone(Constraint.ModifyBoneIndex1);
+			const int32 ChildDummyBoneIndex2 = FindChildDummyBone(Constraint.ModifyBoneIndex2);
 
 			if (ChildDummyBoneIndex1 >= 0 && ChildDummyBoneIndex2 >= 0)
 			{
 				FModifyBoneConstraint NewDummyBoneConstraint;
-				NewDummyBoneConstraint.ModifyBoneIndex1 = ModifyBones[Constraint.ModifyBoneIndex1].ChildIndices[
-					ChildDummyBoneIndex1];
-				NewDummyBoneConstraint.ModifyBoneIndex2 = ModifyBones[Constraint.ModifyBoneIndex2].ChildIndices[
-					ChildDummyBoneIndex2];
+				NewDummyBoneConstraint.ModifyBoneIndex1 = ChildDummyBoneIndex1;
+				NewDummyBoneConstraint.ModifyBoneIndex2 = ChildDummyBoneIndex2;
 				NewDummyBoneConstraint.Length =
 					(ModifyBones[NewDummyBoneConstraint.ModifyBoneIndex1].Location - ModifyBones[NewDummyBoneConstraint.
 						ModifyBoneIndex2].Location).
@@ -1577,20 +2308,118 @@ void FAnimNode_KawaiiPhysics::InitBoneConstraints()
 	MergedBoneConstraints.Append(DummyBoneConstraint);
 }
 
+int32 FAnimNode_KawaiiPhysics::FindModifyBoneIndex(const FBoneReference& BoneRef) const
+{
+	const int32* ModifyBoneIndex = ModifyBoneIndices.Find(BoneRef.BoneName);
+	return ModifyBoneIndex ? *ModifyBoneIndex : INDEX_NONE;
+}
+
+void FAnimNode_KawaiiPhysics::InitIslands()
+{
+	Islands.Reset();
+
+	const int32 NumBones = ModifyBones.Num();
+	if (NumBones == 0)
+	{
+		return;
+	}
+
+	// Every root chain starts as its own island (parents are stored before children)
+	TArray<int32> IslandOfBone;
+	IslandOfBone.SetNumUninitialized(NumBones);
+	TArray<int32> IslandParents;
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const int32 ParentIndex = ModifyBones[i].ParentIndex;
+		IslandOfBone[i] = ParentIndex >= 0 ? IslandOfBone[ParentIndex] : IslandParents.Add(IslandParents.Num());
+	}
+
+	// Join chains connected by bone constraints (union-find)
+	auto FindIsland = [&IslandParents](int32 Island)
+	{
+		while (IslandParents[Island] != Island)
+		{
+			IslandParents[Island] = IslandParents[IslandParents[Island]];
+			Island = IslandParents[Island];
+		}
+		return Island;
+	};
+	auto IsUsedConstraint = [NumBones](const FModifyBoneConstraint& Constraint)
+	{
+		return Constraint.IsValid() &&
+			Constraint.ModifyBoneIndex1 >= 0 && Constraint.ModifyBoneIndex1 < NumBones &&
+			Constraint.ModifyBoneIndex2 >= 0 && Constraint.ModifyBoneIndex2 < NumBones;
+	};
+	for (const FModifyBoneConstraint& Constraint : MergedBoneConstraints)
+	{
+		if (!IsUsedConstraint(Constraint))
+		{
+			continue;
+		}
+		const int32 Island1 = FindIsland(IslandOfBone[Constraint.ModifyBoneIndex1]);
+		const int32 Island2 = FindIsland(IslandOfBone[Constraint.ModifyBoneIndex2]);
+		if (Island1 != Island2)
+		{
+			IslandParents[FMath::Max(Island1, Island2)] = FMath::Min(Island1, Island2);
+		}
+	}
+
+	// Compact, ordered by first bone
+	TArray<int32> IslandRemap;
+	IslandRemap.Init(INDEX_NONE, IslandParents.Num());
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		int32& IslandIndex = IslandRemap[FindIsland(IslandOfBone[i])];
+		if (IslandIndex == INDEX_NONE)
+		{
+			IslandIndex = Islands.AddDefaulted();
+		}
+		IslandOfBone[i] = IslandIndex;
+		Islands[IslandIndex].BoneIndices.Add(i);
+	}
+	for (int32 ConstraintIndex = 0; ConstraintIndex < MergedBoneConstraints.Num(); ++ConstraintIndex)
+	{
+		const FModifyBoneConstraint& Constraint = MergedBoneConstraints[ConstraintIndex];
+		if (IsUsedConstraint(Constraint))
+		{
+			Islands[IslandOfBone[Constraint.ModifyBoneIndex1]].ConstraintIndices.Add(ConstraintIndex);
+		}
+	}
+
+	for (FKawaiiPhysicsIsland& Island : Islands)
+	{
+		Island.Solver.Build(ModifyBones, Island.BoneIndices);
+		Island.ConstraintSolver.Build(MergedBoneConstraints, Island.ConstraintIndices);
+	}
+}
+
 void FAnimNode_KawaiiPhysics::ApplySimulateResult(FComponentSpacePoseContext& Output,
                                                   const FBoneContainer& BoneContainer,
                                                   TArray<FBoneTransform>& OutBoneTransforms)
 {
-	for (int32 i = 0; i < ModifyBones.Num(); ++i)
+	if (OutputBoneSlots.Num() != ModifyBones.Num() || OutputBoneContainerSerial != BoneContainer.GetSerialNumber())
 	{
-		OutBoneTransforms.Add(FBoneTransform(ModifyBones[i].BoneRef.GetCompactPoseIndex(BoneContainer),
-		                                     FTransform(ModifyBones[i].PoseRotation, ModifyBones[i].PoseLocation,
-		                                                ModifyBones[i].PoseScale)));
+		InitOutputBoneOrder(BoneContainer);
 	}
 
+	// Written in final order : already sorted by bone index for FCSPose<PoseType>::LocalBlendCSBoneTransforms
+	OutBoneTransforms.SetNumUninitialized(OutputBoneOrder.Num());
+	for (int32 Slot = 0; Slot < OutputBoneOrder.Num(); ++Slot)
+	{
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[OutputBoneOrder[Slot]];
+		OutBoneTransforms[Slot] = FBoneTransform(OutputCompactPoseIndices[Slot],
+		                                         FTransform(Bone.PoseRotation, Bone.PoseLocation, Bone.PoseScale));
+	}
+
+	const bool bNegativeForwardAxis = BoneForwardAxis == EBoneForwardAxis::X_Negative ||
+		BoneForwardAxis == EBoneForwardAxis::Y_Negative || BoneForwardAxis == EBoneForwardAxis::Z_Negative;
+
+	// sin^2 of the angle between pose and simulated bone direction below which the pose rotation is kept (~0.006 deg)
+	constexpr double KeepPoseRotationThreshold = 1.e-8;
+
 	for (int32 i = 0; i < ModifyBones.Num(); ++i)
 	{
-		FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
 		if (!Bone.HasParent())
 		{
 			continue;
@@ -1598,43 +2427,89 @@ void FAnimNode_KawaiiPhysics::ApplySimulateResult(FComponentSpacePoseContext& Ou
 
 		FKawaiiPhysicsModifyBone& ParentBone = ModifyBones[Bone.ParentIndex];
 
-		if (ParentBone.ChildIndices.Num() <= 1)
-		{
-			if (ParentBone.BoneRef.BoneIndex >= 0)
+		if (ParentBone.ChildIndices.Num() <= 1 && ParentBone.BoneRef.BoneIndex >= 0)
+		{
+			FVector PoseVector = Bone.PoseLocation - ParentBone.PoseLocation;
+			FVector SimulateVector = Bone.Location - ParentBone.Location;
+
+			// Same direction : nothing to rotate, without normalizing either vector
+			const double PoseSizeSquared = PoseVector.SizeSquared();
+			const double SimulateSizeSquared = SimulateVector.SizeSquared();
+			const bool bPoseDegenerate = PoseSizeSquared < UE_SMALL_NUMBER;
+			const bool bSimulateDegenerate = SimulateSizeSquared < UE_SMALL_NUMBER;
+			const double Dot = PoseVector | SimulateVector;
+			const bool bSameDirection = bPoseDegenerate || bSimulateDegenerate
+				                            ? bPoseDegenerate && bSimulateDegenerate
+				                            : Dot > 0.0 && Dot * Dot >= (1.0 - KeepPoseRotationThreshold) *
+				                            PoseSizeSquared * SimulateSizeSquared;
+			if (bSameDirection)
 			{
-				FVector PoseVector = Bone.PoseLocation - ParentBone.PoseLocation;
-				FVector SimulateVector = Bone.Location - ParentBone.Location;
-
-				if (PoseVector.GetSafeNormal() == SimulateVector.GetSafeNormal())
-				{
-					continue;
-				}
+				// As before the output order was precomputed : the bone keeps its pose transform
+				continue;
+			}
 
-				if (BoneForwardAxis == EBoneForwardAxis::X_Negative || BoneForwardAxis == EBoneForwardAxis::Y_Negative
-					|| BoneForwardAxis == EBoneForwardAxis::Z_Negative)
+			// A single zero length direction has no rotation to find, the pose rotation is kept
+			if (!bPoseDegenerate && !bSimulateDegenerate)
+			{
+				if (bNegativeForwardAxis)
 				{
 					PoseVector *= -1;
 					SimulateVector *= -1;
 				}
 
-				FQuat SimulateRotation = FQuat::FindBetweenVectors(PoseVector, SimulateVector) * ParentBone.
+				const FQuat SimulateRotation = FQuat::FindBetweenVectors(PoseVector, SimulateVector) * ParentBone.
 					PoseRotation;
-				OutBoneTransforms[Bone.ParentIndex].Transform.SetRotation(SimulateRotation);
+				if (const int32 ParentSlot = OutputBoneSlots[Bone.ParentIndex]; ParentSlot != INDEX_NONE)
+				{
+					OutBoneTransforms[ParentSlot].Transform.SetRotation(SimulateRotation);
+				}
 				ParentBone.PrevRotation = SimulateRotation;
 			}
 		}
 
-		if (Bone.BoneRef.BoneIndex >= 0 && !Bone.bDummy)
+		if (const int32 Slot = OutputBoneSlots[i]; Slot != INDEX_NONE)
 		{
-			OutBoneTransforms[i].Transform.SetLocation(Bone.Location);
+			OutBoneTransforms[Slot].Transform.SetLocation(Bone.Location);
 		}
 	}
+}
 
-	OutBoneTransforms.RemoveAll([](const FBoneTransform& BoneTransform)
+void FAnimNode_KawaiiPhysics::InitOutputBoneOrder(const FBoneContainer& BoneContainer)
+{
+	OutputBoneContainerSerial = BoneContainer.GetSerialNumber();
+
+	// (compact pose index, ModifyBones index) : a bone referenced twice keeps its ModifyBones order
+	TArray<TPair<int32, int32>> Entries;
+	for (int32 i = 0; i < ModifyBones.Num(); ++i)
 	{
-		return BoneTransform.BoneIndex < 0;
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[i];
+		if (Bone.bDummy || Bone.BoneRef.BoneIndex < 0)
+		{
+			continue;
+		}
+
+		const FCompactPoseBoneIndex CompactPoseIndex = Bone.BoneRef.GetCompactPoseIndex(BoneContainer);
+		if (CompactPoseIndex.IsValid())
+		{
+			Entries.Emplace(CompactPoseIndex.GetInt(), i);
+		}
+	}
+	Entries.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
 	});
 
-	// for check in FCSPose<PoseType>::LocalBlendCSBoneTransforms
-	OutBoneTransforms.Sort(FCompareBoneTransformIndex());
+	OutputBoneOrder.Reset(Entries.Num());
+	OutputCompactPoseIndices.Reset(Entries.Num());
+	for (const TPair<int32, int32>& Entry : Entries)
+	{
+		OutputBoneOrder.Add(Entry.Value);
+		OutputCompactPoseIndices.Add(FCompactPoseBoneIndex(Entry.Key));
+	}
+
+	OutputBoneSlots.Init(INDEX_NONE, ModifyBones.Num());
+	for (int32 Slot = 0; Slot < OutputBoneOrder.Num(); ++Slot)
+	{
+		OutputBoneSlots[OutputBoneOrder[Slot]] = Slot;
+	}
 }
@@ -0,0 +1,216 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsBenchmark.h"
+
+#include "AnimNode_KawaiiPhysics.h"
+#include "KawaiiPhysics.h"
+#include "KawaiiPhysicsExternalForce.h"
+#include "KawaiiPhysicsSimulateContext.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace KawaiiPhysicsBenchmark
+{
+	/** Length of every synthetic bone and distance between two chains */
+	constexpr float BoneLength = 10.0f;
+	constexpr float ChainSpacing = 4.0f;
+
+	/** Bone locations are hashed at this resolution, so the hash doesn't depend on the last bits of a double */
+	constexpr double HashResolution = 1000.0;
+
+	FName GetBoneName(int32 BoneIndex)
+	{
+		return FName(TEXT("KawaiiBenchmarkBone"), BoneIndex + 1);
+	}
+
+#if !UE_BUILD_SHIPPING
+	void RunCommand(const TArray<FString>& Args)
+	{
+		auto IntArg = [&Args](int32 Index, int32 Default)
+		{
+			return Args.IsValidIndex(Index) ? FCString::Atoi(*Args[Index]) : Default;
+		};
+
+		FKawaiiPhysicsBenchmarkSettings Settings;
+		Settings.NumChains = IntArg(0, Settings.NumChains);
+		Settings.BonesPerChain = IntArg(1, Settings.BonesPerChain);
+		Settings.NumLimits = IntArg(2, Settings.NumLimits);
+		Settings.NumSteps = IntArg(3, Settings.NumSteps);
+		Settings.bExternalForce = IntArg(4, Settings.bExternalForce) != 0;
+		Settings.bUseSolver = IntArg(5, Settings.bUseSolver) != 0;
+
+		const FKawaiiPhysicsBenchmarkResult Result = FKawaiiPhysicsBenchmark::Run(Settings);
+
+		UE_LOG(LogKawaiiPhysics, Display,
+		       TEXT("KawaiiPhysics Benchmark : %d bones, %d islands, %d constraints, %d limits, %d steps, force %d, solver %d"),
+		       Result.NumBones, Result.NumIslands, Result.NumConstraints, Settings.NumLimits, Settings.NumSteps,
+		       Settings.bExternalForce, Settings.bUseSolver);
+		UE_LOG(LogKawaiiPhysics, Display,
+		       TEXT("  Total %.3f ms (%.4f ms/step) : Broadphase %.3f, Integrate %.3f, Collision %.3f, BoneConstraint %.3f, LimitsAndBoneLength %.3f"),
+		       Result.TotalMs, Result.TotalMs / FMath::Max(Settings.NumSteps, 1), Result.BroadphaseMs,
+		       Result.IntegrateMs, Result.CollisionMs, Result.BoneConstraintMs, Result.LimitsAndBoneLengthMs);
+		UE_LOG(LogKawaiiPhysics, Display, TEXT("  Hash %08x"), Result.Hash);
+
+		if (Args.IsValidIndex(6))
+		{
+			const uint32 ExpectedHash = FParse::HexNumber(*Args[6]);
+			if (ExpectedHash != Result.Hash)
+			{
+				UE_LOG(LogKawaiiPhysics, Error, TEXT("KawaiiPhysics Benchmark : hash %08x does not match expected %08x"),
+				       Result.Hash, ExpectedHash);
+			}
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("a.AnimNode.KawaiiPhysics.Benchmark"),
+		TEXT("Simulates synthetic chains without a mesh or world, logs per stage timings and a hash of the result. ")
+		TEXT("Args : [Chains=16] [BonesPerChain=16] [Limits=8] [Steps=300] [Forces=0] [UseSolver=1] [ExpectedHash]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunCommand));
+#endif
+}
+
+FKawaiiPhysicsBenchmarkResult FKawaiiPhysicsBenchmark::Run(const FKawaiiPhysicsBenchmarkSettings& Settings)
+{
+	using namespace KawaiiPhysicsBenchmark;
+
+	FKawaiiPhysicsBenchmarkResult Result;
+
+	const int32 NumChains = FMath::Max(Settings.NumChains, 1);
+	const int32 BonesPerChain = FMath::Max(Settings.BonesPerChain, 2);
+	const float StepDeltaTime = Settings.DeltaTime > 0.0f ? Settings.DeltaTime : 1.0f / 60.0f;
+
+	FAnimNode_KawaiiPhysics Node;
+	Node.DeltaTime = StepDeltaTime;
+	Node.DeltaTimeOld = StepDeltaTime;
+	Node.Gravity = FVector(0.0f, 0.0f, -980.0f);
+
+	// Chains hang along -Z side by side along Y, the first bone of each chain is its animated root
+	Node.ModifyBones.Reserve(NumChains * BonesPerChain);
+	for (int32 Chain = 0; Chain < NumChains; ++Chain)
+	{
+		for (int32 i = 0; i < BonesPerChain; ++i)
+		{
+			const int32 Index = Node.ModifyBones.Num();
+			FKawaiiPhysicsModifyBone& Bone = Node.ModifyBones.AddDefaulted_GetRef();
+			Bone.BoneRef.BoneName = GetBoneName(Index);
+			Bone.BoneRef.BoneIndex = Index;
+			Bone.Index = Index;
+			Bone.ParentIndex = i > 0 ? Index - 1 : INDEX_NONE;
+			Bone.PoseLocation = FVector(0.0f, Chain * ChainSpacing, -i * BoneLength);
+			Bone.Location = Bone.PoseLocation;
+			Bone.PrevLocation = Bone.PoseLocation;
+			Bone.LengthFromRoot = i * BoneLength;
+			Bone.LengthRateFromRoot = static_cast<float>(i) / (BonesPerChain - 1);
+			if (Bone.ParentIndex >= 0)
+			{
+				Node.ModifyBones[Bone.ParentIndex].ChildIndices.Add(Index);
+			}
+			Node.ModifyBoneIndices.Add(Bone.BoneRef.BoneName, Index);
+		}
+	}
+	Node.UpdatePhysicsSettingsOfModifyBones();
+
+	// Ladder of constraints between neighbouring chains
+	if (Settings.bBoneConstraints)
+	{
+		for (int32 Chain = 1; Chain < NumChains; ++Chain)
+		{
+			for (int32 i = 1; i < BonesPerChain; ++i)
+			{
+				FModifyBoneConstraint& Constraint = Node.BoneConstraints.AddDefaulted_GetRef();
+				Constraint.Bone1.BoneName = GetBoneName((Chain - 1) * BonesPerChain + i);
+				Constraint.Bone2.BoneName = GetBoneName(Chain * BonesPerChain + i);
+			}
+		}
+	}
+	Node.InitBoneConstraints();
+	Node.InitIslands();
+
+	// Limits are spread diagonally over the chains, slightly in front of them
+	for (int32 LimitIndex = 0; LimitIndex < Settings.NumLimits; ++LimitIndex)
+	{
+		const float Alpha = (LimitIndex + 0.5f) / Settings.NumLimits;
+		const FVector Location(3.0f, Alpha * (NumChains - 1) * ChainSpacing, -Alpha * (BonesPerChain - 1) * BoneLength);
+		if (LimitIndex % 2 == 0)
+		{
+			FSphericalLimit& Sphere = Node.SphericalLimits.AddDefaulted_GetRef();
+			Sphere.Location = Location;
+			Sphere.Radius = 8.0f;
+		}
+		else
+		{
+			FCapsuleLimit& Capsule = Node.CapsuleLimits.AddDefaulted_GetRef();
+			Capsule.Location = Location;
+			Capsule.Rotation = FQuat(FVector::XAxisVector, UE_HALF_PI);
+			Capsule.Radius = 4.0f;
+			Capsule.Length = 20.0f;
+		}
+	}
+
+	// Forces need a component for PreApply, a transient one without a world is enough
+	TStrongObjectPtr<USkeletalMeshComponent> SkelComp;
+	if (Settings.bExternalForce)
+	{
+		SkelComp.Reset(NewObject<USkeletalMeshComponent>(GetTransientPackage()));
+
+		FInstancedStruct& ForceStruct = Node.ExternalForces.AddDefaulted_GetRef();
+		ForceStruct.InitializeAs<FKawaiiPhysics_ExternalForce_Basic>();
+		FKawaiiPhysics_ExternalForce_Basic& Force = ForceStruct.GetMutable<FKawaiiPhysics_ExternalForce_Basic>();
+		Force.ExternalForceSpace = EExternalForceSpace::ComponentSpace;
+		Force.ForceDir = FVector(50.0f, 0.0f, 0.0f);
+		Force.Interval = 0.5f;
+	}
+
+	// The pose is never read : there is no skeleton, and the Basic force doesn't use it
+	FComponentSpacePoseContext PoseContext(nullptr);
+	const FTransform ComponentTransform = FTransform::Identity;
+
+	uint64 BroadphaseCycles = 0;
+	FKawaiiPhysicsStageCycles StageCycles;
+
+	for (int32 Step = 0; Step < Settings.NumSteps; ++Step)
+	{
+		// Deterministic component motion : a sway along X and a slow turn around Z
+		const float Time = Step * StepDeltaTime;
+		Node.SkelCompMoveVector = FVector(FMath::Sin(Time * 4.0f) * 2.0f, 0.0f, 0.0f);
+		Node.SkelCompMoveRotation = FQuat(FVector::ZAxisVector, FMath::Sin(Time * 2.5f) * 0.02f);
+
+		const uint64 BroadphaseStart = FPlatformTime::Cycles64();
+		Node.UpdateCollisionBroadphase();
+		BroadphaseCycles += FPlatformTime::Cycles64() - BroadphaseStart;
+
+		// Same passes as SimulateModifyBones, without the pose and world collision steps
+		Node.BeginSimulateModifyBones(SkelComp.Get(), 1);
+		FKawaiiPhysicsSimulateContext Context{PoseContext, ComponentTransform};
+		Node.InitSimulateContext(Context, SkelComp.Get(), Settings.bUseSolver);
+		Node.SimulateSubSteps(Context, 1, &StageCycles);
+	}
+
+	Result.BroadphaseMs = FPlatformTime::ToMilliseconds64(BroadphaseCycles);
+	Result.IntegrateMs = FPlatformTime::ToMilliseconds64(StageCycles.Integrate);
+	Result.CollisionMs = FPlatformTime::ToMilliseconds64(StageCycles.Collision);
+	Result.BoneConstraintMs = FPlatformTime::ToMilliseconds64(StageCycles.BoneConstraint);
+	Result.LimitsAndBoneLengthMs = FPlatformTime::ToMilliseconds64(StageCycles.LimitsAndBoneLength);
+	Result.TotalMs = Result.BroadphaseMs + Result.IntegrateMs + Result.CollisionMs + Result.BoneConstraintMs +
+		Result.LimitsAndBoneLengthMs;
+
+	for (const FKawaiiPhysicsModifyBone& Bone : Node.ModifyBones)
+	{
+		const int64 Quantized[3] = {
+			FMath::RoundToInt64(Bone.Location.X * HashResolution),
+			FMath::RoundToInt64(Bone.Location.Y * HashResolution),
+			FMath::RoundToInt64(Bone.Location.Z * HashResolution)
+		};
+		Result.Hash = FCrc::MemCrc32(Quantized, sizeof(Quantized), Result.Hash);
+	}
+	Result.NumBones = Node.ModifyBones.Num();
+	Result.NumIslands = Node.Islands.Num();
+	Result.NumConstraints = Node.MergedBoneConstraints.Num();
+
+	return Result;
+}
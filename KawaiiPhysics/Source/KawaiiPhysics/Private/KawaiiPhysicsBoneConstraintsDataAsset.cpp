@@ -5,6 +5,7 @@
 
 #include "KawaiiPhysics.h"
 #include "Internationalization/Regex.h"
+#include "Misc/ScopeLock.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -44,7 +45,7 @@ void FModifyBoneConstraintData::Update(const FModifyBoneConstraint& BoneConstrai
 	ComplianceType = BoneConstraint.ComplianceType;
 }
 
-TArray<FModifyBoneConstraint> UKawaiiPhysicsBoneConstraintsDataAsset::GenerateBoneConstraints()
+TArray<FModifyBoneConstraint> UKawaiiPhysicsBoneConstraintsDataAsset::GenerateBoneConstraints() const
 {
 	TArray<FModifyBoneConstraint> BoneConstraints;
 
@@ -62,6 +63,39 @@ TArray<FModifyBoneConstraint> UKawaiiPhysicsBoneConstraintsDataAsset::GenerateBo
 	return BoneConstraints;
 }
 
+TSharedRef<const TArray<FModifyBoneConstraint>, ESPMode::ThreadSafe>
+UKawaiiPhysicsBoneConstraintsDataAsset::GetCompiledBoneConstraints(const USkeleton* Skeleton) const
+{
+	FScopeLock Lock(&CompiledBoneConstraintsLock);
+
+	const TObjectKey<USkeleton> SkeletonKey(Skeleton);
+	if (const TSharedRef<const TArray<FModifyBoneConstraint>, ESPMode::ThreadSafe>* Compiled =
+		CompiledBoneConstraints.Find(SkeletonKey))
+	{
+		return *Compiled;
+	}
+
+	TArray<FModifyBoneConstraint> BoneConstraints = GenerateBoneConstraints();
+	if (Skeleton)
+	{
+		// Constraints on bones the skeleton doesn't have can never be resolved to ModifyBones
+		BoneConstraints.RemoveAll([Skeleton](FModifyBoneConstraint& BoneConstraint)
+		{
+			return !BoneConstraint.Bone1.Initialize(Skeleton) || !BoneConstraint.Bone2.Initialize(Skeleton) ||
+				BoneConstraint.Bone1 == BoneConstraint.Bone2;
+		});
+	}
+
+	return CompiledBoneConstraints.Add(
+		SkeletonKey, MakeShared<const TArray<FModifyBoneConstraint>, ESPMode::ThreadSafe>(MoveTemp(BoneConstraints)));
+}
+
+void UKawaiiPhysicsBoneConstraintsDataAsset::InvalidateCompiledBoneConstraints()
+{
+	FScopeLock Lock(&CompiledBoneConstraintsLock);
+	CompiledBoneConstraints.Reset();
+}
+
 void UKawaiiPhysicsBoneConstraintsDataAsset::Serialize(FStructuredArchiveRecord Record)
 {
 	Super::Serialize(Record);
@@ -127,6 +161,8 @@ void UKawaiiPhysicsBoneConstraintsDataAsset::ApplyRegex()
 	}
 
 	GEditor->EndTransaction();
+
+	InvalidateCompiledBoneConstraints();
 }
 
 
@@ -156,16 +192,27 @@ void UKawaiiPhysicsBoneConstraintsDataAsset::UpdatePreviewBoneList()
 
 void UKawaiiPhysicsBoneConstraintsDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
 	const FName PropertyName = PropertyChangedEvent.MemberProperty
 		                           ? PropertyChangedEvent.MemberProperty->GetFName()
 		                           : NAME_None;
 
+	InvalidateCompiledBoneConstraints();
+
 	if (PropertyName == FName(TEXT("PreviewSkeleton")))
 	{
 		UpdatePreviewBoneList();
 	}
 }
 
+void UKawaiiPhysicsBoneConstraintsDataAsset::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	InvalidateCompiledBoneConstraints();
+}
+
 #undef LOCTEXT_NAMESPACE
 
 #endif
@@ -0,0 +1,121 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsBroadphase.h"
+#include "AnimNode_KawaiiPhysics.h"
+
+void FKawaiiPhysicsBroadphase::Reset()
+{
+	Proxies.Reset();
+}
+
+void FKawaiiPhysicsBroadphase::AddSphericalLimits(const TArray<FSphericalLimit>& Limits)
+{
+	for (const FSphericalLimit& Sphere : Limits)
+	{
+		if (!Sphere.bEnable || Sphere.Radius <= 0.0f)
+		{
+			continue;
+		}
+
+		FKawaiiPhysicsLimitProxy& Proxy = Proxies.AddDefaulted_GetRef();
+		Proxy.Limit = &Sphere;
+		Proxy.Shape = EKawaiiPhysicsLimitShape::Sphere;
+		Proxy.Bounds = FBox(Sphere.Location - FVector(Sphere.Radius), Sphere.Location + FVector(Sphere.Radius));
+		Proxy.bAlwaysTest = Sphere.LimitType != ESphericalLimitType::Outer;
+	}
+}
+
+void FKawaiiPhysicsBroadphase::AddCapsuleLimits(const TArray<FCapsuleLimit>& Limits)
+{
+	for (const FCapsuleLimit& Capsule : Limits)
+	{
+		if (!Capsule.bEnable || Capsule.Radius <= 0 || Capsule.Length <= 0)
+		{
+			continue;
+		}
+
+		const FVector HalfAxis = Capsule.Rotation.GetAxisZ() * Capsule.Length * 0.5f;
+		FBox Bounds(ForceInit);
+		Bounds += Capsule.Location + HalfAxis;
+		Bounds += Capsule.Location - HalfAxis;
+
+		FKawaiiPhysicsLimitProxy& Proxy = Proxies.AddDefaulted_GetRef();
+		Proxy.Limit = &Capsule;
+		Proxy.Shape = EKawaiiPhysicsLimitShape::Capsule;
+		Proxy.Bounds = Bounds.ExpandBy(Capsule.Radius);
+	}
+}
+
+void FKawaiiPhysicsBroadphase::AddBoxLimits(const TArray<FBoxLimit>& Limits)
+{
+	// NOTE: AdjustByBoxCollision does not look at bEnable, keep every box
+	for (const FBoxLimit& Box : Limits)
+	{
+		FKawaiiPhysicsLimitProxy& Proxy = Proxies.AddDefaulted_GetRef();
+		Proxy.Limit = &Box;
+		Proxy.Shape = EKawaiiPhysicsLimitShape::Box;
+		Proxy.Bounds = FBox(-Box.Extent, Box.Extent).TransformBy(FTransform(Box.Rotation, Box.Location));
+	}
+}
+
+void FKawaiiPhysicsBroadphase::AddPlanarLimits(const TArray<FPlanarLimit>& Limits)
+{
+	for (const FPlanarLimit& Planar : Limits)
+	{
+		if (!Planar.bEnable)
+		{
+			continue;
+		}
+
+		FKawaiiPhysicsLimitProxy& Proxy = Proxies.AddDefaulted_GetRef();
+		Proxy.Limit = &Planar;
+		Proxy.Shape = EKawaiiPhysicsLimitShape::Planar;
+		Proxy.bAlwaysTest = true;
+	}
+}
+
+void FKawaiiPhysicsBroadphase::BuildCandidates(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones,
+                                               const TArray<int32>& BoneIndices,
+                                               FKawaiiPhysicsCollisionCandidates& OutCandidates) const
+{
+	OutCandidates.Reset();
+
+	for (int32 ChunkStart = 0; ChunkStart < BoneIndices.Num(); ChunkStart += ChunkSize)
+	{
+		const int32 ChunkEnd = FMath::Min(ChunkStart + ChunkSize, BoneIndices.Num());
+
+		FBox Bounds(ForceInit);
+		float MaxRadius = 0.0f;
+		for (int32 i = ChunkStart; i < ChunkEnd; ++i)
+		{
+			const FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndices[i]];
+			if (!Bone.bSkipSimulate)
+			{
+				Bounds += Bone.Location;
+				MaxRadius = FMath::Max(MaxRadius, Bone.PhysicsSettings.Radius);
+			}
+		}
+
+		OutCandidates.ChunkBounds.Add(Bounds);
+		OutCandidates.ChunkBoneStarts.Add(ChunkStart);
+		OutCandidates.CandidateStarts.Add(OutCandidates.Candidates.Num());
+
+		if (!Bounds.IsValid)
+		{
+			continue;
+		}
+
+		const FBox InflatedBounds = Bounds.ExpandBy(MaxRadius + UE_KINDA_SMALL_NUMBER);
+		for (int32 ProxyIndex = 0; ProxyIndex < Proxies.Num(); ++ProxyIndex)
+		{
+			const FKawaiiPhysicsLimitProxy& Proxy = Proxies[ProxyIndex];
+			if (Proxy.bAlwaysTest || Proxy.Bounds.Intersect(InflatedBounds))
+			{
+				OutCandidates.Candidates.Add(ProxyIndex);
+			}
+		}
+	}
+
+	OutCandidates.ChunkBoneStarts.Add(BoneIndices.Num());
+	OutCandidates.CandidateStarts.Add(OutCandidates.Candidates.Num());
+}
@@ -15,6 +15,15 @@ DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_ExternalForce_Curve_Apply"), STAT_KawaiiP
 DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_ExternalForce_Wind_Apply"), STAT_KawaiiPhysics_ExternalForce_Wind_Apply,
                    STATGROUP_Anim);
 
+namespace KawaiiPhysicsExternalForce
+{
+	/** ForceRateByBoneLengthRate at the bone, 1 while the curve has no keys */
+	FORCEINLINE float GetForceRate(const FRichCurve* Curve, const FKawaiiPhysicsModifyBone& Bone)
+	{
+		return Curve && !Curve->IsEmpty() ? Curve->Eval(Bone.LengthRateFromRoot) : 1.0f;
+	}
+}
+
 ///
 /// Basic
 ///
@@ -58,29 +67,49 @@ void FKawaiiPhysics_ExternalForce_Basic::Apply(FKawaiiPhysicsModifyBone& Bone, F
 
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Basic_Apply);
 
-	float ForceRate = 1.0f;
-	if (const auto Curve = ForceRateByBoneLengthRate.GetRichCurve(); !Curve->IsEmpty())
+	const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateByBoneLengthRate.GetRichCurve(), Bone);
+	ApplyToBone(Bone, Node, ForceRate, BoneTM);
+}
+
+void FKawaiiPhysics_ExternalForce_Basic::ApplyBatch(TConstArrayView<int32> BoneIndices,
+                                                    TConstArrayView<FTransform> BoneTransforms,
+                                                    FAnimNode_KawaiiPhysics& Node,
+                                                    const FComponentSpacePoseContext& PoseContext)
+{
+	// Between two intervals the force is zero
+	if (Force.IsZero())
 	{
-		ForceRate = Curve->Eval(Bone.LengthRateFromRoot);
+		return;
 	}
 
-	if (ExternalForceSpace == EExternalForceSpace::BoneSpace)
-	{
-		const FVector BoneForce = BoneTM.TransformVector(Force);
-		Bone.Location += BoneForce * ForceRate * Node.DeltaTime;
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Basic_Apply);
 
-#if ENABLE_ANIM_DEBUG
-		BoneForceMap.Add(Bone.BoneRef.BoneName, BoneForce);
-#endif
-	}
-	else
+	const FRichCurve* ForceRateCurve = ForceRateByBoneLengthRate.GetRichCurve();
+	const bool bBoneSpace = ExternalForceSpace == EExternalForceSpace::BoneSpace;
+	for (const int32 BoneIndex : BoneIndices)
 	{
-		Bone.Location += Force * ForceRate * Node.DeltaTime;
+		FKawaiiPhysicsModifyBone& Bone = Node.ModifyBones[BoneIndex];
+		if (CanApply(Bone))
+		{
+			const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateCurve, Bone);
+			ApplyToBone(Bone, Node, ForceRate,
+			            bBoneSpace ? BoneTransforms[BoneIndex] : FTransform::Identity);
+		}
+	}
+}
+
+void FKawaiiPhysics_ExternalForce_Basic::ApplyToBone(FKawaiiPhysicsModifyBone& Bone,
+                                                     const FAnimNode_KawaiiPhysics& Node, float ForceRate,
+                                                     const FTransform& BoneTM)
+{
+	const FVector BoneForce = ExternalForceSpace == EExternalForceSpace::BoneSpace
+		                          ? BoneTM.TransformVector(Force)
+		                          : Force;
+	Bone.Location += BoneForce * ForceRate * Node.DeltaTime;
 
 #if ENABLE_ANIM_DEBUG
-		BoneForceMap.Add(Bone.BoneRef.BoneName, Force * ForceRate);
+	BoneForceMap.Add(Bone.BoneRef.BoneName, BoneForce * ForceRate);
 #endif
-	}
 }
 
 ///
@@ -128,12 +157,32 @@ void FKawaiiPhysics_ExternalForce_Gravity::Apply(FKawaiiPhysicsModifyBone& Bone,
 
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Gravity_Apply);
 
-	float ForceRate = 1.0f;
-	if (const auto Curve = ForceRateByBoneLengthRate.GetRichCurve(); !Curve->IsEmpty())
+	const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateByBoneLengthRate.GetRichCurve(), Bone);
+	ApplyToBone(Bone, Node, PoseContext, ForceRate);
+}
+
+void FKawaiiPhysics_ExternalForce_Gravity::ApplyBatch(TConstArrayView<int32> BoneIndices,
+                                                      TConstArrayView<FTransform> BoneTransforms,
+                                                      FAnimNode_KawaiiPhysics& Node,
+                                                      const FComponentSpacePoseContext& PoseContext)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Gravity_Apply);
+
+	const FRichCurve* ForceRateCurve = ForceRateByBoneLengthRate.GetRichCurve();
+	for (const int32 BoneIndex : BoneIndices)
 	{
-		ForceRate = Curve->Eval(Bone.LengthRateFromRoot);
+		FKawaiiPhysicsModifyBone& Bone = Node.ModifyBones[BoneIndex];
+		if (CanApply(Bone))
+		{
+			const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateCurve, Bone);
+			ApplyToBone(Bone, Node, PoseContext, ForceRate);
+		}
 	}
+}
 
+void FKawaiiPhysics_ExternalForce_Gravity::ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+                                                       const FComponentSpacePoseContext& PoseContext, float ForceRate)
+{
 	Bone.Location += 0.5f * Force * ForceRate * Node.DeltaTime * Node.DeltaTime;
 
 #if ENABLE_ANIM_DEBUG
@@ -251,31 +300,42 @@ void FKawaiiPhysics_ExternalForce_Curve::Apply(FKawaiiPhysicsModifyBone& Bone, F
 
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Curve_Apply);
 
-	float ForceRate = 1.0f;
-	if (const auto Curve = ForceRateByBoneLengthRate.GetRichCurve(); !Curve->IsEmpty())
-	{
-		ForceRate = Curve->Eval(Bone.LengthRateFromRoot);
-	}
+	const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateByBoneLengthRate.GetRichCurve(), Bone);
+	ApplyToBone(Bone, Node, PoseContext, ForceRate, BoneTM);
+}
 
-	if (ExternalForceSpace == EExternalForceSpace::BoneSpace)
-	{
-		const FVector BoneForce = BoneTM.TransformVector(Force);
-		Bone.Location += BoneForce * ForceRate * Node.DeltaTime;
+void FKawaiiPhysics_ExternalForce_Curve::ApplyBatch(TConstArrayView<int32> BoneIndices,
+                                                    TConstArrayView<FTransform> BoneTransforms,
+                                                    FAnimNode_KawaiiPhysics& Node,
+                                                    const FComponentSpacePoseContext& PoseContext)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Curve_Apply);
 
-#if ENABLE_ANIM_DEBUG
-		BoneForceMap.Add(Bone.BoneRef.BoneName, BoneForce * ForceRate);
-#endif
-	}
-	else
+	const FRichCurve* ForceRateCurve = ForceRateByBoneLengthRate.GetRichCurve();
+	const bool bBoneSpace = ExternalForceSpace == EExternalForceSpace::BoneSpace;
+	for (const int32 BoneIndex : BoneIndices)
 	{
-		Bone.Location += Force * ForceRate * Node.DeltaTime;
-
-#if ENABLE_ANIM_DEBUG
-		BoneForceMap.Add(Bone.BoneRef.BoneName, Force * ForceRate);
-#endif
+		FKawaiiPhysicsModifyBone& Bone = Node.ModifyBones[BoneIndex];
+		if (CanApply(Bone))
+		{
+			const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateCurve, Bone);
+			ApplyToBone(Bone, Node, PoseContext, ForceRate,
+			            bBoneSpace ? BoneTransforms[BoneIndex] : FTransform::Identity);
+		}
 	}
+}
+
+void FKawaiiPhysics_ExternalForce_Curve::ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+                                                     const FComponentSpacePoseContext& PoseContext, float ForceRate,
+                                                     const FTransform& BoneTM)
+{
+	const FVector BoneForce = ExternalForceSpace == EExternalForceSpace::BoneSpace
+		                          ? BoneTM.TransformVector(Force)
+		                          : Force;
+	Bone.Location += BoneForce * ForceRate * Node.DeltaTime;
 
 #if ENABLE_ANIM_DEBUG
+	BoneForceMap.Add(Bone.BoneRef.BoneName, BoneForce * ForceRate);
 	AnimDrawDebug(Bone, Node, PoseContext);
 #endif
 }
@@ -298,16 +358,44 @@ void FKawaiiPhysics_ExternalForce_Wind::Apply(FKawaiiPhysicsModifyBone& Bone, FA
 
 	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Wind_Apply);
 
-	float ForceRate = 1.0f;
-	if (const auto Curve = ForceRateByBoneLengthRate.GetRichCurve(); !Curve->IsEmpty())
+	const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateByBoneLengthRate.GetRichCurve(), Bone);
+	ApplyToBone(Bone, Node, PoseContext, *Scene, ForceRate);
+}
+
+void FKawaiiPhysics_ExternalForce_Wind::ApplyBatch(TConstArrayView<int32> BoneIndices,
+                                                   TConstArrayView<FTransform> BoneTransforms,
+                                                   FAnimNode_KawaiiPhysics& Node,
+                                                   const FComponentSpacePoseContext& PoseContext)
+{
+	const FSceneInterface* Scene = World && World->Scene ? World->Scene : nullptr;
+	if (!Scene)
 	{
-		ForceRate = Curve->Eval(Bone.LengthRateFromRoot);
+		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_ExternalForce_Wind_Apply);
+
+	const FRichCurve* ForceRateCurve = ForceRateByBoneLengthRate.GetRichCurve();
+	for (const int32 BoneIndex : BoneIndices)
+	{
+		FKawaiiPhysicsModifyBone& Bone = Node.ModifyBones[BoneIndex];
+		if (CanApply(Bone))
+		{
+			const float ForceRate = KawaiiPhysicsExternalForce::GetForceRate(ForceRateCurve, Bone);
+			ApplyToBone(Bone, Node, PoseContext, *Scene, ForceRate);
+		}
+	}
+}
+
+void FKawaiiPhysics_ExternalForce_Wind::ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+                                                    const FComponentSpacePoseContext& PoseContext,
+                                                    const FSceneInterface& Scene, float ForceRate)
+{
+	// Wind sources are positional, so the wind is still sampled per bone
 	FVector WindDirection = FVector::ZeroVector;
 	float WindSpeed, WindMinGust, WindMaxGust = 0.0f;
-	Scene->GetWindParameters(ComponentTransform.TransformPosition(Bone.PoseLocation), WindDirection,
-	                         WindSpeed, WindMinGust, WindMaxGust);
+	Scene.GetWindParameters(ComponentTransform.TransformPosition(Bone.PoseLocation), WindDirection,
+	                        WindSpeed, WindMinGust, WindMaxGust);
 	WindDirection = ComponentTransform.InverseTransformVector(WindDirection);
 	WindDirection *= WindSpeed;
 
@@ -0,0 +1,223 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsSignificanceSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+static TAutoConsoleVariable<bool> CVarKawaiiPhysicsSignificance(
+	TEXT("a.AnimNode.KawaiiPhysics.Significance"), false,
+	TEXT("Assign quality tiers to KawaiiPhysics nodes by screen size, visibility and a global budget"));
+static TAutoConsoleVariable<float> CVarKawaiiPhysicsSignificanceBudgetMs(
+	TEXT("a.AnimNode.KawaiiPhysics.Significance.BudgetMs"), 2.0f,
+	TEXT("Estimated KawaiiPhysics cost per frame (ms) the significance manager keeps all instances within. 0 = no budget"));
+static TAutoConsoleVariable<float> CVarKawaiiPhysicsSignificanceFullScreenSize(
+	TEXT("a.AnimNode.KawaiiPhysics.Significance.FullScreenSize"), 0.1f,
+	TEXT("Minimum screen size (bounds radius / view half width) for the Full tier"));
+static TAutoConsoleVariable<float> CVarKawaiiPhysicsSignificanceReducedScreenSize(
+	TEXT("a.AnimNode.KawaiiPhysics.Significance.ReducedScreenSize"), 0.03f,
+	TEXT("Minimum screen size for the Reduced tier"));
+static TAutoConsoleVariable<float> CVarKawaiiPhysicsSignificanceLowScreenSize(
+	TEXT("a.AnimNode.KawaiiPhysics.Significance.LowScreenSize"), 0.01f,
+	TEXT("Minimum screen size for the Low tier. Smaller instances are frozen"));
+
+namespace KawaiiPhysicsSignificance
+{
+	/** Instances not rendered for this long are at most Low */
+	constexpr float NotRenderedTime = 0.5f;
+
+	/** Instances not updated for this many frames are removed */
+	constexpr uint64 StaleFrames = 2;
+
+	/** Weight of the newest cost sample */
+	constexpr float CostSmoothing = 0.2f;
+
+	struct FView
+	{
+		FVector Location;
+		float TanHalfFOV;
+	};
+}
+
+bool UKawaiiPhysicsSignificanceSubsystem::IsEnabled()
+{
+	return CVarKawaiiPhysicsSignificance.GetValueOnGameThread();
+}
+
+float UKawaiiPhysicsSignificanceSubsystem::GetTierCostScale(EKawaiiPhysicsSignificanceTier Tier)
+{
+	switch (Tier)
+	{
+	case EKawaiiPhysicsSignificanceTier::Full:
+		return 1.0f;
+	case EKawaiiPhysicsSignificanceTier::Reduced:
+		return 0.4f;
+	case EKawaiiPhysicsSignificanceTier::Low:
+		return 0.15f;
+	default:
+		return 0.0f;
+	}
+}
+
+TStatId UKawaiiPhysicsSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UKawaiiPhysicsSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UKawaiiPhysicsSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+EKawaiiPhysicsSignificanceTier UKawaiiPhysicsSignificanceSubsystem::UpdateInstance(
+	const USkeletalMeshComponent* Component, float CostMs, EKawaiiPhysicsSignificanceTier CostTier)
+{
+	int32 Index;
+	if (const int32* Found = InstanceIndices.Find(Component))
+	{
+		Index = *Found;
+	}
+	else
+	{
+		Index = Instances.AddDefaulted();
+		Instances[Index].Component = Component;
+		InstanceIndices.Add(Component, Index);
+	}
+
+	FInstance& Instance = Instances[Index];
+	if (Instance.LastUpdateFrame != GFrameCounter)
+	{
+		Instance.LastUpdateFrame = GFrameCounter;
+		Instance.FrameFullCostMs = 0.0f;
+	}
+
+	// Frozen nodes cost (almost) nothing and tell nothing about the full cost
+	const float Scale = GetTierCostScale(CostTier);
+	if (Scale > 0.0f)
+	{
+		Instance.FrameFullCostMs += CostMs / Scale;
+	}
+	return Instance.Tier;
+}
+
+void UKawaiiPhysicsSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	using namespace KawaiiPhysicsSignificance;
+
+	// Remove components that are gone or whose nodes stopped evaluating
+	const int32 NumBefore = Instances.Num();
+	Instances.RemoveAllSwap([](const FInstance& Instance)
+	{
+		return !Instance.Component.IsValid() || GFrameCounter - Instance.LastUpdateFrame > StaleFrames;
+	});
+	if (Instances.Num() != NumBefore)
+	{
+		InstanceIndices.Reset();
+		for (int32 i = 0; i < Instances.Num(); ++i)
+		{
+			InstanceIndices.Add(Instances[i].Component, i);
+		}
+	}
+
+	EstimatedCostMs = 0.0f;
+	if (Instances.Num() == 0)
+	{
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	TArray<FView, TInlineAllocator<4>> Views;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+		{
+			const APlayerCameraManager* Camera = PlayerController->PlayerCameraManager;
+			Views.Add({
+				Camera->GetCameraLocation(),
+				FMath::Tan(FMath::DegreesToRadians(FMath::Max(Camera->GetFOVAngle(), 1.0f) * 0.5f))
+			});
+		}
+	}
+
+	const float FullScreenSize = CVarKawaiiPhysicsSignificanceFullScreenSize.GetValueOnGameThread();
+	const float ReducedScreenSize = CVarKawaiiPhysicsSignificanceReducedScreenSize.GetValueOnGameThread();
+	const float LowScreenSize = CVarKawaiiPhysicsSignificanceLowScreenSize.GetValueOnGameThread();
+
+	// Score : screen size in the closest view, lowered while not rendered
+	TArray<EKawaiiPhysicsSignificanceTier, TInlineAllocator<64>> BaseTiers;
+	BaseTiers.SetNumUninitialized(Instances.Num());
+	for (int32 i = 0; i < Instances.Num(); ++i)
+	{
+		FInstance& Instance = Instances[i];
+		const USkeletalMeshComponent* Component = Instance.Component.Get();
+
+		if (Instance.FrameFullCostMs > 0.0f)
+		{
+			Instance.FullCostMs = Instance.FullCostMs > 0.0f
+				                      ? FMath::Lerp(Instance.FullCostMs, Instance.FrameFullCostMs, CostSmoothing)
+				                      : Instance.FrameFullCostMs;
+		}
+
+		// Without a local view (dedicated server) every instance is equally significant
+		float ScreenSize = FullScreenSize;
+		if (Views.Num() > 0)
+		{
+			ScreenSize = 0.0f;
+			const FBoxSphereBounds& Bounds = Component->Bounds;
+			for (const FView& View : Views)
+			{
+				const float Distance = FMath::Max(FVector::Dist(View.Location, Bounds.Origin), 1.0f);
+				ScreenSize = FMath::Max(ScreenSize, Bounds.SphereRadius / (Distance * View.TanHalfFOV));
+			}
+		}
+
+		const bool bRendered = Views.Num() == 0 || Component->WasRecentlyRendered(NotRenderedTime);
+		Instance.Significance = bRendered ? ScreenSize : ScreenSize * 0.25f;
+
+		EKawaiiPhysicsSignificanceTier BaseTier = ScreenSize >= FullScreenSize
+			                                          ? EKawaiiPhysicsSignificanceTier::Full
+			                                          : ScreenSize >= ReducedScreenSize
+			                                          ? EKawaiiPhysicsSignificanceTier::Reduced
+			                                          : ScreenSize >= LowScreenSize
+			                                          ? EKawaiiPhysicsSignificanceTier::Low
+			                                          : EKawaiiPhysicsSignificanceTier::Frozen;
+		if (!bRendered && BaseTier < EKawaiiPhysicsSignificanceTier::Low)
+		{
+			BaseTier = EKawaiiPhysicsSignificanceTier::Low;
+		}
+		BaseTiers[i] = BaseTier;
+	}
+
+	// Most significant first, each gets the best tier that still fits in the budget
+	SortedInstances.SetNumUninitialized(Instances.Num());
+	for (int32 i = 0; i < Instances.Num(); ++i)
+	{
+		SortedInstances[i] = i;
+	}
+	SortedInstances.Sort([this](const int32 A, const int32 B)
+	{
+		return Instances[A].Significance > Instances[B].Significance;
+	});
+
+	const float BudgetMs = CVarKawaiiPhysicsSignificanceBudgetMs.GetValueOnGameThread();
+	for (const int32 InstanceIndex : SortedInstances)
+	{
+		FInstance& Instance = Instances[InstanceIndex];
+		EKawaiiPhysicsSignificanceTier Tier = BaseTiers[InstanceIndex];
+		if (BudgetMs > 0.0f)
+		{
+			while (Tier != EKawaiiPhysicsSignificanceTier::Frozen &&
+				EstimatedCostMs + Instance.FullCostMs * GetTierCostScale(Tier) > BudgetMs)
+			{
+				Tier = static_cast<EKawaiiPhysicsSignificanceTier>(static_cast<uint8>(Tier) + 1);
+			}
+		}
+		Instance.Tier = Tier;
+		EstimatedCostMs += Instance.FullCostMs * GetTierCostScale(Tier);
+	}
+}
@@ -0,0 +1,38 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FComponentSpacePoseContext;
+class USkeletalMeshComponent;
+class UWorld;
+
+/**
+ * Per step state shared by the island passes of FAnimNode_KawaiiPhysics::SimulateModifyBones.
+ */
+struct FKawaiiPhysicsSimulateContext
+{
+	FComponentSpacePoseContext& Output;
+	const FTransform& ComponentTransform;
+	const USkeletalMeshComponent* SkelComp = nullptr;
+	const UWorld* World = nullptr;
+	FVector GravityCS = FVector::ZeroVector;
+	float Exponent = 1.0f;
+	int32 PlaneAxis = 0;
+	bool bUseSolver = true;
+	bool bUseSolverIntegration = true;
+	bool bWorldCollision = false;
+	int32 BoneConstraintIterations = 0;
+};
+
+/**
+ * Cycles spent in each island pass, accumulated by FAnimNode_KawaiiPhysics::SimulateSubSteps for the benchmark.
+ */
+struct FKawaiiPhysicsStageCycles
+{
+	uint64 Integrate = 0;
+	uint64 Collision = 0;
+	uint64 BoneConstraint = 0;
+	uint64 LimitsAndBoneLength = 0;
+};
@@ -0,0 +1,653 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsSolver.h"
+#include "AnimNode_KawaiiPhysics.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SolverGather"), STAT_KawaiiPhysics_SolverGather, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SolverIntegrate"), STAT_KawaiiPhysics_SolverIntegrate, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SolverRestoreLength"), STAT_KawaiiPhysics_SolverRestoreLength,
+                   STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_SolverBoneConstraint"), STAT_KawaiiPhysics_SolverBoneConstraint,
+                   STATGROUP_Anim);
+
+namespace KawaiiPhysicsSolver
+{
+	FORCEINLINE VectorRegister4Float GatherLanes(const TArray<float>& Values, const int32* Slots)
+	{
+		return MakeVectorRegisterFloat(Values[Slots[0]], Values[Slots[1]], Values[Slots[2]], Values[Slots[3]]);
+	}
+
+	FORCEINLINE FVector3f Load(const TArray<float>& X, const TArray<float>& Y, const TArray<float>& Z, int32 Slot)
+	{
+		return FVector3f(X[Slot], Y[Slot], Z[Slot]);
+	}
+
+	FORCEINLINE void Store(TArray<float>& X, TArray<float>& Y, TArray<float>& Z, int32 Slot, const FVector3f& V)
+	{
+		X[Slot] = V.X;
+		Y[Slot] = V.Y;
+		Z[Slot] = V.Z;
+	}
+
+	FORCEINLINE void ScatterLanes(TArray<float>& Values, const int32* Slots, const VectorRegister4Float& V)
+	{
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(V, Lanes);
+		Values[Slots[0]] = Lanes[0];
+		Values[Slots[1]] = Lanes[1];
+		Values[Slots[2]] = Lanes[2];
+		Values[Slots[3]] = Lanes[3];
+	}
+}
+
+bool FKawaiiPhysicsSolver::IsBuiltFor(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones) const
+{
+	return NumBones > 0 && NumBones == ModifyBones.Num();
+}
+
+void FKawaiiPhysicsSolver::Reset()
+{
+	BoneIndices.Reset();
+	BoneToSlot.Reset();
+	ParentSlots.Reset();
+	LevelStarts.Reset();
+	NumBones = 0;
+}
+
+void FKawaiiPhysicsSolver::AddSlot(int32 BoneIndex, int32 ParentSlot)
+{
+	const int32 Slot = BoneIndices.Add(BoneIndex);
+	ParentSlots.Add(ParentSlot == INDEX_NONE ? Slot : ParentSlot);
+	if (BoneIndex >= 0)
+	{
+		BoneToSlot[BoneIndex] = Slot;
+	}
+}
+
+void FKawaiiPhysicsSolver::Build(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones,
+                                 TConstArrayView<int32> InBoneIndices)
+{
+	Reset();
+
+	NumBones = ModifyBones.Num();
+	const int32 NumSolverBones = InBoneIndices.Num();
+	if (NumSolverBones == 0)
+	{
+		return;
+	}
+
+	// Depth of each bone. Parents are always stored before children
+	BoneToSlot.Init(INDEX_NONE, NumBones);
+	TArray<int32> Depths;
+	Depths.SetNumUninitialized(NumSolverBones);
+	int32 MaxDepth = 0;
+	for (int32 i = 0; i < NumSolverBones; ++i)
+	{
+		const int32 ParentIndex = ModifyBones[InBoneIndices[i]].ParentIndex;
+		// BoneToSlot temporarily holds the depth while building
+		check(ParentIndex < 0 || BoneToSlot[ParentIndex] != INDEX_NONE);
+		Depths[i] = ParentIndex >= 0 ? BoneToSlot[ParentIndex] + 1 : 0;
+		BoneToSlot[InBoneIndices[i]] = Depths[i];
+		MaxDepth = FMath::Max(MaxDepth, Depths[i]);
+	}
+
+	// Bucket by depth (counting sort keeps the original order inside a level)
+	TArray<int32> LevelCounts;
+	LevelCounts.SetNumZeroed(MaxDepth + 1);
+	for (const int32 Depth : Depths)
+	{
+		++LevelCounts[Depth];
+	}
+	TArray<int32> SortedBones;
+	SortedBones.SetNumUninitialized(NumSolverBones);
+	TArray<int32> Cursor;
+	Cursor.SetNumUninitialized(MaxDepth + 1);
+	for (int32 Depth = 0, Offset = 0; Depth <= MaxDepth; ++Depth)
+	{
+		Cursor[Depth] = Offset;
+		Offset += LevelCounts[Depth];
+	}
+	for (int32 i = 0; i < NumSolverBones; ++i)
+	{
+		SortedBones[Cursor[Depths[i]]++] = InBoneIndices[i];
+	}
+
+	// Slots, each level padded to a multiple of BatchSize
+	BoneToSlot.Init(INDEX_NONE, NumBones);
+	BoneIndices.Reserve(Align(NumSolverBones, BatchSize) + (MaxDepth + 1) * BatchSize);
+	ParentSlots.Reserve(BoneIndices.Max());
+	LevelStarts.Reserve(MaxDepth + 2);
+	for (int32 Depth = 0, Offset = 0; Depth <= MaxDepth; ++Depth)
+	{
+		LevelStarts.Add(BoneIndices.Num());
+		for (int32 i = 0; i < LevelCounts[Depth]; ++i)
+		{
+			const int32 BoneIndex = SortedBones[Offset + i];
+			const int32 ParentIndex = ModifyBones[BoneIndex].ParentIndex;
+			AddSlot(BoneIndex, ParentIndex >= 0 ? BoneToSlot[ParentIndex] : INDEX_NONE);
+		}
+		Offset += LevelCounts[Depth];
+
+		while (BoneIndices.Num() % BatchSize != 0)
+		{
+			AddSlot(INDEX_NONE, INDEX_NONE);
+		}
+	}
+	LevelStarts.Add(BoneIndices.Num());
+
+	const int32 NumSlots = BoneIndices.Num();
+	for (TArray<float>* Array : {
+		     &Active, &LocX, &LocY, &LocZ, &PrevX, &PrevY, &PrevZ, &PoseDeltaX, &PoseDeltaY, &PoseDeltaZ,
+		     &PoseLength, &Damping, &WorldDampingLocation, &WorldDampingRotation, &Stiffness, &Radius, &LimitAngle,
+		     &FollowRate, &WindX, &WindY, &WindZ, &PlaneNormalX, &PlaneNormalY, &PlaneNormalZ
+	     })
+	{
+		Array->Reset(NumSlots);
+		Array->SetNumZeroed(NumSlots);
+	}
+}
+
+void FKawaiiPhysicsSolver::Gather(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones, int32 PlaneAxis)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverGather);
+
+	using namespace KawaiiPhysicsSolver;
+
+	bAnyAngleLimit = false;
+	bPlanarConstraint = PlaneAxis != 0;
+
+	for (int32 Slot = 0; Slot < BoneIndices.Num(); ++Slot)
+	{
+		const int32 BoneIndex = BoneIndices[Slot];
+		if (BoneIndex < 0)
+		{
+			continue;
+		}
+
+		const FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		Store(LocX, LocY, LocZ, Slot, FVector3f(Bone.Location));
+		Store(PrevX, PrevY, PrevZ, Slot, FVector3f(Bone.PrevLocation));
+
+		Active[Slot] = Bone.bSkipSimulate ? 0.0f : 1.0f;
+		Damping[Slot] = Bone.PhysicsSettings.Damping;
+		WorldDampingLocation[Slot] = Bone.PhysicsSettings.WorldDampingLocation;
+		WorldDampingRotation[Slot] = Bone.PhysicsSettings.WorldDampingRotation;
+		Stiffness[Slot] = Bone.PhysicsSettings.Stiffness;
+		Radius[Slot] = Bone.PhysicsSettings.Radius;
+		LimitAngle[Slot] = Bone.PhysicsSettings.LimitAngle;
+		bAnyAngleLimit |= !Bone.bSkipSimulate && Bone.PhysicsSettings.LimitAngle != 0.0f;
+
+		if (!Bone.HasParent())
+		{
+			Store(PoseDeltaX, PoseDeltaY, PoseDeltaZ, Slot, FVector3f::ZeroVector);
+			PoseLength[Slot] = 0.0f;
+			continue;
+		}
+
+		const FKawaiiPhysicsModifyBone& ParentBone = ModifyBones[Bone.ParentIndex];
+		const FVector3f PoseDelta(Bone.PoseLocation - ParentBone.PoseLocation);
+		Store(PoseDeltaX, PoseDeltaY, PoseDeltaZ, Slot, PoseDelta);
+		PoseLength[Slot] = PoseDelta.Size();
+
+		if (bPlanarConstraint)
+		{
+			const FVector PlaneNormal = PlaneAxis == 1
+				                            ? ParentBone.PoseRotation.GetAxisX()
+				                            : PlaneAxis == 2
+				                            ? ParentBone.PoseRotation.GetAxisY()
+				                            : ParentBone.PoseRotation.GetAxisZ();
+			Store(PlaneNormalX, PlaneNormalY, PlaneNormalZ, Slot, FVector3f(PlaneNormal));
+		}
+	}
+}
+
+void FKawaiiPhysicsSolver::GatherLocations(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones)
+{
+	for (int32 Slot = 0; Slot < BoneIndices.Num(); ++Slot)
+	{
+		const int32 BoneIndex = BoneIndices[Slot];
+		if (BoneIndex >= 0)
+		{
+			KawaiiPhysicsSolver::Store(LocX, LocY, LocZ, Slot, FVector3f(ModifyBones[BoneIndex].Location));
+		}
+	}
+}
+
+void FKawaiiPhysicsSolver::ScatterLocations(TArray<FKawaiiPhysicsModifyBone>& ModifyBones,
+                                            bool bWritePrevLocation) const
+{
+	using namespace KawaiiPhysicsSolver;
+
+	for (int32 Slot = 0; Slot < BoneIndices.Num(); ++Slot)
+	{
+		const int32 BoneIndex = BoneIndices[Slot];
+		if (BoneIndex < 0 || Active[Slot] == 0.0f)
+		{
+			continue;
+		}
+
+		FKawaiiPhysicsModifyBone& Bone = ModifyBones[BoneIndex];
+		Bone.Location = FVector(Load(LocX, LocY, LocZ, Slot));
+		if (bWritePrevLocation)
+		{
+			Bone.PrevLocation = FVector(Load(PrevX, PrevY, PrevZ, Slot));
+		}
+	}
+}
+
+void FKawaiiPhysicsSolver::SetWindVelocity(int32 Slot, const FVector& WindVelocity)
+{
+	KawaiiPhysicsSolver::Store(WindX, WindY, WindZ, Slot, FVector3f(WindVelocity));
+}
+
+void FKawaiiPhysicsSolver::Integrate(const FKawaiiPhysicsSolverParams& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverIntegrate);
+
+	if (LevelStarts.Num() < 3)
+	{
+		// roots only
+		return;
+	}
+
+	// Depth 0 contains only root bones, which are never simulated
+	const int32 Begin = LevelStarts[1];
+	const int32 End = Num();
+
+	for (int32 Slot = Begin; Slot < End; ++Slot)
+	{
+		FollowRate[Slot] = 1.0f - FMath::Pow(1.0f - Stiffness[Slot], Params.Exponent);
+	}
+
+	// (R - I) as three columns, so that "Rotate(P) - P" becomes a 3x3 multiply-add
+	const FVector3f RotX = Params.SkelCompMoveRotation.RotateVector(FVector3f(1, 0, 0)) - FVector3f(1, 0, 0);
+	const FVector3f RotY = Params.SkelCompMoveRotation.RotateVector(FVector3f(0, 1, 0)) - FVector3f(0, 1, 0);
+	const FVector3f RotZ = Params.SkelCompMoveRotation.RotateVector(FVector3f(0, 0, 1)) - FVector3f(0, 0, 1);
+	const FVector3f GravityStep = 0.5f * Params.GravityCS * Params.DeltaTime * Params.DeltaTime;
+
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float InvDeltaTimeOld = VectorSetFloat1(1.0f / Params.DeltaTimeOld);
+	const VectorRegister4Float DeltaTime = VectorSetFloat1(Params.DeltaTime);
+	const VectorRegister4Float MoveX = VectorSetFloat1(Params.SkelCompMoveVector.X);
+	const VectorRegister4Float MoveY = VectorSetFloat1(Params.SkelCompMoveVector.Y);
+	const VectorRegister4Float MoveZ = VectorSetFloat1(Params.SkelCompMoveVector.Z);
+	const VectorRegister4Float R00 = VectorSetFloat1(RotX.X), R01 = VectorSetFloat1(RotY.X), R02 = VectorSetFloat1(RotZ.X);
+	const VectorRegister4Float R10 = VectorSetFloat1(RotX.Y), R11 = VectorSetFloat1(RotY.Y), R12 = VectorSetFloat1(RotZ.Y);
+	const VectorRegister4Float R20 = VectorSetFloat1(RotX.Z), R21 = VectorSetFloat1(RotY.Z), R22 = VectorSetFloat1(RotZ.Z);
+	const VectorRegister4Float GravityX = VectorSetFloat1(GravityStep.X);
+	const VectorRegister4Float GravityY = VectorSetFloat1(GravityStep.Y);
+	const VectorRegister4Float GravityZ = VectorSetFloat1(GravityStep.Z);
+
+	// Velocity, damping, wind, follow translation / rotation and gravity are independent per bone
+	for (int32 Slot = Begin; Slot < End; Slot += BatchSize)
+	{
+		const VectorRegister4Float Mask = VectorLoad(&Active[Slot]);
+		const VectorRegister4Float LX = VectorLoad(&LocX[Slot]);
+		const VectorRegister4Float LY = VectorLoad(&LocY[Slot]);
+		const VectorRegister4Float LZ = VectorLoad(&LocZ[Slot]);
+		const VectorRegister4Float PX = VectorLoad(&PrevX[Slot]);
+		const VectorRegister4Float PY = VectorLoad(&PrevY[Slot]);
+		const VectorRegister4Float PZ = VectorLoad(&PrevZ[Slot]);
+
+		// Move using Velocity( = movement amount in pre frame ) and Damping
+		const VectorRegister4Float VelocityScale =
+			VectorMultiply(InvDeltaTimeOld, VectorSubtract(One, VectorLoad(&Damping[Slot])));
+		VectorRegister4Float VX = VectorMultiply(VectorSubtract(LX, PX), VelocityScale);
+		VectorRegister4Float VY = VectorMultiply(VectorSubtract(LY, PY), VelocityScale);
+		VectorRegister4Float VZ = VectorMultiply(VectorSubtract(LZ, PZ), VelocityScale);
+		if (Params.bUseWind)
+		{
+			VX = VectorAdd(VX, VectorLoad(&WindX[Slot]));
+			VY = VectorAdd(VY, VectorLoad(&WindY[Slot]));
+			VZ = VectorAdd(VZ, VectorLoad(&WindZ[Slot]));
+		}
+		VectorRegister4Float NX = VectorMultiplyAdd(VX, DeltaTime, LX);
+		VectorRegister4Float NY = VectorMultiplyAdd(VY, DeltaTime, LY);
+		VectorRegister4Float NZ = VectorMultiplyAdd(VZ, DeltaTime, LZ);
+
+		// Follow Translation
+		const VectorRegister4Float FollowLocation = VectorSubtract(One, VectorLoad(&WorldDampingLocation[Slot]));
+		NX = VectorMultiplyAdd(MoveX, FollowLocation, NX);
+		NY = VectorMultiplyAdd(MoveY, FollowLocation, NY);
+		NZ = VectorMultiplyAdd(MoveZ, FollowLocation, NZ);
+
+		// Follow Rotation
+		const VectorRegister4Float FollowRotation = VectorSubtract(One, VectorLoad(&WorldDampingRotation[Slot]));
+		const VectorRegister4Float RX = VectorMultiplyAdd(R00, LX, VectorMultiplyAdd(R01, LY, VectorMultiply(R02, LZ)));
+		const VectorRegister4Float RY = VectorMultiplyAdd(R10, LX, VectorMultiplyAdd(R11, LY, VectorMultiply(R12, LZ)));
+		const VectorRegister4Float RZ = VectorMultiplyAdd(R20, LX, VectorMultiplyAdd(R21, LY, VectorMultiply(R22, LZ)));
+		NX = VectorMultiplyAdd(RX, FollowRotation, NX);
+		NY = VectorMultiplyAdd(RY, FollowRotation, NY);
+		NZ = VectorMultiplyAdd(RZ, FollowRotation, NZ);
+
+		// Gravity
+		NX = VectorAdd(NX, GravityX);
+		NY = VectorAdd(NY, GravityY);
+		NZ = VectorAdd(NZ, GravityZ);
+
+		// Commit only active lanes : Prev = Loc, Loc = New
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(LX, PX), PX), &PrevX[Slot]);
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(LY, PY), PY), &PrevY[Slot]);
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(LZ, PZ), PZ), &PrevZ[Slot]);
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NX, LX), LX), &LocX[Slot]);
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NY, LY), LY), &LocY[Slot]);
+		VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NZ, LZ), LZ), &LocZ[Slot]);
+	}
+
+	// Pull to Pose Location. Needs the already integrated parent, so go level by level
+	for (int32 Level = 1; Level + 1 < LevelStarts.Num(); ++Level)
+	{
+		for (int32 Slot = LevelStarts[Level]; Slot < LevelStarts[Level + 1]; Slot += BatchSize)
+		{
+			const int32* Parents = &ParentSlots[Slot];
+			const VectorRegister4Float Rate = VectorMultiply(VectorLoad(&Active[Slot]), VectorLoad(&FollowRate[Slot]));
+
+			const VectorRegister4Float LX = VectorLoad(&LocX[Slot]);
+			const VectorRegister4Float LY = VectorLoad(&LocY[Slot]);
+			const VectorRegister4Float LZ = VectorLoad(&LocZ[Slot]);
+			const VectorRegister4Float BaseX = VectorAdd(KawaiiPhysicsSolver::GatherLanes(LocX, Parents),
+			                                             VectorLoad(&PoseDeltaX[Slot]));
+			const VectorRegister4Float BaseY = VectorAdd(KawaiiPhysicsSolver::GatherLanes(LocY, Parents),
+			                                             VectorLoad(&PoseDeltaY[Slot]));
+			const VectorRegister4Float BaseZ = VectorAdd(KawaiiPhysicsSolver::GatherLanes(LocZ, Parents),
+			                                             VectorLoad(&PoseDeltaZ[Slot]));
+
+			VectorStore(VectorMultiplyAdd(VectorSubtract(BaseX, LX), Rate, LX), &LocX[Slot]);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(BaseY, LY), Rate, LY), &LocY[Slot]);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(BaseZ, LZ), Rate, LZ), &LocZ[Slot]);
+		}
+	}
+}
+
+void FKawaiiPhysicsSolver::AdjustByLimitsAndRestoreLength()
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverRestoreLength);
+
+	using namespace KawaiiPhysicsSolver;
+
+	const VectorRegister4Float SafeNormalThreshold = VectorSetFloat1(UE_SMALL_NUMBER);
+
+	for (int32 Level = 1; Level + 1 < LevelStarts.Num(); ++Level)
+	{
+		const int32 LevelBegin = LevelStarts[Level];
+		const int32 LevelEnd = LevelStarts[Level + 1];
+
+		// Angle limit and planar constraint are rare and branchy, keep them scalar
+		if (bAnyAngleLimit || bPlanarConstraint)
+		{
+			for (int32 Slot = LevelBegin; Slot < LevelEnd; ++Slot)
+			{
+				if (Active[Slot] == 0.0f)
+				{
+					continue;
+				}
+
+				const int32 ParentSlot = ParentSlots[Slot];
+				const FVector3f ParentLocation = Load(LocX, LocY, LocZ, ParentSlot);
+				FVector3f Location = Load(LocX, LocY, LocZ, Slot);
+
+				// Adjust by angle limit
+				if (LimitAngle[Slot] != 0.0f)
+				{
+					FVector3f BoneDir = (Location - ParentLocation).GetSafeNormal();
+					const FVector3f PoseDir = Load(PoseDeltaX, PoseDeltaY, PoseDeltaZ, Slot).GetSafeNormal();
+					const FVector3f Axis = FVector3f::CrossProduct(PoseDir, BoneDir);
+					const float Angle = FMath::Atan2(Axis.Size(), FVector3f::DotProduct(PoseDir, BoneDir));
+					const float AngleOverLimit = FMath::RadiansToDegrees(Angle) - LimitAngle[Slot];
+					if (AngleOverLimit > 0.0f)
+					{
+						BoneDir = BoneDir.RotateAngleAxis(-AngleOverLimit, Axis.GetSafeNormal());
+						Location = BoneDir * (Location - ParentLocation).Size() + ParentLocation;
+					}
+				}
+
+				// Adjust by Planar Constraint
+				if (bPlanarConstraint)
+				{
+					const FVector3f PlaneNormal = Load(PlaneNormalX, PlaneNormalY, PlaneNormalZ, Slot);
+					Location -= PlaneNormal * FVector3f::DotProduct(Location - ParentLocation, PlaneNormal);
+				}
+
+				Store(LocX, LocY, LocZ, Slot, Location);
+			}
+		}
+
+		// Restore Bone Length
+		for (int32 Slot = LevelBegin; Slot < LevelEnd; Slot += BatchSize)
+		{
+			const int32* Parents = &ParentSlots[Slot];
+			const VectorRegister4Float ParentX = GatherLanes(LocX, Parents);
+			const VectorRegister4Float ParentY = GatherLanes(LocY, Parents);
+			const VectorRegister4Float ParentZ = GatherLanes(LocZ, Parents);
+			const VectorRegister4Float LX = VectorLoad(&LocX[Slot]);
+			const VectorRegister4Float LY = VectorLoad(&LocY[Slot]);
+			const VectorRegister4Float LZ = VectorLoad(&LocZ[Slot]);
+
+			const VectorRegister4Float DX = VectorSubtract(LX, ParentX);
+			const VectorRegister4Float DY = VectorSubtract(LY, ParentY);
+			const VectorRegister4Float DZ = VectorSubtract(LZ, ParentZ);
+			const VectorRegister4Float SizeSquared =
+				VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+
+			// GetSafeNormal() * BoneLength, zero when the bone collapsed onto its parent
+			const VectorRegister4Float Valid = VectorCompareGE(SizeSquared, SafeNormalThreshold);
+			const VectorRegister4Float Scale = VectorSelect(
+				Valid, VectorDivide(VectorLoad(&PoseLength[Slot]), VectorSqrt(SizeSquared)), VectorZeroFloat());
+
+			const VectorRegister4Float Mask = VectorLoad(&Active[Slot]);
+			const VectorRegister4Float NX = VectorMultiplyAdd(DX, Scale, ParentX);
+			const VectorRegister4Float NY = VectorMultiplyAdd(DY, Scale, ParentY);
+			const VectorRegister4Float NZ = VectorMultiplyAdd(DZ, Scale, ParentZ);
+			VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NX, LX), LX), &LocX[Slot]);
+			VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NY, LY), LY), &LocY[Slot]);
+			VectorStore(VectorMultiplyAdd(Mask, VectorSubtract(NZ, LZ), LZ), &LocZ[Slot]);
+		}
+	}
+}
+
+void FKawaiiPhysicsConstraintSolver::Reset()
+{
+	ConstraintIndices.Reset();
+	Bone1.Reset();
+	Bone2.Reset();
+	ColorStarts.Reset();
+	BoneIndices.Reset();
+}
+
+void FKawaiiPhysicsConstraintSolver::Build(const TArray<FModifyBoneConstraint>& Constraints,
+                                           TConstArrayView<int32> InConstraintIndices)
+{
+	Reset();
+	if (InConstraintIndices.Num() == 0)
+	{
+		return;
+	}
+
+	// Local bones, in order of first use
+	TMap<int32, int32> LocalBones;
+	auto GetLocalBone = [&](int32 BoneIndex)
+	{
+		if (const int32* LocalBone = LocalBones.Find(BoneIndex))
+		{
+			return *LocalBone;
+		}
+		return LocalBones.Add(BoneIndex, BoneIndices.Add(BoneIndex));
+	};
+
+	// Greedy colouring : first colour that uses neither bone
+	TArray<TBitArray<>> ColorBones;
+	TArray<TArray<int32>> ColorConstraints;
+	TArray<int32> LocalEnds;
+	LocalEnds.Reserve(InConstraintIndices.Num() * 2);
+	for (const int32 ConstraintIndex : InConstraintIndices)
+	{
+		const FModifyBoneConstraint& Constraint = Constraints[ConstraintIndex];
+		LocalEnds.Add(GetLocalBone(Constraint.ModifyBoneIndex1));
+		LocalEnds.Add(GetLocalBone(Constraint.ModifyBoneIndex2));
+	}
+	const int32 NumLocalBones = BoneIndices.Num();
+	for (int32 i = 0; i < InConstraintIndices.Num(); ++i)
+	{
+		const int32 LocalBone1 = LocalEnds[i * 2];
+		const int32 LocalBone2 = LocalEnds[i * 2 + 1];
+
+		int32 Color = 0;
+		while (Color < ColorBones.Num() && (ColorBones[Color][LocalBone1] || ColorBones[Color][LocalBone2]))
+		{
+			++Color;
+		}
+		if (Color == ColorBones.Num())
+		{
+			ColorBones.Emplace(false, NumLocalBones);
+			ColorConstraints.AddDefaulted();
+		}
+		ColorBones[Color][LocalBone1] = true;
+		ColorBones[Color][LocalBone2] = true;
+		ColorConstraints[Color].Add(i);
+	}
+
+	// Padded lanes, colour by colour. Padding lanes use the scratch bone
+	const int32 ScratchBone = BoneIndices.Add(INDEX_NONE);
+	for (const TArray<int32>& Lanes : ColorConstraints)
+	{
+		ColorStarts.Add(ConstraintIndices.Num());
+		for (const int32 i : Lanes)
+		{
+			ConstraintIndices.Add(InConstraintIndices[i]);
+			Bone1.Add(LocalEnds[i * 2]);
+			Bone2.Add(LocalEnds[i * 2 + 1]);
+		}
+		while (ConstraintIndices.Num() % BatchSize != 0)
+		{
+			ConstraintIndices.Add(INDEX_NONE);
+			Bone1.Add(ScratchBone);
+			Bone2.Add(ScratchBone);
+		}
+	}
+	ColorStarts.Add(ConstraintIndices.Num());
+
+	const int32 NumLanes = ConstraintIndices.Num();
+	Active.SetNumZeroed(NumLanes);
+	RestLength.SetNumZeroed(NumLanes);
+	Compliance.SetNumZeroed(NumLanes);
+	Lambda.SetNumZeroed(NumLanes);
+	LocX.SetNumZeroed(BoneIndices.Num());
+	LocY.SetNumZeroed(BoneIndices.Num());
+	LocZ.SetNumZeroed(BoneIndices.Num());
+}
+
+void FKawaiiPhysicsConstraintSolver::Gather(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones,
+                                            const TArray<FModifyBoneConstraint>& Constraints,
+                                            TConstArrayView<float> ComplianceValues, int32 GlobalComplianceType)
+{
+	using namespace KawaiiPhysicsSolver;
+
+	for (int32 LocalBone = 0; LocalBone < BoneIndices.Num(); ++LocalBone)
+	{
+		const int32 BoneIndex = BoneIndices[LocalBone];
+		Store(LocX, LocY, LocZ, LocalBone,
+		      BoneIndex >= 0 ? FVector3f(ModifyBones[BoneIndex].Location) : FVector3f::ZeroVector);
+	}
+
+	for (int32 Lane = 0; Lane < Num(); ++Lane)
+	{
+		Lambda[Lane] = 0.0f;
+
+		const int32 ConstraintIndex = ConstraintIndices[Lane];
+		if (ConstraintIndex == INDEX_NONE || !Constraints[ConstraintIndex].IsValid())
+		{
+			Active[Lane] = 0.0f;
+			RestLength[Lane] = 0.0f;
+			Compliance[Lane] = 0.0f;
+			continue;
+		}
+
+		const FModifyBoneConstraint& Constraint = Constraints[ConstraintIndex];
+		const int32 ComplianceType = Constraint.bOverrideCompliance
+			                             ? static_cast<int32>(Constraint.ComplianceType)
+			                             : GlobalComplianceType;
+		Active[Lane] = 1.0f;
+		RestLength[Lane] = Constraint.Length;
+		Compliance[Lane] = ComplianceValues[ComplianceType];
+	}
+}
+
+void FKawaiiPhysicsConstraintSolver::Solve(float DeltaTime, int32 Iterations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_SolverBoneConstraint);
+
+	using namespace KawaiiPhysicsSolver;
+
+	if (Num() == 0 || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	const VectorRegister4Float InvDeltaTimeSquared = VectorSetFloat1(1.0f / (DeltaTime * DeltaTime));
+	const VectorRegister4Float Two = VectorSetFloat1(2.0f); // SumMass
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (int32 Color = 0; Color + 1 < ColorStarts.Num(); ++Color)
+		{
+			for (int32 Lane = ColorStarts[Color]; Lane < ColorStarts[Color + 1]; Lane += BatchSize)
+			{
+				const int32* Ends1 = &Bone1[Lane];
+				const int32* Ends2 = &Bone2[Lane];
+				const VectorRegister4Float X1 = GatherLanes(LocX, Ends1);
+				const VectorRegister4Float Y1 = GatherLanes(LocY, Ends1);
+				const VectorRegister4Float Z1 = GatherLanes(LocZ, Ends1);
+				const VectorRegister4Float X2 = GatherLanes(LocX, Ends2);
+				const VectorRegister4Float Y2 = GatherLanes(LocY, Ends2);
+				const VectorRegister4Float Z2 = GatherLanes(LocZ, Ends2);
+
+				const VectorRegister4Float DX = VectorSubtract(X2, X1);
+				const VectorRegister4Float DY = VectorSubtract(Y2, Y1);
+				const VectorRegister4Float DZ = VectorSubtract(Z2, Z1);
+				const VectorRegister4Float DeltaLength =
+					VectorSqrt(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ))));
+
+				// XPBD, skipped for collapsed constraints and padding
+				const VectorRegister4Float Valid = VectorBitwiseAnd(
+					VectorCompareGT(DeltaLength, Zero), VectorCompareGT(VectorLoad(&Active[Lane]), Zero));
+				const VectorRegister4Float LambdaLanes = VectorLoad(&Lambda[Lane]);
+				const VectorRegister4Float Alpha = VectorMultiply(VectorLoad(&Compliance[Lane]), InvDeltaTimeSquared);
+				const VectorRegister4Float Constraint = VectorSubtract(DeltaLength, VectorLoad(&RestLength[Lane]));
+				const VectorRegister4Float DeltaLambda = VectorSelect(
+					Valid,
+					VectorDivide(VectorNegateMultiplyAdd(Alpha, LambdaLanes, Constraint), VectorAdd(Two, Alpha)),
+					Zero);
+				const VectorRegister4Float Scale = VectorSelect(Valid, VectorDivide(DeltaLambda, DeltaLength), Zero);
+
+				const VectorRegister4Float MoveX = VectorMultiply(DX, Scale);
+				const VectorRegister4Float MoveY = VectorMultiply(DY, Scale);
+				const VectorRegister4Float MoveZ = VectorMultiply(DZ, Scale);
+
+				// Bones are unique within a colour, so the lanes never write the same bone (except the scratch one)
+				ScatterLanes(LocX, Ends1, VectorAdd(X1, MoveX));
+				ScatterLanes(LocY, Ends1, VectorAdd(Y1, MoveY));
+				ScatterLanes(LocZ, Ends1, VectorAdd(Z1, MoveZ));
+				ScatterLanes(LocX, Ends2, VectorSubtract(X2, MoveX));
+				ScatterLanes(LocY, Ends2, VectorSubtract(Y2, MoveY));
+				ScatterLanes(LocZ, Ends2, VectorSubtract(Z2, MoveZ));
+				VectorStore(VectorAdd(LambdaLanes, DeltaLambda), &Lambda[Lane]);
+			}
+		}
+	}
+}
+
+void FKawaiiPhysicsConstraintSolver::Scatter(TArray<FKawaiiPhysicsModifyBone>& ModifyBones) const
+{
+	using namespace KawaiiPhysicsSolver;
+
+	for (int32 LocalBone = 0; LocalBone < BoneIndices.Num(); ++LocalBone)
+	{
+		const int32 BoneIndex = BoneIndices[LocalBone];
+		if (BoneIndex >= 0)
+		{
+			ModifyBones[BoneIndex].Location = FVector(Load(LocX, LocY, LocZ, LocalBone));
+		}
+	}
+}
@@ -0,0 +1,104 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsWorldCollision.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/HitResult.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_WorldCollision"), STAT_KawaiiPhysics_WorldCollision, STATGROUP_Anim);
+DECLARE_CYCLE_STAT(TEXT("KawaiiPhysics_WorldCollisionBoundsTest"), STAT_KawaiiPhysics_WorldCollisionBoundsTest,
+                   STATGROUP_Anim);
+
+void FKawaiiPhysicsWorldCollisionBatch::Reset()
+{
+	Sweeps.Reset();
+	Contacts.Reset();
+	Bounds = FBox(ForceInit);
+}
+
+void FKawaiiPhysicsWorldCollisionBatch::AddSweep(int32 BoneIndex, const FVector& Start, const FVector& End,
+                                                 float Radius)
+{
+	FKawaiiPhysicsWorldSweep& Sweep = Sweeps.AddDefaulted_GetRef();
+	Sweep.BoneIndex = BoneIndex;
+	Sweep.Start = Start;
+	Sweep.End = End;
+	Sweep.Radius = Radius;
+
+	const FVector Extent(Radius);
+	Bounds += FBox(Start.ComponentMin(End) - Extent, Start.ComponentMax(End) + Extent);
+}
+
+void FKawaiiPhysicsWorldCollisionBatch::Execute(const UWorld* World, const FKawaiiPhysicsWorldCollisionQuery& InQuery)
+{
+	SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollision);
+
+	Contacts.Reset();
+	if (!World || Sweeps.Num() == 0 || !Bounds.IsValid)
+	{
+		return;
+	}
+
+	// Every sweep lies inside Bounds : nothing blocking there means no sweep can hit
+	{
+		SCOPE_CYCLE_COUNTER(STAT_KawaiiPhysics_WorldCollisionBoundsTest);
+		if (!World->OverlapBlockingTestByChannel(Bounds.GetCenter(), FQuat::Identity, InQuery.TraceChannel,
+		                                         FCollisionShape::MakeBox(Bounds.GetExtent()), InQuery.Params,
+		                                         InQuery.ResponseParams))
+		{
+			return;
+		}
+	}
+
+	auto AddContact = [this](const FKawaiiPhysicsWorldSweep& Sweep, const FHitResult& Hit)
+	{
+		FKawaiiPhysicsWorldContact& Contact = Contacts.AddDefaulted_GetRef();
+		Contact.BoneIndex = Sweep.BoneIndex;
+		Contact.Normal = Hit.Normal;
+		Contact.Location = Hit.bStartPenetrating ? Sweep.End + Hit.Normal * Hit.PenetrationDepth : Hit.Location;
+	};
+
+	TArray<FHitResult> Results;
+	for (const FKawaiiPhysicsWorldSweep& Sweep : Sweeps)
+	{
+		const FCollisionShape Shape = FCollisionShape::MakeSphere(Sweep.Radius);
+
+		if (InQuery.bIgnoreSelfComponent)
+		{
+			// Do sphere sweep
+			FHitResult Result;
+			if (World->SweepSingleByChannel(Result, Sweep.Start, Sweep.End, FQuat::Identity, InQuery.TraceChannel,
+			                                Shape, InQuery.Params, InQuery.ResponseParams))
+			{
+				AddContact(Sweep, Result);
+			}
+			continue;
+		}
+
+		// Do sphere sweep and ignore bones later
+		Results.Reset();
+		if (World->SweepMultiByChannel(Results, Sweep.Start, Sweep.End, FQuat::Identity, InQuery.TraceChannel,
+		                               Shape, InQuery.Params, InQuery.ResponseParams))
+		{
+			for (const FHitResult& Hit : Results)
+			{
+				if (!Hit.bBlockingHit)
+				{
+					continue;
+				}
+
+				//should we ignore this hit?
+				if (Hit.Component == InQuery.OwningComp && Hit.BoneName != NAME_None &&
+					InQuery.IsIgnoredBody(Hit.Item, Sweep.BoneIndex))
+				{
+					continue;
+				}
+
+				//found the blocking hit we shouldn't ignore!
+				AddContact(Sweep, Hit);
+				break;
+			}
+		}
+	}
+}
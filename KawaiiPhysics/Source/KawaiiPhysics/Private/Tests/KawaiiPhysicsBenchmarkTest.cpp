@@ -0,0 +1,92 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#include "KawaiiPhysicsBenchmark.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace KawaiiPhysicsBenchmarkTest
+{
+	/**
+	 * Golden hashes of the configurations below, recorded on headless Linux (-nullrhi). A change that alters the
+	 * simulation on purpose must update them. 0 means not recorded yet : only the run to run check is done and the
+	 * hash to record is logged.
+	 */
+	constexpr uint32 GoldenSolver = 0x00000000;
+	constexpr uint32 GoldenSolverExternalForce = 0x00000000;
+	constexpr uint32 GoldenLegacy = 0x00000000;
+	constexpr uint32 GoldenLegacyExternalForce = 0x00000000;
+
+	bool RunConfiguration(FAutomationTestBase& Test, bool bUseSolver, bool bExternalForce, uint32 GoldenHash)
+	{
+		FKawaiiPhysicsBenchmarkSettings Settings;
+		Settings.NumChains = 8;
+		Settings.BonesPerChain = 8;
+		Settings.NumLimits = 4;
+		Settings.NumSteps = 120;
+		Settings.bUseSolver = bUseSolver;
+		Settings.bExternalForce = bExternalForce;
+
+		const FKawaiiPhysicsBenchmarkResult Result = FKawaiiPhysicsBenchmark::Run(Settings);
+		const FKawaiiPhysicsBenchmarkResult Repeated = FKawaiiPhysicsBenchmark::Run(Settings);
+
+		if (Repeated.Hash != Result.Hash)
+		{
+			Test.AddError(FString::Printf(TEXT("Hash differs between two runs : %08x, %08x"), Result.Hash,
+			                              Repeated.Hash));
+		}
+		Test.AddInfo(FString::Printf(
+			TEXT("%d bones, %d islands : Total %.3f ms, Broadphase %.3f, Integrate %.3f, Collision %.3f, BoneConstraint %.3f, LimitsAndBoneLength %.3f"),
+			Result.NumBones, Result.NumIslands, Result.TotalMs, Result.BroadphaseMs, Result.IntegrateMs,
+			Result.CollisionMs, Result.BoneConstraintMs, Result.LimitsAndBoneLengthMs));
+
+		if (GoldenHash == 0)
+		{
+			Test.AddInfo(FString::Printf(TEXT("No golden hash recorded, current hash %08x"), Result.Hash));
+		}
+		else if (Result.Hash != GoldenHash)
+		{
+			Test.AddError(FString::Printf(TEXT("Hash %08x does not match golden hash %08x"), Result.Hash,
+			                              GoldenHash));
+		}
+		return !Test.HasAnyErrors();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsDeterminismSolverTest, "Plugins.KawaiiPhysics.Determinism.Solver",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsDeterminismSolverTest::RunTest(const FString& Parameters)
+{
+	return KawaiiPhysicsBenchmarkTest::RunConfiguration(*this, true, false, KawaiiPhysicsBenchmarkTest::GoldenSolver);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsDeterminismSolverExternalForceTest,
+                                 "Plugins.KawaiiPhysics.Determinism.SolverExternalForce",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsDeterminismSolverExternalForceTest::RunTest(const FString& Parameters)
+{
+	return KawaiiPhysicsBenchmarkTest::RunConfiguration(*this, true, true,
+	                                                    KawaiiPhysicsBenchmarkTest::GoldenSolverExternalForce);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsDeterminismLegacyTest, "Plugins.KawaiiPhysics.Determinism.Legacy",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsDeterminismLegacyTest::RunTest(const FString& Parameters)
+{
+	return KawaiiPhysicsBenchmarkTest::RunConfiguration(*this, false, false, KawaiiPhysicsBenchmarkTest::GoldenLegacy);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKawaiiPhysicsDeterminismLegacyExternalForceTest,
+                                 "Plugins.KawaiiPhysics.Determinism.LegacyExternalForce",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKawaiiPhysicsDeterminismLegacyExternalForceTest::RunTest(const FString& Parameters)
+{
+	return KawaiiPhysicsBenchmarkTest::RunConfiguration(*this, false, true,
+	                                                    KawaiiPhysicsBenchmarkTest::GoldenLegacyExternalForce);
+}
+
+#endif
@@ -9,6 +9,12 @@
 
 #include "BoneControllers/AnimNode_AnimDynamics.h"
 #include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "KawaiiPhysicsSignificanceSubsystem.h"
+#include "KawaiiPhysicsSolver.h"
+#include "KawaiiPhysicsWorldCollision.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
 
 #if	ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
 #include "StructUtils/InstancedStruct.h"
@@ -21,11 +27,15 @@
 class UKawaiiPhysics_CustomExternalForce;
 class UKawaiiPhysicsLimitsDataAsset;
 class UKawaiiPhysicsBoneConstraintsDataAsset;
+struct FKawaiiPhysicsSimulateContext;
+struct FKawaiiPhysicsStageCycles;
 
 #if ENABLE_ANIM_DEBUG
 extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsEnable;
 extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsDebug;
 extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsDebugLengthRate;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsUseSolver;
+extern KAWAIIPHYSICS_API TAutoConsoleVariable<bool> CVarAnimNodeKawaiiPhysicsParallelIslands;
 #endif
 
 
@@ -557,6 +567,39 @@ struct FModifyBoneConstraint
 	}
 };
 
+/**
+ * Float shared between the anim worker thread and the game thread. Copies load and store the value, so the node
+ * that holds it stays copyable.
+ */
+struct FKawaiiPhysicsAtomicFloat
+{
+	FKawaiiPhysicsAtomicFloat() = default;
+
+	FKawaiiPhysicsAtomicFloat(const FKawaiiPhysicsAtomicFloat& Other)
+		: Value(Other.Load())
+	{
+	}
+
+	FKawaiiPhysicsAtomicFloat& operator=(const FKawaiiPhysicsAtomicFloat& Other)
+	{
+		Store(Other.Load());
+		return *this;
+	}
+
+	float Load() const
+	{
+		return Value.load(std::memory_order_relaxed);
+	}
+
+	void Store(float NewValue)
+	{
+		Value.store(NewValue, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<float> Value{0.0f};
+};
+
 USTRUCT(BlueprintType)
 struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalControlBase
 {
@@ -672,6 +715,49 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 		meta = (PinHiddenByDefault))
 	bool ResetBoneTransformWhenBoneNotFound = false;
 
+	/** 
+	* 独立したボーン群（BoneConstraintで繋がっていないRootBoneのチェーン）のボーン数がこの値以上の場合、並列にシミュレーションする。0で無効
+	* Independent bone islands (root chains not joined by bone constraints) with at least this many bones are simulated in parallel. 0 disables.
+	* Ignored while any ExternalForce is enabled.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, ClampMin = "0"))
+	int32 ParallelSimulationBoneThreshold = 32;
+
+	/** 
+	* 固定タイムステップでシミュレーションする。経過時間を蓄積してFixedTimeStepRateごとにサブステップを実行し、直近2ステップの結果を補間して出力する
+	* Simulate with a fixed time step. Frame time is accumulated, substeps run at FixedTimeStepRate
+	* and the output pose is interpolated between the last two steps, so stiffness and constraints do not depend on the framerate.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault))
+	bool bUseFixedTimeStep = false;
+
+	/** 
+	* 固定タイムステップの頻度（Hz）
+	* Rate of the fixed time step (Hz)
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, EditCondition = "bUseFixedTimeStep", ClampMin = "1"))
+	float FixedTimeStepRate = 60.0f;
+
+	/** 
+	* 1回の評価で実行するサブステップの最大数。超えた分の時間は破棄される
+	* Maximum number of substeps per evaluation. Accumulated time beyond it is dropped
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault, EditCondition = "bUseFixedTimeStep", ClampMin = "1"))
+	int32 MaxSubSteps = 4;
+
+	/** 
+	* 有効な場合、SignificanceManager（a.AnimNode.KawaiiPhysics.Significance）が画面上の大きさと処理予算に応じて品質を下げる
+	* When the significance manager is enabled (a.AnimNode.KawaiiPhysics.Significance), let it lower the quality of this node
+	* by screen size, visibility and the global budget (see EKawaiiPhysicsSignificanceTier)
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Settings", AdvancedDisplay,
+		meta = (PinHiddenByDefault))
+	bool bUseSignificance = true;
+
 	UPROPERTY()
 	UCurveFloat* DampingCurve_DEPRECATED = nullptr;
 	UPROPERTY()
@@ -945,6 +1031,15 @@ struct KAWAIIPHYSICS_API FAnimNode_KawaiiPhysics : public FAnimNode_SkeletalCont
 	UPROPERTY(EditAnywhere, Category = "World Collision", meta = (EditCondition = "!bIgnoreSelfComponent"))
 	TArray<FName> IgnoreBoneNamePrefix;
 
+	/** 
+	* WorldCollisionのスイープをタスクで実行し、結果を1フレーム遅れて適用する。ゲームスレッド/アニメーションスレッドの負荷を下げる代わりに高速な動きでは貫通しやすくなる
+	* Run the WorldCollision sweeps on a task and apply their contacts one step later, as planes the bones are pushed out of.
+	* Removes the sweeps from the animation evaluation at the cost of some tunneling with fast motion.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Collision",
+		meta = (PinHiddenByDefault, EditCondition = "bAllowWorldCollision"))
+	bool bWorldCollisionOneFrameLatency = false;
+
 	/** 
 	* ExternalForceなどで使用するフィルタリング用タグ
 	* Tag for filtering of ExternalForce etc
@@ -993,7 +1088,105 @@ protected:
 	 */
 	bool bResetDynamics;
 
+	/**
+	 * Bone name -> ModifyBones index of every bone except dummy bones. Built with ModifyBones.
+	 */
+	TMap<FName, int32> ModifyBoneIndices;
+
+	/**
+	 * Children of every reference skeleton bone in ascending order, built once per InitModifyBones:
+	 * the children of bone i are RefSkeletonChildren[RefSkeletonChildOffsets[i] .. RefSkeletonChildOffsets[i + 1]).
+	 */
+	TArray<int32> RefSkeletonChildOffsets;
+	TArray<int32> RefSkeletonChildren;
+
+	/**
+	 * Component space pose transform of every ModifyBone (of the parent for dummy bones), indexed like ModifyBones.
+	 * Fetched once per evaluation for the external forces, empty while no enabled force needs it.
+	 */
+	TArray<FTransform> ExternalForceBoneTransforms;
+
+	/**
+	 * Output order of ApplySimulateResult : ModifyBones indices of the bones present in the compact pose, sorted by
+	 * compact pose index, and the compact pose index of each. Dummy bones and bones missing in the LOD are left out.
+	 */
+	TArray<int32> OutputBoneOrder;
+	TArray<FCompactPoseBoneIndex> OutputCompactPoseIndices;
+
+	/** ModifyBones index -> index in OutputBoneOrder, INDEX_NONE for bones not output. Empty until built */
+	TArray<int32> OutputBoneSlots;
+
+	/** Serial number of the bone container the output order was built for */
+	uint16 OutputBoneContainerSerial = 0;
+
+	/**
+	 * Independent groups of ModifyBones, each with its own SoA solver. Built with ModifyBones / MergedBoneConstraints.
+	 */
+	TArray<FKawaiiPhysicsIsland> Islands;
+
+	/**
+	 * Bounds of all enabled collision limits, rebuilt every evaluation after the limits are updated.
+	 */
+	FKawaiiPhysicsBroadphase CollisionBroadphase;
+
+	/**
+	 * World collision settings shared by all sweeps of one step.
+	 */
+	FKawaiiPhysicsWorldCollisionQuery WorldCollisionQuery;
+
+	/**
+	 * Sweeps of the previous step running on LatentWorldCollisionTask (bWorldCollisionOneFrameLatency).
+	 */
+	TSharedPtr<FKawaiiPhysicsWorldCollisionBatch, ESPMode::ThreadSafe> LatentWorldCollision;
+	UE::Tasks::FTask LatentWorldCollisionTask;
+
+	/**
+	 * World space wind at the component, sampled in PreUpdate. Used by islands without their own sample.
+	 */
+	FVector WindVelocity = FVector::ZeroVector;
+
+	/**
+	 * Phase of the per-bone gust noise applied to the sampled wind.
+	 */
+	float WindGustPhase = 0.0f;
+
+	/**
+	 * Frame time not simulated yet (bUseFixedTimeStep).
+	 */
+	float FixedTimeStepAccumulator = 0.0f;
+
+	/**
+	 * Location - PoseLocation of each bone after the second to last and the last fixed step.
+	 * The output pose is the current pose plus these offsets interpolated by the remaining accumulated time.
+	 */
+	TArray<FVector> FixedStepPrevOffsets;
+	TArray<FVector> FixedStepOffsets;
+
+	/**
+	 * Simulated locations kept aside while the interpolated pose is applied.
+	 */
+	TArray<FVector> FixedStepSimulatedLocations;
+
+	/**
+	 * Update interval * 2 + bUseFixedTimeStep of the last evaluation. The fixed step state is reset when it changes.
+	 */
+	int32 LastSimulationPath = INDEX_NONE;
+
+	/**
+	 * Quality tier assigned by UKawaiiPhysicsSignificanceSubsystem, read in PreUpdate.
+	 */
+	EKawaiiPhysicsSignificanceTier SignificanceTier = EKawaiiPhysicsSignificanceTier::Full;
+
+	/**
+	 * Duration of the last evaluation in milliseconds, reported to the significance manager.
+	 * Written on the anim worker thread, read in PreUpdate on the game thread.
+	 */
+	FKawaiiPhysicsAtomicFloat LastEvaluationCostMs;
+
 public:
+	/** Drives the island passes on synthetic bones (a.AnimNode.KawaiiPhysics.Benchmark) */
+	friend struct FKawaiiPhysicsBenchmark;
+
 	FAnimNode_KawaiiPhysics();
 
 	// FAnimNode_Base interface
@@ -1065,6 +1258,20 @@ protected:
 	 */
 	void InitBoneConstraints();
 
+	/**
+	 * Finds the ModifyBones index of a bone through ModifyBoneIndices.
+	 *
+	 * @param BoneRef The bone to find.
+	 * @return The ModifyBones index, or INDEX_NONE if the bone is not simulated.
+	 */
+	int32 FindModifyBoneIndex(const FBoneReference& BoneRef) const;
+
+	/**
+	 * Partitions ModifyBones into independent islands (root chains joined by MergedBoneConstraints)
+	 * and builds the SoA solver of each island.
+	 */
+	void InitIslands();
+
 	/**
 	 * Applies the data asset to LimitData.
 	 *
@@ -1173,6 +1380,11 @@ protected:
 	void UpdatePlanerLimits(TArray<FPlanarLimit>& Limits, FComponentSpacePoseContext& Output,
 	                        const FBoneContainer& BoneContainer, const FTransform& ComponentTransform);
 
+	/**
+	 * Rebuilds CollisionBroadphase from the inline limits and *LimitsData.
+	 */
+	void UpdateCollisionBroadphase();
+
 	/**
 	 * Updates the pose transform for all modified bones.
 	 *
@@ -1190,35 +1402,170 @@ protected:
 
 	/**
 	 * Simulates the physics for all modified bones.
+	 * Setup runs once; integration, collisions and constraints run NumSubSteps times with DeltaTime each,
+	 * and the component movement is split evenly between the substeps.
 	 *
 	 * @param Output The pose context.
 	 * @param ComponentTransform The component transform.
+	 * @param NumSubSteps Number of steps to simulate.
 	 */
 	void SimulateModifyBones(FComponentSpacePoseContext& Output,
-	                         const FTransform& ComponentTransform);
+	                         const FTransform& ComponentTransform, int32 NumSubSteps = 1);
 
 	/**
-	 * Simulates the physics for a single bone.
+	 * First part of SimulateModifyBones : roots follow the pose, the others are flagged for simulation, and the
+	 * external forces run PreApply with the time of all substeps.
 	 *
-	 * @param Bone The bone to simulate.
-	 * @param Scene The scene interface.
+	 * @param SkelComp The owning component, passed to the forces.
+	 * @param NumSubSteps Number of steps about to be simulated.
+	 */
+	void BeginSimulateModifyBones(const USkeletalMeshComponent* SkelComp, int32 NumSubSteps);
+
+	/**
+	 * Fills the values shared by the island passes, including the significance tier gating.
+	 *
+	 * @param Context The context to fill.
+	 * @param SkelComp The owning component.
+	 * @param bUseSolver Use the SoA solver (a.AnimNode.KawaiiPhysics.UseSolver).
+	 */
+	void InitSimulateContext(FKawaiiPhysicsSimulateContext& Context, const USkeletalMeshComponent* SkelComp,
+	                         bool bUseSolver) const;
+
+	/**
+	 * Runs the island passes NumSubSteps times, in parallel when the islands allow it, and the external forces'
+	 * PostApply after the last one.
+	 *
+	 * @param Context Values shared by all islands.
+	 * @param NumSubSteps Number of steps to simulate.
+	 * @param StageCycles Optional, accumulates the cycles of each pass.
+	 */
+	void SimulateSubSteps(const FKawaiiPhysicsSimulateContext& Context, int32 NumSubSteps,
+	                      FKawaiiPhysicsStageCycles* StageCycles = nullptr);
+
+	/**
+	 * Fixed time step mode: accumulates the frame time, simulates the whole steps it contains and
+	 * applies the result interpolated between (or extrapolated from) the last two steps.
+	 *
+	 * @param Output The pose context.
+	 * @param BoneContainer The bone container.
 	 * @param ComponentTransform The component transform.
+	 * @param OutBoneTransforms An array to store the resulting bone transforms.
+	 * @param StepRate Steps per second.
+	 * @param bExtrapolate Extrapolate from the last step instead of interpolating the last two (no added latency).
+	 */
+	void SimulateFixedTimeStep(FComponentSpacePoseContext& Output, const FBoneContainer& BoneContainer,
+	                           FTransform& ComponentTransform, TArray<FBoneTransform>& OutBoneTransforms,
+	                           float StepRate, bool bExtrapolate);
+
+	/**
+	 * Integrates a single bone : velocity, wind, component movement and gravity.
+	 * External forces and the pull to the pose follow for the whole island (ApplyExternalForces, PullToPose).
+	 *
+	 * @param Bone The bone to simulate.
+	 * @param WindVelocityCS Wind of the bone's island in component space (zero without wind).
 	 * @param GravityCS The gravity vector in component space.
-	 * @param Exponent The exponent for the simulation.
+	 */
+	void Simulate(FKawaiiPhysicsModifyBone& Bone, const FVector& WindVelocityCS, const FVector& GravityCS);
+
+	/**
+	 * Applies every enabled external force to a span of bones, one batch per force.
+	 *
+	 * @param BoneIndices ModifyBones indices of the bones, parents first.
 	 * @param SkelComp The skeletal mesh component.
 	 * @param Output The pose context.
 	 */
-	void Simulate(FKawaiiPhysicsModifyBone& Bone, const FSceneInterface* Scene, const FTransform& ComponentTransform,
-	              const FVector& GravityCS, const float& Exponent, const USkeletalMeshComponent* SkelComp,
-	              FComponentSpacePoseContext& Output);
+	void ApplyExternalForces(TConstArrayView<int32> BoneIndices, const USkeletalMeshComponent* SkelComp,
+	                         FComponentSpacePoseContext& Output);
 
 	/**
-	 * Adjusts the bone position based on world collision.
+	 * Pulls a bone towards its pose location relative to its (already simulated) parent by its stiffness.
 	 *
 	 * @param Bone The bone to adjust.
+	 * @param Exponent The exponent for the simulation.
+	 */
+	void PullToPose(FKawaiiPhysicsModifyBone& Bone, float Exponent);
+
+	/**
+	 * Fills ExternalForceBoneTransforms from the pose when an enabled force needs bone transforms, empties it otherwise.
+	 *
+	 * @param Output The pose context.
+	 */
+	void UpdateExternalForceBoneTransforms(FComponentSpacePoseContext& Output);
+
+	/**
+	 * Checks whether the SoA solver can integrate the bones (external forces need the per-bone path).
+	 *
+	 * @return True if no external force is enabled.
+	 */
+	bool CanUseSolverIntegration() const;
+
+	/**
+	 * Simulates the bones of one island, with the SoA solver when possible.
+	 *
+	 * @param Island The island to simulate.
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void SimulateIsland(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context);
+
+	/**
+	 * Adjusts the bones of one island by collision limits and world collision.
+	 *
+	 * @param Island The island to adjust.
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void AdjustIslandByCollisions(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context);
+
+	/**
+	 * Resets and iterates the bone constraints of one island.
+	 *
+	 * @param Island The island to adjust.
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void AdjustIslandByBoneConstraints(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context);
+
+	/**
+	 * Adjusts the bones of one island by angle limit and planar constraint, then restores bone length.
+	 *
+	 * @param Island The island to adjust.
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void AdjustIslandByLimitsAndBoneLength(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context);
+
+	/**
+	 * Builds WorldCollisionQuery from the node settings and the owning component.
+	 *
 	 * @param OwningComp The owning skeletal mesh component.
 	 */
-	void AdjustByWorldCollision(FKawaiiPhysicsModifyBone& Bone, const USkeletalMeshComponent* OwningComp);
+	void UpdateWorldCollisionQuery(const USkeletalMeshComponent* OwningComp);
+
+	/**
+	 * Resolves IgnoreBones / IgnoreBoneNamePrefix and the bodies of ModifyBones into body indices of PhysicsAsset,
+	 * so that filtering a world collision hit does not touch bone names.
+	 *
+	 * @param PhysicsAsset The physics asset of the owning component.
+	 */
+	void ResolveWorldCollisionIgnoredBodies(const UPhysicsAsset* PhysicsAsset);
+
+	/**
+	 * Adjusts the bones of one island by world collision: sweeps them as one batch,
+	 * or pushes them out of the contacts found one step earlier (bWorldCollisionOneFrameLatency).
+	 *
+	 * @param Island The island to adjust.
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void AdjustIslandByWorldCollision(FKawaiiPhysicsIsland& Island, const FKawaiiPhysicsSimulateContext& Context);
+
+	/**
+	 * Waits for the sweeps launched by the previous step (bWorldCollisionOneFrameLatency).
+	 */
+	void WaitForLatentWorldCollision();
+
+	/**
+	 * Launches the sweeps of all simulated bones on a task. Their contacts are applied in the next step.
+	 *
+	 * @param Context Values shared by all islands in this step.
+	 */
+	void LaunchLatentWorldCollision(const FKawaiiPhysicsSimulateContext& Context);
 
 	/**
 	 * Adjusts the bone position based on spherical collision limits.
@@ -1227,6 +1574,7 @@ protected:
 	 * @param Limits An array of spherical limits.
 	 */
 	void AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FSphericalLimit>& Limits);
+	void AdjustBySphereCollision(FKawaiiPhysicsModifyBone& Bone, const FSphericalLimit& Sphere);
 
 	/**
 	 * Adjusts the bone position based on capsule collision limits.
@@ -1235,6 +1583,7 @@ protected:
 	 * @param Limits An array of capsule limits.
 	 */
 	void AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FCapsuleLimit>& Limits);
+	void AdjustByCapsuleCollision(FKawaiiPhysicsModifyBone& Bone, const FCapsuleLimit& Capsule);
 
 	/**
 	 * Adjusts the bone position based on box collision limits.
@@ -1243,6 +1592,7 @@ protected:
 	 * @param Limits An array of box limits.
 	 */
 	void AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FBoxLimit>& Limits);
+	void AdjustByBoxCollision(FKawaiiPhysicsModifyBone& Bone, const FBoxLimit& Box);
 
 	/**
 	 * Adjusts the bone position based on planar collision limits.
@@ -1251,6 +1601,15 @@ protected:
 	 * @param Limits An array of planar limits.
 	 */
 	void AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, TArray<FPlanarLimit>& Limits);
+	void AdjustByPlanerCollision(FKawaiiPhysicsModifyBone& Bone, const FPlanarLimit& Planar);
+
+	/**
+	 * Adjusts the bone position by one collision limit registered in CollisionBroadphase.
+	 *
+	 * @param Bone The bone to adjust.
+	 * @param Proxy The broadphase proxy of the limit.
+	 */
+	void AdjustByCollisionLimit(FKawaiiPhysicsModifyBone& Bone, const FKawaiiPhysicsLimitProxy& Proxy);
 
 	/**
 	 * Adjusts the bone position based on angle limits.
@@ -1272,8 +1631,10 @@ protected:
 
 	/**
 	 * Adjusts the bone positions based on bone constraints.
+	 *
+	 * @param ConstraintIndices Indices of MergedBoneConstraints to solve.
 	 */
-	void AdjustByBoneConstraints();
+	void AdjustByBoneConstraints(const TArray<int32>& ConstraintIndices);
 
 	/**
 	 * Applies the simulation results to the bone transforms.
@@ -1285,6 +1646,13 @@ protected:
 	void ApplySimulateResult(FComponentSpacePoseContext& Output, const FBoneContainer& BoneContainer,
 	                         TArray<FBoneTransform>& OutBoneTransforms);
 
+	/**
+	 * Builds OutputBoneOrder, OutputCompactPoseIndices and OutputBoneSlots for the bone container.
+	 *
+	 * @param BoneContainer The bone container.
+	 */
+	void InitOutputBoneOrder(const FBoneContainer& BoneContainer);
+
 	/**
 	 * Warms up the simulation by running it for a specified number of frames.
 	 *
@@ -1296,15 +1664,20 @@ protected:
 	            FTransform& ComponentTransform);
 
 	/**
-	 * Gets the wind velocity for a given bone.
+	 * Samples the wind of the scene for the node and each island. Game thread only (called from PreUpdate).
 	 *
-	 * @param Scene The scene interface.
-	 * @param ComponentTransform The component transform.
-	 * @param Bone The bone to get the wind velocity for.
+	 * @param SkelComp The skeletal mesh component.
+	 */
+	void SampleWind(const USkeletalMeshComponent* SkelComp);
+
+	/**
+	 * Gets the wind velocity for a given bone: the wind of its island with a deterministic gust.
+	 *
+	 * @param WindVelocityCS Wind of the bone's island in component space, scaled by WindScale.
+	 * @param BoneIndex ModifyBones index of the bone.
 	 * @return The wind velocity vector.
 	 */
-	FVector GetWindVelocity(const FSceneInterface* Scene, const FTransform& ComponentTransform,
-	                        const FKawaiiPhysicsModifyBone& Bone) const;
+	FVector GetWindVelocity(const FVector& WindVelocityCS, int32 BoneIndex) const;
 
 #if ENABLE_ANIM_DEBUG
 	void AnimDrawDebug(const FComponentSpacePoseContext& Output);
@@ -0,0 +1,74 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Synthetic scene simulated by FKawaiiPhysicsBenchmark.
+ */
+struct FKawaiiPhysicsBenchmarkSettings
+{
+	/** Number of chains, hanging side by side */
+	int32 NumChains = 16;
+
+	/** Bones per chain, including the root */
+	int32 BonesPerChain = 16;
+
+	/** Number of collision limits (alternately spheres and capsules) placed over the chains */
+	int32 NumLimits = 8;
+
+	/** Connect the bones of neighbouring chains with bone constraints (joins all chains into one island) */
+	bool bBoneConstraints = true;
+
+	/** Add a Basic external force (switches the integration to the per-bone path) */
+	bool bExternalForce = false;
+
+	/** Use the SoA solver, same as a.AnimNode.KawaiiPhysics.UseSolver */
+	bool bUseSolver = true;
+
+	/** Number of simulated steps */
+	int32 NumSteps = 300;
+
+	/** Delta time of every step */
+	float DeltaTime = 1.0f / 60.0f;
+};
+
+/**
+ * Time spent in each stage of FKawaiiPhysicsBenchmark::Run, and a hash of the final bone locations.
+ */
+struct FKawaiiPhysicsBenchmarkResult
+{
+	double BroadphaseMs = 0.0;
+	double IntegrateMs = 0.0;
+	double CollisionMs = 0.0;
+	double BoneConstraintMs = 0.0;
+	double LimitsAndBoneLengthMs = 0.0;
+	double TotalMs = 0.0;
+
+	/** Hash of the final bone locations. Equal for equal settings on the same build and platform */
+	uint32 Hash = 0;
+
+	int32 NumBones = 0;
+	int32 NumIslands = 0;
+	int32 NumConstraints = 0;
+};
+
+/**
+ * Headless benchmark and regression check of the KawaiiPhysics solver.
+ *
+ * スケルタルメッシュもワールドも使わずに合成したチェーンでソルバーを実行し、段階ごとの時間と結果のハッシュを出力する
+ * Builds chains of bones directly in a FAnimNode_KawaiiPhysics, without a skeletal mesh, an anim instance or a
+ * world, and steps it with the node's own BeginSimulateModifyBones, InitSimulateContext and SimulateSubSteps (the
+ * core of SimulateModifyBones, with its tier gating and island scheduling) for a fixed number of steps with a
+ * deterministic component motion. The pose, world collision and wind are not used. When islands run in parallel,
+ * their whole pass is counted in IntegrateMs.
+ *
+ * Run from the console (also with -nullrhi -ExecCmds) :
+ * a.AnimNode.KawaiiPhysics.Benchmark [Chains] [BonesPerChain] [Limits] [Steps] [Forces] [UseSolver] [ExpectedHash]
+ * An error is logged when ExpectedHash (hex) is given and does not match.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBenchmark
+{
+	static FKawaiiPhysicsBenchmarkResult Run(const FKawaiiPhysicsBenchmarkSettings& Settings);
+};
@@ -6,6 +6,7 @@
 #include "AnimNode_KawaiiPhysics.h"
 #include "Engine/DataAsset.h"
 #include "Interfaces/Interface_BoneReferenceSkeletonProvider.h"
+#include "UObject/ObjectKey.h"
 #include "KawaiiPhysicsBoneConstraintsDataAsset.generated.h"
 
 /**
@@ -108,7 +109,17 @@ public:
 	virtual USkeleton* GetSkeleton(bool& bInvalidSkeletonIsError, const IPropertyHandle* PropertyHandle) override;
 
 	/** Generates bone constraints based on the current data */
-	TArray<FModifyBoneConstraint> GenerateBoneConstraints();
+	TArray<FModifyBoneConstraint> GenerateBoneConstraints() const;
+
+	/**
+	 * Bone constraints whose bones both exist in Skeleton, with the bone references resolved for it.
+	 * Generated once per skeleton and shared by every node using this asset with that skeleton. Thread safe.
+	 */
+	TSharedRef<const TArray<FModifyBoneConstraint>, ESPMode::ThreadSafe> GetCompiledBoneConstraints(
+		const USkeleton* Skeleton) const;
+
+	/** Discards the compiled bone constraints. Needed after changing BoneConstraintsData outside of the editor */
+	void InvalidateCompiledBoneConstraints();
 
 #if WITH_EDITOR
 
@@ -121,5 +132,14 @@ public:
 
 	/** Handles property changes in the editor */
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	virtual void PostEditUndo() override;
 #endif
+
+private:
+	mutable FCriticalSection CompiledBoneConstraintsLock;
+
+	/** Output of GetCompiledBoneConstraints per skeleton */
+	mutable TMap<TObjectKey<USkeleton>, TSharedRef<const TArray<FModifyBoneConstraint>, ESPMode::ThreadSafe>>
+	CompiledBoneConstraints;
 };
@@ -0,0 +1,108 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FKawaiiPhysicsModifyBone;
+struct FCollisionLimitBase;
+struct FSphericalLimit;
+struct FCapsuleLimit;
+struct FBoxLimit;
+struct FPlanarLimit;
+
+/**
+ * Shape of a collision limit registered in the broadphase.
+ */
+enum class EKawaiiPhysicsLimitShape : uint8
+{
+	Sphere,
+	Capsule,
+	Box,
+	Planar,
+};
+
+/**
+ * Component space bounds of one collision limit.
+ */
+struct FKawaiiPhysicsLimitProxy
+{
+	/** Bounds of the limit shape (not inflated by bone radius) */
+	FBox Bounds = FBox(ForceInit);
+
+	/** The limit. Valid until the limit arrays are modified (the broadphase is rebuilt every evaluation) */
+	const FCollisionLimitBase* Limit = nullptr;
+
+	/** Shape of Limit */
+	EKawaiiPhysicsLimitShape Shape = EKawaiiPhysicsLimitShape::Sphere;
+
+	/** Inner spherical limits and planar limits can affect a bone anywhere, so they are never culled */
+	bool bAlwaysTest = false;
+};
+
+/**
+ * Limits each group of bones may touch in the current step.
+ * Chunk i covers BoneIndices[ChunkBoneStarts[i], ChunkBoneStarts[i + 1]) of the owning island,
+ * and its candidates are Candidates[CandidateStarts[i], CandidateStarts[i + 1]) in proxy order.
+ */
+struct FKawaiiPhysicsCollisionCandidates
+{
+	/** Bounds of the simulated bone locations of each chunk */
+	TArray<FBox> ChunkBounds;
+
+	TArray<int32> ChunkBoneStarts;
+	TArray<int32> CandidateStarts;
+	TArray<int32> Candidates;
+
+	void Reset()
+	{
+		ChunkBounds.Reset();
+		ChunkBoneStarts.Reset();
+		CandidateStarts.Reset();
+		Candidates.Reset();
+	}
+};
+
+/**
+ * Broadphase for collision limits (inline limits and *LimitsData).
+ *
+ * 毎評価ごとにリミットのバウンディングボックスを作り、近くのボーン群だけが詳細判定を行う
+ * Proxies are registered in the same order as the narrowphase used to run (spheres, capsules, boxes, planes;
+ * inline limits before data asset limits), so culling never changes the order in which pushes are applied.
+ * Bones are grouped in chunks of consecutive ModifyBones (neighbours along a chain), each chunk keeps the
+ * proxies overlapping its bounds, and each bone then rejects proxies whose bounds are farther than its radius.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsBroadphase
+{
+	/** Number of consecutive bones sharing a candidate list */
+	static constexpr int32 ChunkSize = 8;
+
+	TArray<FKawaiiPhysicsLimitProxy> Proxies;
+
+	/** Clears all proxies. Call before registering the limits of this evaluation */
+	void Reset();
+
+	void AddSphericalLimits(const TArray<FSphericalLimit>& Limits);
+	void AddCapsuleLimits(const TArray<FCapsuleLimit>& Limits);
+	void AddBoxLimits(const TArray<FBoxLimit>& Limits);
+	void AddPlanarLimits(const TArray<FPlanarLimit>& Limits);
+
+	/**
+	 * Builds the per-chunk candidate lists for a set of bones from their current locations.
+	 *
+	 * @param ModifyBones All modify bones of the node.
+	 * @param BoneIndices Bones to collide, in narrowphase order.
+	 * @param OutCandidates Reused output.
+	 */
+	void BuildCandidates(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones, const TArray<int32>& BoneIndices,
+	                     FKawaiiPhysicsCollisionCandidates& OutCandidates) const;
+
+	/**
+	 * Whether a bone sphere may touch the limit. False means the narrowphase would not move the bone.
+	 */
+	static bool MayTouch(const FKawaiiPhysicsLimitProxy& Proxy, const FVector& Location, float Radius)
+	{
+		return Proxy.bAlwaysTest ||
+			Proxy.Bounds.ComputeSquaredDistanceToPoint(Location) <= FMath::Square(Radius + UE_KINDA_SMALL_NUMBER);
+	}
+};
@@ -36,6 +36,23 @@ public:
 	{
 	}
 
+	/**
+	 * Applies the force to a span of bones (an island, parents first) in one call.
+	 * The default implementation calls Apply for each bone; override it in C++ to evaluate the force once per batch.
+	 *
+	 * @param BoneIndices ModifyBones indices of the bones.
+	 * @param BoneTransforms Component space pose transform of each ModifyBone (of the parent for dummy bones),
+	 *                       indexed like ModifyBones.
+	 */
+	virtual void ApplyBatch(FAnimNode_KawaiiPhysics& Node, TConstArrayView<int32> BoneIndices,
+	                        const USkeletalMeshComponent* SkelComp, TConstArrayView<FTransform> BoneTransforms)
+	{
+		for (const int32 BoneIndex : BoneIndices)
+		{
+			Apply(Node, BoneIndex, SkelComp, BoneTransforms[BoneIndex]);
+		}
+	}
+
 	UFUNCTION(BlueprintCallable, Category="KawaiiPhysics|CustomExternalForce")
 	virtual bool IsDebugEnabled()
 	{
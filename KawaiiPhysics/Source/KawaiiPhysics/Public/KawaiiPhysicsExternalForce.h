@@ -6,6 +6,8 @@
 #include "Curves/CurveVector.h"
 #include "KawaiiPhysicsExternalForce.generated.h"
 
+class FSceneInterface;
+
 /**
  * Enum representing the space in which external forces are simulated.
  */
@@ -135,6 +137,26 @@ public:
 	{
 	}
 
+	/**
+	 * Applies the external force to a span of bones (an island, parents first) in one call.
+	 * The default implementation calls Apply for each bone. Forces override it to evaluate their parameters
+	 * once per batch and apply them in a tight loop.
+	 *
+	 * @param BoneIndices ModifyBones indices of the bones.
+	 * @param BoneTransforms Component space pose transform of each ModifyBone (of the parent for dummy bones),
+	 *                       indexed like ModifyBones. Only filled while a bone space or custom force is enabled.
+	 */
+	virtual void ApplyBatch(TConstArrayView<int32> BoneIndices, TConstArrayView<FTransform> BoneTransforms,
+	                        FAnimNode_KawaiiPhysics& Node, const FComponentSpacePoseContext& PoseContext)
+	{
+		const bool bBoneSpace = ExternalForceSpace == EExternalForceSpace::BoneSpace;
+		for (const int32 BoneIndex : BoneIndices)
+		{
+			Apply(Node.ModifyBones[BoneIndex], Node, PoseContext,
+			      bBoneSpace ? BoneTransforms[BoneIndex] : FTransform::Identity);
+		}
+	}
+
 	/** Finalizes the external force after applying it */
 	virtual void PostApply(FAnimNode_KawaiiPhysics& Node)
 	{
@@ -251,8 +273,14 @@ struct KAWAIIPHYSICS_API FKawaiiPhysics_ExternalForce_Basic : public FKawaiiPhys
 	virtual void Apply(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
 	                   const FComponentSpacePoseContext& PoseContext,
 	                   const FTransform& BoneTM = FTransform::Identity) override;
+	virtual void ApplyBatch(TConstArrayView<int32> BoneIndices, TConstArrayView<FTransform> BoneTransforms,
+	                        FAnimNode_KawaiiPhysics& Node, const FComponentSpacePoseContext& PoseContext) override;
 
 private:
+	/** Moves one bone that passed the filters */
+	void ApplyToBone(FKawaiiPhysicsModifyBone& Bone, const FAnimNode_KawaiiPhysics& Node, float ForceRate,
+	                 const FTransform& BoneTM);
+
 	/** Current time */
 	UPROPERTY()
 	float Time = 0.0f;
@@ -319,6 +347,13 @@ struct KAWAIIPHYSICS_API FKawaiiPhysics_ExternalForce_Gravity : public FKawaiiPh
 	virtual void Apply(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
 	                   const FComponentSpacePoseContext& PoseContext,
 	                   const FTransform& BoneTM = FTransform::Identity) override;
+	virtual void ApplyBatch(TConstArrayView<int32> BoneIndices, TConstArrayView<FTransform> BoneTransforms,
+	                        FAnimNode_KawaiiPhysics& Node, const FComponentSpacePoseContext& PoseContext) override;
+
+private:
+	/** Moves one bone that passed the filters */
+	void ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+	                 const FComponentSpacePoseContext& PoseContext, float ForceRate);
 };
 
 ///
@@ -407,6 +442,13 @@ public:
 	virtual void Apply(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
 	                   const FComponentSpacePoseContext& PoseContext,
 	                   const FTransform& BoneTM = FTransform::Identity) override;
+	virtual void ApplyBatch(TConstArrayView<int32> BoneIndices, TConstArrayView<FTransform> BoneTransforms,
+	                        FAnimNode_KawaiiPhysics& Node, const FComponentSpacePoseContext& PoseContext) override;
+
+private:
+	/** Moves one bone that passed the filters */
+	void ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+	                 const FComponentSpacePoseContext& PoseContext, float ForceRate, const FTransform& BoneTM);
 };
 
 ///
@@ -445,4 +487,11 @@ public:
 	virtual void Apply(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
 	                   const FComponentSpacePoseContext& PoseContext,
 	                   const FTransform& BoneTM = FTransform::Identity) override;
+	virtual void ApplyBatch(TConstArrayView<int32> BoneIndices, TConstArrayView<FTransform> BoneTransforms,
+	                        FAnimNode_KawaiiPhysics& Node, const FComponentSpacePoseContext& PoseContext) override;
+
+private:
+	/** Samples the scene wind at one bone that passed the filters and moves it */
+	void ApplyToBone(FKawaiiPhysicsModifyBone& Bone, FAnimNode_KawaiiPhysics& Node,
+	                 const FComponentSpacePoseContext& PoseContext, const FSceneInterface& Scene, float ForceRate);
 };
@@ -0,0 +1,98 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "KawaiiPhysicsSignificanceSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ * Quality tier of the KawaiiPhysics nodes of one SkeletalMeshComponent.
+ */
+UENUM(BlueprintType)
+enum class EKawaiiPhysicsSignificanceTier : uint8
+{
+	/** Full quality */
+	Full,
+	/** Half update rate (extrapolated), no world collision, at most one bone constraint iteration */
+	Reduced,
+	/** Quarter update rate (extrapolated), no world collision, no bone constraints */
+	Low,
+	/** Not simulated, the animated pose is output */
+	Frozen,
+};
+
+/**
+ * World level significance manager of KawaiiPhysics.
+ *
+ * 画面上の大きさ・距離・可視性でインスタンスを評価し、フレームあたりの処理時間の予算内で品質段階を割り当てる
+ * KawaiiPhysics nodes register their SkeletalMeshComponent from PreUpdate and report the cost of their last
+ * evaluation. Once per frame the instances are scored by screen size (distance to the closest local view) and
+ * visibility, and tiers are assigned in order of significance so that the estimated cost stays within
+ * a.AnimNode.KawaiiPhysics.Significance.BudgetMs. Nodes read their tier in the next PreUpdate.
+ *
+ * Disabled unless a.AnimNode.KawaiiPhysics.Significance is set, nodes opt out with bUseSignificance.
+ */
+UCLASS()
+class KAWAIIPHYSICS_API UKawaiiPhysicsSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// UTickableWorldSubsystem interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// End of UTickableWorldSubsystem interface
+
+	/** Whether the significance manager is enabled (a.AnimNode.KawaiiPhysics.Significance) */
+	static bool IsEnabled();
+
+	/**
+	 * Registers the component if needed and adds the cost of one node evaluation. Game thread only.
+	 *
+	 * @param Component The component the node belongs to.
+	 * @param CostMs Time of the node's last evaluation in milliseconds.
+	 * @param CostTier Tier the node was evaluated with.
+	 * @return The tier the node should use in this frame.
+	 */
+	EKawaiiPhysicsSignificanceTier UpdateInstance(const USkeletalMeshComponent* Component, float CostMs,
+	                                              EKawaiiPhysicsSignificanceTier CostTier);
+
+	/** Number of registered components */
+	int32 GetNumInstances() const { return Instances.Num(); }
+
+	/** Estimated cost of all instances with the tiers assigned in the last Tick */
+	float GetEstimatedCostMs() const { return EstimatedCostMs; }
+
+	/** Relative cost of a tier compared to Full, used to estimate costs and to scale measured costs back */
+	static float GetTierCostScale(EKawaiiPhysicsSignificanceTier Tier);
+
+private:
+	struct FInstance
+	{
+		TWeakObjectPtr<const USkeletalMeshComponent> Component;
+
+		/** Cost reported in the current frame, scaled to Full quality */
+		float FrameFullCostMs = 0.0f;
+
+		/** Smoothed cost at Full quality */
+		float FullCostMs = 0.0f;
+
+		/** Frame of the last UpdateInstance */
+		uint64 LastUpdateFrame = 0;
+
+		float Significance = 0.0f;
+		EKawaiiPhysicsSignificanceTier Tier = EKawaiiPhysicsSignificanceTier::Full;
+	};
+
+	TArray<FInstance> Instances;
+	TMap<TWeakObjectPtr<const USkeletalMeshComponent>, int32> InstanceIndices;
+
+	/** Instance indices sorted by significance, reused every Tick */
+	TArray<int32> SortedInstances;
+
+	float EstimatedCostMs = 0.0f;
+};
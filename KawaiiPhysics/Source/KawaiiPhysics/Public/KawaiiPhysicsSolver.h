@@ -0,0 +1,251 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KawaiiPhysicsBroadphase.h"
+#include "KawaiiPhysicsWorldCollision.h"
+
+struct FKawaiiPhysicsModifyBone;
+struct FModifyBoneConstraint;
+
+/**
+ * Per-evaluation parameters for FKawaiiPhysicsSolver::Integrate.
+ */
+struct FKawaiiPhysicsSolverParams
+{
+	/** Delta time of this step */
+	float DeltaTime = 0.0f;
+
+	/** Delta time of the previous step (used to recover velocity) */
+	float DeltaTimeOld = 0.0f;
+
+	/** TargetFramerate * DeltaTime, exponent of the stiffness pull */
+	float Exponent = 1.0f;
+
+	/** Gravity in component space */
+	FVector3f GravityCS = FVector3f::ZeroVector;
+
+	/** Movement of the SkeletalMeshComponent since the previous step (component space) */
+	FVector3f SkelCompMoveVector = FVector3f::ZeroVector;
+
+	/** Rotation of the SkeletalMeshComponent since the previous step (component space) */
+	FQuat4f SkelCompMoveRotation = FQuat4f::Identity;
+
+	/** Whether WindX/Y/Z have been filled for this step */
+	bool bUseWind = false;
+};
+
+/**
+ * Structure-of-arrays solver core of FAnimNode_KawaiiPhysics.
+ *
+ * ModifyBonesの中でシミュレーション中に頻繁に読み書きされる値だけを連続した配列に詰め直し、
+ * 深さ（Depth）ごとにSIMD幅単位でまとめて処理する
+ * Keeps the hot per-bone state of ModifyBones in contiguous arrays, sorted by depth from the root.
+ * Each depth level is padded to a multiple of BatchSize so that integration, stiffness pull and
+ * bone length restore can run in SIMD batches while every parent is always finished before its children.
+ *
+ * Slots are solver-local indices; BoneIndices maps a slot to its ModifyBones index (INDEX_NONE for padding).
+ * Only Location / PrevLocation are written back to ModifyBones, which is all ApplySimulateResult needs.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsSolver
+{
+	/** Number of lanes processed per batch */
+	static constexpr int32 BatchSize = 4;
+
+	/** Slot -> ModifyBones index. INDEX_NONE for padding slots */
+	TArray<int32> BoneIndices;
+
+	/** ModifyBones index -> slot (INDEX_NONE for bones of other islands) */
+	TArray<int32> BoneToSlot;
+
+	/** Slot of the parent bone. Padding and root slots point to themselves */
+	TArray<int32> ParentSlots;
+
+	/** Depth level i occupies slots [LevelStarts[i], LevelStarts[i + 1]) */
+	TArray<int32> LevelStarts;
+
+	/** 1.0 if the bone is simulated in this step, 0.0 otherwise (roots, invalid bones, padding) */
+	TArray<float> Active;
+
+	TArray<float> LocX, LocY, LocZ;
+	TArray<float> PrevX, PrevY, PrevZ;
+
+	/** PoseLocation - Parent.PoseLocation */
+	TArray<float> PoseDeltaX, PoseDeltaY, PoseDeltaZ;
+
+	/** |PoseLocation - Parent.PoseLocation|, the length restored at the end of the step */
+	TArray<float> PoseLength;
+
+	TArray<float> Damping;
+	TArray<float> WorldDampingLocation;
+	TArray<float> WorldDampingRotation;
+	TArray<float> Stiffness;
+	TArray<float> Radius;
+	TArray<float> LimitAngle;
+
+	/** Per step: 1 - (1 - Stiffness)^Exponent */
+	TArray<float> FollowRate;
+
+	/** Optional per step wind velocity (already scaled by TargetFramerate) */
+	TArray<float> WindX, WindY, WindZ;
+
+	/** Parent pose axis used by the planar constraint. Filled only when a plane axis is requested */
+	TArray<float> PlaneNormalX, PlaneNormalY, PlaneNormalZ;
+
+	/** Size of the ModifyBones array the layout was built against */
+	int32 NumBones = 0;
+
+	/** Whether any gathered bone has a non-zero LimitAngle */
+	bool bAnyAngleLimit = false;
+
+	/** Whether PlaneNormal arrays are valid for this step */
+	bool bPlanarConstraint = false;
+
+	/** Number of slots including padding */
+	int32 Num() const { return BoneIndices.Num(); }
+
+	/** Whether the layout matches the given ModifyBones */
+	bool IsBuiltFor(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones) const;
+
+	/** Clears the layout */
+	void Reset();
+
+	/**
+	 * Builds the depth-sorted, padded slot layout for a set of ModifyBones.
+	 * InBoneIndices must contain whole chains and list every parent before its children
+	 * (ascending ModifyBones order does, as InitModifyBones stores parents first).
+	 */
+	void Build(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones, TConstArrayView<int32> InBoneIndices);
+
+	/**
+	 * Copies positions, pose deltas, physics settings and skip flags from ModifyBones.
+	 *
+	 * @param PlaneAxis 0 = none, 1/2/3 = X/Y/Z axis of the parent pose rotation (same order as EPlanarConstraint)
+	 */
+	void Gather(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones, int32 PlaneAxis);
+
+	/** Copies only Location from ModifyBones (after passes that run on ModifyBones directly) */
+	void GatherLocations(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones);
+
+	/** Writes Location (and optionally PrevLocation) back to ModifyBones */
+	void ScatterLocations(TArray<FKawaiiPhysicsModifyBone>& ModifyBones, bool bWritePrevLocation) const;
+
+	/** Stores the wind velocity of one slot. Call for every active slot before Integrate with bUseWind */
+	void SetWindVelocity(int32 Slot, const FVector& WindVelocity);
+
+	/**
+	 * Velocity / damping, component movement follow, gravity and stiffness pull.
+	 * Equivalent to FAnimNode_KawaiiPhysics::Simulate without external forces.
+	 */
+	void Integrate(const FKawaiiPhysicsSolverParams& Params);
+
+	/**
+	 * Angle limit, planar constraint and bone length restore, parents first.
+	 */
+	void AdjustByLimitsAndRestoreLength();
+
+private:
+	void AddSlot(int32 BoneIndex, int32 ParentSlot);
+};
+
+/**
+ * Structure-of-arrays XPBD solver for the bone constraints of one island.
+ *
+ * BoneConstraintを、同じボーンを共有しない色（バッチ）に塗り分け、色ごとにSIMD幅単位でまとめて解く
+ * At build time the constraints are graph coloured: constraints of one colour share no bone, so all of
+ * them can be updated at once (Jacobi within a colour, Gauss-Seidel between colours). Each colour is
+ * padded to a multiple of BatchSize and solved in SIMD batches on a local copy of the involved bone locations.
+ *
+ * Constraints are visited colour by colour instead of in MergedBoneConstraints order, so the result
+ * differs slightly from FAnimNode_KawaiiPhysics::AdjustByBoneConstraints while converging the same way.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsConstraintSolver
+{
+	/** Number of lanes processed per batch */
+	static constexpr int32 BatchSize = FKawaiiPhysicsSolver::BatchSize;
+
+	/** Lane -> MergedBoneConstraints index. INDEX_NONE for padding */
+	TArray<int32> ConstraintIndices;
+
+	/** Lane -> local bone of both ends. Padding lanes point to the scratch bone at the end of BoneIndices */
+	TArray<int32> Bone1;
+	TArray<int32> Bone2;
+
+	/** Colour i occupies lanes [ColorStarts[i], ColorStarts[i + 1]) */
+	TArray<int32> ColorStarts;
+
+	/** Local bone -> ModifyBones index. The last entry is INDEX_NONE (scratch bone of padding lanes) */
+	TArray<int32> BoneIndices;
+
+	/** Per lane : 1.0 for valid constraints, 0.0 for padding and invalid constraints */
+	TArray<float> Active;
+	TArray<float> RestLength;
+	TArray<float> Compliance;
+	TArray<float> Lambda;
+
+	/** Per local bone */
+	TArray<float> LocX, LocY, LocZ;
+
+	/** Number of lanes including padding */
+	int32 Num() const { return ConstraintIndices.Num(); }
+
+	/** Clears the layout */
+	void Reset();
+
+	/**
+	 * Colours the given constraints and builds the padded lane layout.
+	 * InConstraintIndices must only reference constraints with valid ModifyBone indices.
+	 */
+	void Build(const TArray<FModifyBoneConstraint>& Constraints, TConstArrayView<int32> InConstraintIndices);
+
+	/**
+	 * Copies bone locations, rest lengths and compliances, and resets Lambda.
+	 *
+	 * @param ComplianceValues Compliance of each EXPBDComplianceType.
+	 * @param GlobalComplianceType Compliance type of constraints without an override.
+	 */
+	void Gather(const TArray<FKawaiiPhysicsModifyBone>& ModifyBones, const TArray<FModifyBoneConstraint>& Constraints,
+	            TConstArrayView<float> ComplianceValues, int32 GlobalComplianceType);
+
+	/** Runs the XPBD iterations */
+	void Solve(float DeltaTime, int32 Iterations);
+
+	/** Writes the bone locations back to ModifyBones */
+	void Scatter(TArray<FKawaiiPhysicsModifyBone>& ModifyBones) const;
+};
+
+/**
+ * Group of ModifyBones that never interact with the rest of the node during simulation:
+ * one or more root chains joined by MergedBoneConstraints.
+ * Islands are independent, so they can be simulated on different threads.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsIsland
+{
+	/** ModifyBones indices, ascending (parents first) */
+	TArray<int32> BoneIndices;
+
+	/** MergedBoneConstraints indices whose both bones belong to this island */
+	TArray<int32> ConstraintIndices;
+
+	/** SoA solver for the bones of this island */
+	FKawaiiPhysicsSolver Solver;
+
+	/** Whether Solver has been gathered in the current step */
+	bool bSolverGathered = false;
+
+	/** Collision limits each chunk of this island may touch in the current step */
+	FKawaiiPhysicsCollisionCandidates CollisionCandidates;
+
+	/** SoA solver for the constraints of ConstraintIndices */
+	FKawaiiPhysicsConstraintSolver ConstraintSolver;
+
+	/** World collision sweeps of this island in the current step */
+	FKawaiiPhysicsWorldCollisionBatch WorldCollisionBatch;
+
+	/** World space wind at the center of this island, sampled on the game thread (FAnimNode_KawaiiPhysics::PreUpdate) */
+	FVector WindVelocity = FVector::ZeroVector;
+
+	/** Whether WindVelocity has been sampled since the island was built */
+	bool bWindSampled = false;
+};
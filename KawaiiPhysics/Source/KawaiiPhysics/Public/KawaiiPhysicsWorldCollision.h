@@ -0,0 +1,120 @@
+// KawaiiPhysics : Copyright (c) 2019-2024 pafuhana1213, MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+
+class UPhysicsAsset;
+class UPrimitiveComponent;
+class UWorld;
+
+/**
+ * Collision settings shared by every world collision sweep of one node in one step.
+ * Built once per evaluation instead of once per bone.
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsWorldCollisionQuery
+{
+	FCollisionQueryParams Params = FCollisionQueryParams(SCENE_QUERY_STAT(KawaiiCollision));
+	FCollisionResponseParams ResponseParams;
+	ECollisionChannel TraceChannel = ECC_WorldDynamic;
+
+	/** Component transform the sweeps are converted with */
+	FTransform CompTransform;
+
+	/** Hits on this component may be filtered by bone (only when bIgnoreSelfComponent is false) */
+	TWeakObjectPtr<const UPrimitiveComponent> OwningComp;
+
+	/** true : single sweep ignoring OwningComp. false : multi sweep, hits on ignored bones of OwningComp are skipped */
+	bool bIgnoreSelfComponent = true;
+
+	/**
+	 * Bodies of OwningComp hits on which are ignored (IgnoreBones / IgnoreBoneNamePrefix), indexed like the
+	 * physics asset bodies. FHitResult::Item of a skeletal mesh hit is the index of the body that was hit.
+	 */
+	TBitArray<> IgnoredBodies;
+
+	/** ModifyBones index -> body index of the bone itself (INDEX_NONE if it has no body) */
+	TArray<int32> BoneBodyIndices;
+
+	/** Physics asset IgnoredBodies / BoneBodyIndices were resolved for */
+	TWeakObjectPtr<const UPhysicsAsset> ResolvedPhysicsAsset;
+
+	/** Size of the ModifyBones array BoneBodyIndices was resolved for. INDEX_NONE forces a new resolve */
+	int32 ResolvedNumBones = INDEX_NONE;
+
+	/** Hash of the IgnoreBones / IgnoreBoneNamePrefix IgnoredBodies was resolved for */
+	uint32 ResolvedIgnoreHash = 0;
+
+	/** Whether a blocking hit on body BodyIndex of OwningComp should be ignored for the sweep of bone BoneIndex */
+	bool IsIgnoredBody(int32 BodyIndex, int32 BoneIndex) const
+	{
+		return (IgnoredBodies.IsValidIndex(BodyIndex) && IgnoredBodies[BodyIndex]) ||
+			(BodyIndex != INDEX_NONE && BoneBodyIndices.IsValidIndex(BoneIndex) &&
+				BoneBodyIndices[BoneIndex] == BodyIndex);
+	}
+};
+
+/**
+ * One sphere sweep of a bone from its previous to its current location (world space).
+ */
+struct FKawaiiPhysicsWorldSweep
+{
+	/** ModifyBones index */
+	int32 BoneIndex = INDEX_NONE;
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	float Radius = 0.0f;
+};
+
+/**
+ * Blocking hit of a sweep, already resolved to the location the bone is pushed to (world space).
+ */
+struct FKawaiiPhysicsWorldContact
+{
+	/** ModifyBones index */
+	int32 BoneIndex = INDEX_NONE;
+
+	/** Location the bone should be moved to */
+	FVector Location = FVector::ZeroVector;
+
+	/** Hit normal. Used as the contact plane when the contact is applied one step late */
+	FVector Normal = FVector::UpVector;
+};
+
+/**
+ * All world collision sweeps of a set of bones, executed together.
+ *
+ * チェーン全体の包囲ボックスで一度だけオーバーラップ判定を行い、ブロッキングするものが無ければ骨ごとのスイープを全て省略する
+ * The swept bounds of all bones are tested with one overlap query first; when nothing blocking is
+ * inside them, no per-bone sweep can hit and all of them are skipped. Otherwise the sweeps run in a
+ * row with the shared query settings, so the result is the same as sweeping each bone separately.
+ *
+ * Execute only reads the world, so a batch can run on a task while the node keeps its results for
+ * the next step (FAnimNode_KawaiiPhysics::bWorldCollisionOneFrameLatency).
+ */
+struct KAWAIIPHYSICS_API FKawaiiPhysicsWorldCollisionBatch
+{
+	TArray<FKawaiiPhysicsWorldSweep> Sweeps;
+
+	/** Output of Execute, in Sweeps order (at most one per sweep) */
+	TArray<FKawaiiPhysicsWorldContact> Contacts;
+
+	/** Union of the swept spheres */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Query settings. Only used by batches that run on a task and must own a copy */
+	FKawaiiPhysicsWorldCollisionQuery Query;
+
+	/** Size of the ModifyBones array the sweeps were gathered from */
+	int32 NumBones = 0;
+
+	/** Clears sweeps and contacts, keeping the allocations */
+	void Reset();
+
+	void AddSweep(int32 BoneIndex, const FVector& Start, const FVector& End, float Radius);
+
+	/** Runs all sweeps against World and fills Contacts */
+	void Execute(const UWorld* World, const FKawaiiPhysicsWorldCollisionQuery& InQuery);
+};
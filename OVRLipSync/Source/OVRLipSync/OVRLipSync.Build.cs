@@ -39,17 +39,16 @@ public class OVRLipSync : ModuleRules
         PublicIncludePaths.Add(Path.Combine(ThirdPartyDirectory, "Include"));
         PublicDependencyModuleNames.AddRange( new string[] { "Core", "CoreUObject", "Engine", "Voice", "AndroidPermission"});
 
+        // Platforms without prebuilt binaries run on the portable reference backend (OVRLipSyncReferenceBackend)
+        bool bWithSDK = Target.Platform == UnrealTargetPlatform.Win64 || Target.Platform == UnrealTargetPlatform.Android;
+        PublicDefinitions.Add("OVRLIPSYNC_WITH_SDK=" + (bWithSDK ? "1" : "0"));
+
         if (Target.Platform == UnrealTargetPlatform.Win64)
         {
             PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "OVRLipSyncShim.lib"));
             PublicDelayLoadDLLs.Add("OVRLipSync.dll");
             RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "OVRLipSync.dll"), StagedFileType.NonUFS);
         }
-        else if (Target.Platform == UnrealTargetPlatform.Mac)
-        {
-            PublicAdditionalLibraries.Add(Path.Combine(LibraryDirectory, "libOVRLipSyncShim.a"));
-            RuntimeDependencies.Add(Path.Combine(LibraryDirectory, "libOVRLipSync.dylib"), StagedFileType.NonUFS);
-        }
         else if (Target.Platform == UnrealTargetPlatform.Android)
         {
             string Android64Directory = Path.Combine(ThirdPartyDirectory, "Lib", "Android", "arm64-v8a");
@@ -4,6 +4,47 @@
 #include "Sound/SoundSubmix.h"
 #include "ISubmixBufferListener.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+static TAutoConsoleVariable<bool> CVarSubmixListenerDebugStats(
+    TEXT("OVRLipSync.SubmixListener.DebugStats"), false,
+    TEXT("Log range / RMS statistics of every submix buffer captured by UAudioSubmixListener"));
+
+namespace
+{
+    // 多相 sinc 滤波器：每个输出样本 16 个抽头，分数位置量化为 64 个相位
+    constexpr int32 ResampleTaps = 16;
+    constexpr int32 ResampleHalfTaps = ResampleTaps / 2;
+    constexpr int32 ResamplePhases = 64;
+    constexpr int32 ResampleHistory = ResampleTaps - 1;
+
+    // 环形缓冲容量（2 的幂，48kHz 下约 0.68 秒）
+    constexpr int32 RingCapacity = 1 << 15;
+    constexpr int32 RingMask = RingCapacity - 1;
+
+    // 预分配的单块最大帧数，更大的块只在第一次出现时扩容
+    constexpr int32 ReservedFrames = 8192;
+
+    void LogAudioStats(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate)
+    {
+        float MinValue = FLT_MAX;
+        float MaxValue = -FLT_MAX;
+        float RMSSum = 0.0f;
+        int32 NonZeroSamples = 0;
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            const float Sample = AudioData[i];
+            MinValue = FMath::Min(MinValue, Sample);
+            MaxValue = FMath::Max(MaxValue, Sample);
+            RMSSum += Sample * Sample;
+            NonZeroSamples += FMath::Abs(Sample) > 0.001f ? 1 : 0;
+        }
+        UE_LOG(LogTemp, Log, TEXT("Submix audio: %d samples, %d channels, %d Hz, range [%.6f, %.6f], RMS %.6f, non-zero %.1f%%"),
+               NumSamples, NumChannels, SampleRate, MinValue, MaxValue, FMath::Sqrt(RMSSum / NumSamples),
+               (float)NonZeroSamples / NumSamples * 100.0f);
+    }
+}
 
 FSubmixBufferListenerImpl::FSubmixBufferListenerImpl(UAudioSubmixListener* InOwner)
     : Owner(InOwner)
@@ -42,6 +83,19 @@ void UAudioSubmixListener::StartListening(USoundSubmix* Submix)
     }
     
     CurrentSubmix = Submix;
+
+    // 缓冲只在第一次开始监听（此前没有任何监听器注册）时在游戏线程分配，之后不再重新分配：
+    // 取消注册是排队到音频渲染线程异步执行的，上一次的监听器此时可能仍在 HandleAudioData 中使用这些缓冲
+    if (Ring.Num() == 0)
+    {
+        ResampleBuffer.Reserve(ResampleHistory + ReservedFrames);
+        FilterCoefficients.Reserve((ResamplePhases + 1) * ResampleTaps);
+        OutputBytes.Reserve(RingCapacity * sizeof(int16));
+        Ring.SetNumZeroed(RingCapacity);
+    }
+
+    // 流状态由音频线程在下一块开始处理前重置
+    bResetRequested.store(true, std::memory_order_release);
     
     // 确保ListenerImpl已创建
     if (!ListenerImpl.IsValid())
@@ -85,201 +139,199 @@ void UAudioSubmixListener::BeginDestroy()
 
 void UAudioSubmixListener::HandleAudioData(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock)
 {
-    if (!AudioData || NumSamples <= 0)
+    if (!AudioData || NumSamples <= 0 || NumChannels <= 0 || SampleRate <= 0)
     {
         return;
     }
 
-    // 分析原始音频数据
-    float MinValue = FLT_MAX;
-    float MaxValue = -FLT_MAX;
-    float RMSSum = 0.0f;
-    int32 NonZeroSamples = 0;
-    
-    for (int32 i = 0; i < NumSamples; ++i)
+    if (bResetRequested.exchange(false, std::memory_order_acquire))
     {
-        float Sample = AudioData[i];
-        MinValue = FMath::Min(MinValue, Sample);
-        MaxValue = FMath::Max(MaxValue, Sample);
-        RMSSum += Sample * Sample;
-        
-        if (FMath::Abs(Sample) > 0.001f) // 考虑浮点精度
-        {
-            NonZeroSamples++;
-        }
+        ResampleInputRate = 0;
+        ResampleOutputRate = 0;
+        RingReadIndex = 0;
+        RingCount = 0;
     }
-    
-    float RMS = FMath::Sqrt(RMSSum / NumSamples);
-    float NonZeroPercentage = (float)NonZeroSamples / NumSamples * 100.0f;
-    
-    UE_LOG(LogTemp, Warning, TEXT("Raw Audio Analysis:"));
-    UE_LOG(LogTemp, Warning, TEXT("  Samples: %d, Channels: %d, SampleRate: %d Hz"), 
-           NumSamples, NumChannels, SampleRate);
-    UE_LOG(LogTemp, Warning, TEXT("  Range: [%.6f, %.6f], RMS: %.6f"), 
-           MinValue, MaxValue, RMS);
-    UE_LOG(LogTemp, Warning, TEXT("  Non-zero samples: %d (%.1f%%)"), 
-           NonZeroSamples, NonZeroPercentage);
-
-    // 只处理有意义的音频数据
-    if (NonZeroSamples == 0)
+
+    // 统计信息只在调试开关打开时计算
+    if (CVarSubmixListenerDebugStats.GetValueOnAnyThread())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Skipping silent audio data"));
-        return;
+        LogAudioStats(AudioData, NumSamples, NumChannels, SampleRate);
     }
 
-    // 转换为单声道
-    TArray<float> MonoData;
-    ConvertToMono(AudioData, NumSamples, NumChannels, MonoData);
-
-    // 验证单声道转换结果
-    float MonoRMS = 0.0f;
-    for (float Sample : MonoData)
+    const int32 OutputSampleRate = TargetSampleRate > 0 ? TargetSampleRate : SampleRate;
+    if (SampleRate != ResampleInputRate || OutputSampleRate != ResampleOutputRate)
     {
-        MonoRMS += Sample * Sample;
+        InitResampler(SampleRate, OutputSampleRate);
     }
-    MonoRMS = FMath::Sqrt(MonoRMS / MonoData.Num());
-    UE_LOG(LogTemp, Warning, TEXT("  Mono RMS: %.6f"), MonoRMS);
 
-    // 重采样并转换为uint8格式
-    TArray<uint8> OutputData;
-    ResampleAudio(MonoData.GetData(), MonoData.Num(), SampleRate, OutputData);
+    // 下混结果直接写在历史样本之后，重采样器可以连续读取跨块的输入
+    const int32 NumFrames = NumSamples / NumChannels;
+    ResampleBuffer.SetNumUninitialized(ResampleHistory + NumFrames, EAllowShrinking::No);
+    DownmixToMono(AudioData, NumFrames, NumChannels, ResampleBuffer.GetData() + ResampleHistory);
 
-    // 验证最终输出数据
-    if (OutputData.Num() > 0)
-    {
-        // 检查前几个样本的值
-        UE_LOG(LogTemp, Warning, TEXT("First few output bytes: %d, %d, %d, %d"), 
-               OutputData.Num() > 0 ? OutputData[0] : 0,
-               OutputData.Num() > 1 ? OutputData[1] : 0,
-               OutputData.Num() > 2 ? OutputData[2] : 0,
-               OutputData.Num() > 3 ? OutputData[3] : 0);
-        
-        OnAudioDataCaptured.Broadcast(OutputData);
-    }
+    ResampleToRing(NumFrames);
+    BroadcastRingChunks(OutputSampleRate);
 }
 
-
-void UAudioSubmixListener::ConvertToMono(const float* InputData, int32 NumSamples, int32 NumChannels, TArray<float>& OutputData)
+void UAudioSubmixListener::DownmixToMono(const float* InputData, int32 NumFrames, int32 NumChannels, float* OutputData)
 {
     if (NumChannels == 1)
     {
         // 已经是单声道
-        OutputData.SetNum(NumSamples);
-        FMemory::Memcpy(OutputData.GetData(), InputData, NumSamples * sizeof(float));
+        FMemory::Memcpy(OutputData, InputData, NumFrames * sizeof(float));
+        return;
+    }
+
+    int32 Frame = 0;
+    if (NumChannels == 2)
+    {
+        // 一次处理 4 帧：(L0 R0 L1 R1)(L2 R2 L3 R3) -> (L0 L1 L2 L3) + (R0 R1 R2 R3)
+        const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+        for (; Frame + 4 <= NumFrames; Frame += 4)
+        {
+            const VectorRegister4Float A = VectorLoad(InputData + Frame * 2);
+            const VectorRegister4Float B = VectorLoad(InputData + Frame * 2 + 4);
+            const VectorRegister4Float Left = VectorShuffle(A, B, 0, 2, 0, 2);
+            const VectorRegister4Float Right = VectorShuffle(A, B, 1, 3, 1, 3);
+            VectorStore(VectorMultiply(VectorAdd(Left, Right), Half), OutputData + Frame);
+        }
     }
-    else
+
+    // 多声道（及双声道剩余的帧）转单声道：取平均值
+    const float Scale = 1.0f / NumChannels;
+    for (; Frame < NumFrames; ++Frame)
+    {
+        const float* Channels = InputData + Frame * NumChannels;
+        float Sum = 0.0f;
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            Sum += Channels[Channel];
+        }
+        OutputData[Frame] = Sum * Scale;
+    }
+}
+
+void UAudioSubmixListener::InitResampler(int32 InputSampleRate, int32 OutputSampleRate)
+{
+    ResampleInputRate = InputSampleRate;
+    ResampleOutputRate = OutputSampleRate;
+    ResampleStep = (double)InputSampleRate / OutputSampleRate;
+
+    // 历史样本视为静音，第一个输出样本的最左抽头对齐缓冲起点
+    ResampleBuffer.SetNumUninitialized(ResampleHistory, EAllowShrinking::No);
+    FMemory::Memzero(ResampleBuffer.GetData(), ResampleHistory * sizeof(float));
+    ResamplePosition = ResampleHalfTaps - 1;
+
+    if (InputSampleRate == OutputSampleRate)
     {
-        // 多声道转单声道：取平均值
-        int32 MonoSamples = NumSamples / NumChannels;
-        OutputData.SetNum(MonoSamples);
+        return;
+    }
 
-        for (int32 i = 0; i < MonoSamples; ++i)
+    // Blackman 窗 sinc 低通，降采样时截止频率随目标奈奎斯特频率降低以抑制混叠
+    const double Cutoff = FMath::Min(1.0, (double)OutputSampleRate / InputSampleRate) * 0.95;
+    FilterCoefficients.SetNumUninitialized((ResamplePhases + 1) * ResampleTaps, EAllowShrinking::No);
+    for (int32 Phase = 0; Phase <= ResamplePhases; ++Phase)
+    {
+        float* Coefficients = FilterCoefficients.GetData() + Phase * ResampleTaps;
+        double Sum = 0.0;
+        for (int32 Tap = 0; Tap < ResampleTaps; ++Tap)
+        {
+            // 抽头与输出位置之间的距离（输入样本为单位）
+            const double Offset = Tap - ResampleHalfTaps + 1 - (double)Phase / ResamplePhases;
+            const double X = UE_DOUBLE_PI * Cutoff * Offset;
+            const double Sinc = FMath::Abs(X) < 1e-9 ? 1.0 : FMath::Sin(X) / X;
+            const double W = FMath::Clamp(Offset / ResampleHalfTaps, -1.0, 1.0);
+            const double Window = 0.42 + 0.5 * FMath::Cos(UE_DOUBLE_PI * W) + 0.08 * FMath::Cos(2.0 * UE_DOUBLE_PI * W);
+            const double Coefficient = Sinc * Window;
+            Coefficients[Tap] = (float)Coefficient;
+            Sum += Coefficient;
+        }
+        // 每个相位归一化为单位增益
+        for (int32 Tap = 0; Tap < ResampleTaps; ++Tap)
         {
-            float Sum = 0.0f;
-            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
-            {
-                Sum += InputData[i * NumChannels + Channel];
-            }
-            OutputData[i] = Sum / NumChannels;
+            Coefficients[Tap] = (float)(Coefficients[Tap] / Sum);
         }
     }
 }
 
-void UAudioSubmixListener::ResampleAudio(const float* InputData, int32 InputSamples, int32 InputSampleRate, TArray<uint8>& OutputData)
+FORCEINLINE void UAudioSubmixListener::WriteToRing(float Sample)
 {
-	// 建议：如果输入采样率是48000，直接使用不要重采样
-	if (InputSampleRate == 48000)
-	{
-		// 直接使用48000Hz，不进行重采样
-		TArray<int16> PCMData;
-		PCMData.SetNum(InputSamples);
-        
-		for (int32 i = 0; i < InputSamples; ++i)
-		{
-			float ClampedValue = FMath::Clamp(InputData[i], -1.0f, 1.0f);
-			PCMData[i] = (int16)(ClampedValue * 32767.0f);
-		}
-        
-		// 转换为字节数组
-		OutputData.SetNum(PCMData.Num() * 2);
-		for (int32 i = 0; i < PCMData.Num(); ++i)
-		{
-			int16 Sample = PCMData[i];
-			OutputData[i * 2] = (uint8)(Sample & 0xFF);
-			OutputData[i * 2 + 1] = (uint8)((Sample >> 8) & 0xFF);
-		}
-        
-		UE_LOG(LogTemp, Log, TEXT("Audio: %d samples at %dHz -> %d bytes"), 
-			   InputSamples, InputSampleRate, OutputData.Num());
-		return;
-	}
-
-    // 检查输入数据范围
-    float MinVal = FLT_MAX, MaxVal = -FLT_MAX;
-    for (int32 i = 0; i < InputSamples; ++i)
+    // 缓冲满时丢弃最旧的样本
+    if (RingCount == RingCapacity)
     {
-        MinVal = FMath::Min(MinVal, InputData[i]);
-        MaxVal = FMath::Max(MaxVal, InputData[i]);
+        RingReadIndex = (RingReadIndex + 1) & RingMask;
+        --RingCount;
     }
-    UE_LOG(LogTemp, VeryVerbose, TEXT("Input audio range: %.6f to %.6f"), MinVal, MaxVal);
+    // 将浮点数 [-1.0, 1.0] 转换为 int16 [-32767, 32767]
+    Ring[(RingReadIndex + RingCount) & RingMask] = (int16)(FMath::Clamp(Sample, -1.0f, 1.0f) * 32767.0f);
+    ++RingCount;
+}
 
-    // 先转换为16-bit PCM格式
-    TArray<int16> PCMData;
-    
-    if (InputSampleRate == TargetSampleRate)
+void UAudioSubmixListener::ResampleToRing(int32 NumFrames)
+{
+    const float* Input = ResampleBuffer.GetData();
+    if (ResampleInputRate == ResampleOutputRate)
     {
         // 不需要重采样，直接转换格式
-        PCMData.SetNum(InputSamples);
-        for (int32 i = 0; i < InputSamples; ++i)
+        for (int32 i = 0; i < NumFrames; ++i)
         {
-            // 将浮点数 [-1.0, 1.0] 转换为 int16 [-32768, 32767]
-            float ClampedValue = FMath::Clamp(InputData[i], -1.0f, 1.0f);
-            PCMData[i] = (int16)(ClampedValue * 32767.0f);
+            WriteToRing(Input[ResampleHistory + i]);
         }
-        UE_LOG(LogTemp, VeryVerbose, TEXT("No resampling needed"));
+        return;
     }
-    else
-    {
-        // 需要重采样
-        float ResampleRatio = (float)TargetSampleRate / InputSampleRate;
-        int32 OutputSamples = FMath::RoundToInt(InputSamples * ResampleRatio);
-        PCMData.SetNum(OutputSamples);
 
-        UE_LOG(LogTemp, Warning, TEXT("Resampling: %d Hz -> %d Hz, %d -> %d samples (ratio: %.3f)"), 
-               InputSampleRate, TargetSampleRate, InputSamples, OutputSamples, ResampleRatio);
+    const int32 BufferEnd = ResampleHistory + NumFrames;
+    for (;;)
+    {
+        const int32 Index = (int32)ResamplePosition;
+        if (Index + ResampleHalfTaps >= BufferEnd)
+        {
+            break;
+        }
+        const int32 Phase = (int32)((ResamplePosition - Index) * ResamplePhases + 0.5);
+        const float* Taps = Input + Index - ResampleHalfTaps + 1;
+        const float* Coefficients = FilterCoefficients.GetData() + Phase * ResampleTaps;
 
-        // 简单的线性插值重采样
-        for (int32 i = 0; i < OutputSamples; ++i)
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Tap = 0; Tap < ResampleTaps; Tap += 4)
         {
-            float InputIndex = i / ResampleRatio;
-            int32 Index0 = FMath::FloorToInt(InputIndex);
-            int32 Index1 = FMath::Min(Index0 + 1, InputSamples - 1);
-            
-            float Fraction = InputIndex - Index0;
-            float InterpolatedValue = FMath::Lerp(InputData[Index0], InputData[Index1], Fraction);
-            
-            // 将浮点数 [-1.0, 1.0] 转换为 int16 [-32768, 32767]
-            float ClampedValue = FMath::Clamp(InterpolatedValue, -1.0f, 1.0f);
-            PCMData[i] = (int16)(ClampedValue * 32767.0f);
+            Sum = VectorMultiplyAdd(VectorLoad(Taps + Tap), VectorLoad(Coefficients + Tap), Sum);
         }
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(Sum, Lanes);
+        WriteToRing(Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3]);
+
+        ResamplePosition += ResampleStep;
     }
 
-    // 将16-bit PCM数据打包为uint8字节数组 (Little-endian)
-    OutputData.SetNum(PCMData.Num() * 2); // 每个int16需要2个字节
-    
-    for (int32 i = 0; i < PCMData.Num(); ++i)
+    // 保留最后 ResampleHistory 个样本作为下一块的历史，相位随位置一起平移
+    FMemory::Memmove(ResampleBuffer.GetData(), ResampleBuffer.GetData() + NumFrames, ResampleHistory * sizeof(float));
+    ResamplePosition -= NumFrames;
+}
+
+void UAudioSubmixListener::BroadcastRingChunks(int32 OutputSampleRate)
+{
+    const int32 ChunkSamples = FMath::Max(OutputSampleRate / 100, 1);
+    const int32 NumOutputSamples = RingCount / ChunkSamples * ChunkSamples;
+    if (NumOutputSamples == 0)
     {
-        int16 Sample = PCMData[i];
-        OutputData[i * 2] = (uint8)(Sample & 0xFF);         // 低字节
-        OutputData[i * 2 + 1] = (uint8)((Sample >> 8) & 0xFF); // 高字节
+        return;
     }
 
-    // 验证转换后的前几个样本
-    if (PCMData.Num() > 0)
+    // int16 在所有支持的平台上都是小端，直接拷贝即为 FeedAudio 需要的字节格式
+    OutputBytes.SetNumUninitialized(NumOutputSamples * sizeof(int16), EAllowShrinking::No);
+    const int32 FirstPart = FMath::Min(NumOutputSamples, RingCapacity - RingReadIndex);
+    FMemory::Memcpy(OutputBytes.GetData(), Ring.GetData() + RingReadIndex, FirstPart * sizeof(int16));
+    FMemory::Memcpy(OutputBytes.GetData() + FirstPart * sizeof(int16), Ring.GetData(),
+                    (NumOutputSamples - FirstPart) * sizeof(int16));
+    RingReadIndex = (RingReadIndex + NumOutputSamples) & RingMask;
+    RingCount -= NumOutputSamples;
+
+    OnAudioDataCapturedNative.Broadcast(OutputBytes);
+
+    // 动态委托会把数组拷贝进参数结构（每次广播一次堆分配），只在蓝图/动态绑定存在时广播
+    if (OnAudioDataCaptured.IsBound())
     {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("First PCM samples: %d, %d, %d"), 
-               PCMData.Num() > 0 ? PCMData[0] : 0,
-               PCMData.Num() > 1 ? PCMData[1] : 0,
-               PCMData.Num() > 2 ? PCMData[2] : 0);
+        OnAudioDataCaptured.Broadcast(OutputBytes);
     }
-}
\ No newline at end of file
+}
@@ -9,6 +9,8 @@
 #include "Misc/MessageDialog.h"
 #include "Logging/MessageLog.h"
 #include "Logging/LogMacros.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Tasks/Task.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogCookFrameSequence, Log, All);
 
@@ -17,6 +19,30 @@ DEFINE_LOG_CATEGORY_STATIC(LogCookFrameSequence, Log, All);
 constexpr auto LipSyncSequenceUpateFrequency = 100;
 constexpr auto LipSyncSequenceDuration = 1.0f / LipSyncSequenceUpateFrequency;
 
+// Clips are split into segments of at least this many frames, cooked in parallel (one context each)
+constexpr int32 LipSyncCookMinSegmentFrames = 1000;
+// Upper bound of segments, every segment holds its own context (and model)
+constexpr int32 LipSyncCookMaxSegments = 8;
+// Frames processed before a segment and discarded, long enough to absorb the model latency. The model state at a
+// segment boundary only approximates a sequential cook, so frames right after a boundary may differ slightly
+constexpr int32 LipSyncCookWarmUpFrames = 50;
+// Frames between two progress reports of a segment
+constexpr int32 LipSyncCookProgressFrames = 200;
+
+namespace
+{
+struct FCookSegment
+{
+    int32 FirstFrame = 0;
+    int32 NumFrames = 0;
+    TUniquePtr<UOVRLipSyncContextWrapper> Context;
+
+    // NumFrames * ovrLipSyncViseme_Count scores, frame after frame
+    TArray<float> Visemes;
+    TArray<float> LaughterScores;
+};
+}
+
 UCookFrameSequenceAsync* UCookFrameSequenceAsync::CookFrameSequence(const TArray<uint8>& RawSamples)
 {
     UCookFrameSequenceAsync* BPNode = NewObject<UCookFrameSequenceAsync>();
@@ -32,7 +58,7 @@ void UCookFrameSequenceAsync::Activate()
     {
         UE_LOG(LogCookFrameSequence, Error, TEXT("RawSamples size is too small."));
         FMessageLog("CookFrameSequence").Error(LOCTEXT("RawSamplesTooSmall", "RawSamples size is too small."));
-        onFrameSequenceCooked.Broadcast(nullptr, false);
+        Finish(nullptr, false);
         return;
     }
 
@@ -59,44 +85,164 @@ void UCookFrameSequenceAsync::Activate()
             TEXT("OVRLipSync"), 
             TEXT("OfflineModel"),
             TEXT("ovrlipsync_offline_model.pb"));
-#else
-		UE_LOG(LogTemp, Warning, TEXT("Unsupported platform for OVRLipSync model"));
-		return;
-
 #endif
 		// ģ·Ƿ
-        if (!FPaths::FileExists(modelPath))
+        // Other platforms use the SDK's built-in model, or the reference backend that needs no model at all
+        if (IOVRLipSyncBackend::UsesSDK() && !modelPath.IsEmpty() && !FPaths::FileExists(modelPath))
         {
 			UE_LOG(LogCookFrameSequence, Error, TEXT("Model file not found at path: %s"), *modelPath);
 			FMessageLog("CookFrameSequence").Error(LOCTEXT("ModelFileNotFound", "Model file not found."));
-			onFrameSequenceCooked.Broadcast(nullptr, false);
+			Finish(nullptr, false);
 			return;
         }
 
-        Async(EAsyncExecution::Thread, [this, PCMData, PCMDataSize, ChunkSize, ChunkSizeSamples, SampleRate, BufferSize, modelPath, NumChannels]()
+        // Sample rates below 100 Hz or a zero channel count leave no samples per frame
+        if (ChunkSize <= 0)
+        {
+            UE_LOG(LogCookFrameSequence, Error, TEXT("Invalid wave format: %d channels at %d Hz."), NumChannels, SampleRate);
+            FMessageLog("CookFrameSequence").Error(LOCTEXT("InvalidWaveFormat", "Invalid wave format."));
+            Finish(nullptr, false);
+            return;
+        }
+
+        const int32 NumFrames = PCMDataSize > 0 ? static_cast<int32>((PCMDataSize - 1) / ChunkSize) : 0;
+        const int32 NumSegments = FMath::Clamp(NumFrames / LipSyncCookMinSegmentFrames, 1,
+            FMath::Min(LipSyncCookMaxSegments, FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1)));
+        const int32 FramesPerSegment = FMath::DivideAndRoundUp(FMath::Max(NumFrames, 1), NumSegments);
+
+        // Contexts are created here : the SDK is initialized by every context and that is not thread safe
+        TSharedRef<TArray<FCookSegment>, ESPMode::ThreadSafe> Segments = MakeShared<TArray<FCookSegment>, ESPMode::ThreadSafe>();
+        Segments->SetNum(NumSegments);
+        for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
         {
-            UOVRLipSyncFrameSequence* Sequence = NewObject<UOVRLipSyncFrameSequence>();
-            UOVRLipSyncContextWrapper context(ovrLipSyncContextProvider_Enhanced, SampleRate, BufferSize, modelPath);
-            float LaughterScore = 0.0f;
-            int32_t FrameDelayInMs = 0;
-            TArray<float> Visemes;
-            for (int offs = 0; offs + ChunkSize < PCMDataSize; offs += ChunkSize)
+            FCookSegment& Segment = (*Segments)[SegmentIndex];
+            Segment.FirstFrame = SegmentIndex * FramesPerSegment;
+            Segment.NumFrames = FMath::Clamp(NumFrames - Segment.FirstFrame, 0, FramesPerSegment);
+            Segment.Context = MakeUnique<UOVRLipSyncContextWrapper>(ovrLipSyncContextProvider_Enhanced, SampleRate, BufferSize, modelPath);
+            if (!Segment.Context->IsValid())
             {
-                context.ProcessFrame(PCMData + offs, ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs, NumChannels > 1);
-                Sequence->Add(Visemes, LaughterScore);
+                UE_LOG(LogCookFrameSequence, Error, TEXT("Can't create lipsync context"));
+                FMessageLog("CookFrameSequence").Error(LOCTEXT("ContextCreationFailed", "Can't create lipsync context."));
+                Finish(nullptr, false);
+                return;
             }
-            AsyncTask(ENamedThreads::GameThread, [Sequence, this]() {
-                onFrameSequenceCooked.Broadcast(Sequence, true);
+        }
+
+        // Kept alive until the result is broadcast, RawSamples holds the PCM data the tasks read
+        AddToRoot();
+        Progress = 0.0f;
+
+        TWeakObjectPtr<UCookFrameSequenceAsync> WeakThis(this);
+        TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> CookedFrames = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+        const bool Stereo = NumChannels > 1;
+
+        TArray<UE::Tasks::FTask> SegmentTasks;
+        for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+        {
+            SegmentTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+                [Segments, SegmentIndex, PCMData, ChunkSize, ChunkSizeSamples, Stereo, NumFrames, CookedFrames, WeakThis]()
+            {
+                FCookSegment& Segment = (*Segments)[SegmentIndex];
+                UOVRLipSyncContextWrapper& Context = *Segment.Context;
+                float LaughterScore = 0.0f;
+                int32_t FrameDelayInMs = 0;
+                TArray<float> Visemes;
+
+                const int32 WarmUpFrames = FMath::Min(LipSyncCookWarmUpFrames, Segment.FirstFrame);
+                for (int32 Frame = Segment.FirstFrame - WarmUpFrames; Frame < Segment.FirstFrame; ++Frame)
+                {
+                    Context.ProcessFrame(PCMData + Frame * ChunkSize, ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs, Stereo);
+                }
+
+                Segment.Visemes.Reserve(Segment.NumFrames * ovrLipSyncViseme_Count);
+                Segment.LaughterScores.Reserve(Segment.NumFrames);
+                for (int32 Frame = 0; Frame < Segment.NumFrames; ++Frame)
+                {
+                    Context.ProcessFrame(PCMData + (Segment.FirstFrame + Frame) * ChunkSize, ChunkSizeSamples, Visemes, LaughterScore, FrameDelayInMs, Stereo);
+                    Segment.Visemes.Append(Visemes);
+                    Segment.LaughterScores.Add(LaughterScore);
+
+                    const int32 FramesSinceReport = (Frame + 1) % LipSyncCookProgressFrames;
+                    if (FramesSinceReport == 0 || Frame + 1 == Segment.NumFrames)
+                    {
+                        const int32 Reported = FramesSinceReport == 0 ? LipSyncCookProgressFrames : FramesSinceReport;
+                        const float CookedProgress = static_cast<float>(CookedFrames->Add(Reported) + Reported) / NumFrames;
+                        AsyncTask(ENamedThreads::GameThread, [WeakThis, CookedProgress]()
+                        {
+                            if (UCookFrameSequenceAsync* Self = WeakThis.Get())
+                            {
+                                Self->ReportProgress(CookedProgress);
+                            }
+                        });
+                    }
+                }
+
+                // Release the model as soon as the segment is done
+                Segment.Context.Reset();
+            }));
+        }
+
+        // Stitch the segments in order once all are done, the sequence object is created on the game thread
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [Segments, WeakThis]()
+        {
+            AsyncTask(ENamedThreads::GameThread, [Segments, WeakThis]()
+            {
+                UCookFrameSequenceAsync* Self = WeakThis.Get();
+                if (!Self)
+                {
+                    return;
+                }
+
+                UOVRLipSyncFrameSequence* Sequence = NewObject<UOVRLipSyncFrameSequence>();
+                int32 NumFrames = 0;
+                for (const FCookSegment& Segment : *Segments)
+                {
+                    NumFrames += Segment.NumFrames;
+                }
+                Sequence->Reserve(NumFrames);
+                for (const FCookSegment& Segment : *Segments)
+                {
+                    for (int32 Frame = 0; Frame < Segment.NumFrames; ++Frame)
+                    {
+                        Sequence->Add(TConstArrayView<float>(Segment.Visemes.GetData() + Frame * ovrLipSyncViseme_Count,
+                            ovrLipSyncViseme_Count), Segment.LaughterScores[Frame]);
+                    }
+                }
+                Self->Finish(Sequence, true);
             });
-        });
+        }, SegmentTasks);
 
     }
     else
     {
         UE_LOG(LogCookFrameSequence, Error, TEXT("Failed to read wave info."));
         FMessageLog("CookFrameSequence").Error(LOCTEXT("FailedToReadWaveInfo", "Failed to read wave info."));
-        onFrameSequenceCooked.Broadcast(nullptr, false);
+        Finish(nullptr, false);
+    }
+}
+
+void UCookFrameSequenceAsync::ReportProgress(float InProgress)
+{
+    // Reports of the segments may arrive out of order
+    if (InProgress > Progress)
+    {
+        Progress = InProgress;
+        OnFrameSequenceCookProgress.Broadcast(Progress);
+    }
+}
+
+void UCookFrameSequenceAsync::Finish(UOVRLipSyncFrameSequence* Sequence, bool Success)
+{
+    if (IsRooted())
+    {
+        RemoveFromRoot();
+    }
+    if (Success)
+    {
+        ReportProgress(1.0f);
     }
+    onFrameSequenceCooked.Broadcast(Sequence, Success);
+    SetReadyToDestroy();
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "OVRLipSyncActorComponentBase.h"
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
 #include "OVRLipSyncModule.h"
 
 // Sets default values for this component's properties
@@ -38,7 +39,31 @@ const float UOVRLipSyncActorComponentBase::GetLaughterScore() const { return Lau
 void UOVRLipSyncActorComponentBase::AssignVisemesToMorphTargets(USkeletalMeshComponent *Mesh,
 																const TArray<FString> &InMorphTargetNames)
 {
-	auto MorphTargetNames = InMorphTargetNames.Num() > 0 ? InMorphTargetNames : VisemeNames;
+	// Only rebind when called with another mesh or other names than last time. A null mesh and empty names are
+	// matched against the flags recorded by BindMorphTargets, so the usual per-tick call skips both the component
+	// lookup and the name compare
+	const bool bSameMesh = Mesh != nullptr ? Mesh == BoundMesh.Get() : bBoundFromOwnerMesh;
+	const bool bSameNames =
+		InMorphTargetNames.Num() > 0 ? InMorphTargetNames == BoundMorphTargetNames : bBoundDefaultNames;
+	if (!BoundMesh.IsValid() || !bSameMesh || !bSameNames)
+	{
+		if (!BindMorphTargets(Mesh, InMorphTargetNames))
+		{
+			return;
+		}
+	}
+	ApplyBoundMorphTargets();
+}
+
+bool UOVRLipSyncActorComponentBase::BindMorphTargets(USkeletalMeshComponent *Mesh,
+													 const TArray<FString> &InMorphTargetNames)
+{
+	const TArray<FString> &MorphTargetNames = InMorphTargetNames.Num() > 0 ? InMorphTargetNames : VisemeNames;
+	BoundMesh = nullptr;
+	BoundMorphTargets.Reset();
+	BoundMorphTargetNames.Reset();
+	bBoundFromOwnerMesh = Mesh == nullptr;
+	bBoundDefaultNames = InMorphTargetNames.Num() == 0;
 	if (Mesh == nullptr)
 	{
 		Mesh = GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
@@ -46,11 +71,40 @@ void UOVRLipSyncActorComponentBase::AssignVisemesToMorphTargets(USkeletalMeshCom
 	if (Mesh == nullptr)
 	{
 		UE_LOG(LogOvrLipSync, Error, TEXT("Mesh is NULL"));
+		return false;
+	}
+
+	const USkeletalMesh *SkeletalMesh = Mesh->GetSkeletalMeshAsset();
+	const int32 Count = FMath::Min(MorphTargetNames.Num(), Visemes.Num());
+	BoundMorphTargets.Reserve(Count);
+	for (int32 Viseme = 0; Viseme < Count; ++Viseme)
+	{
+		const FName MorphTarget(*MorphTargetNames[Viseme]);
+		if (SkeletalMesh && !MorphTarget.IsNone() && !SkeletalMesh->FindMorphTarget(MorphTarget))
+		{
+			UE_LOG(LogOvrLipSync, Warning, TEXT("Morph target %s not found in %s"), *MorphTargetNames[Viseme],
+				   *SkeletalMesh->GetName());
+		}
+		BoundMorphTargets.Add(MorphTarget);
+	}
+	BoundMesh = Mesh;
+	BoundMorphTargetNames = MorphTargetNames;
+	return true;
+}
+
+void UOVRLipSyncActorComponentBase::ApplyBoundMorphTargets()
+{
+	USkeletalMeshComponent *Mesh = BoundMesh.Get();
+	if (Mesh == nullptr)
+	{
 		return;
 	}
-	for (int cnt = 0; cnt < MorphTargetNames.Num(); cnt++)
+	for (int32 Viseme = 0; Viseme < BoundMorphTargets.Num(); ++Viseme)
 	{
-		Mesh->SetMorphTarget(FName(*MorphTargetNames[cnt]), Visemes[cnt]);
+		if (!BoundMorphTargets[Viseme].IsNone())
+		{
+			Mesh->SetMorphTarget(BoundMorphTargets[Viseme], Visemes[Viseme]);
+		}
 	}
 }
 
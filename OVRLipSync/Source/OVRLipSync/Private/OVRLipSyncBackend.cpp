@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBackend.cpp
+ * Content     :   Viseme analysis backend selection
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "OVRLipSyncBackend.h"
+#include "OVRLipSyncModule.h"
+#include "OVRLipSyncReferenceBackend.h"
+#include "OVRLipSyncSDKBackend.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarOVRLipSyncBackend(
+	TEXT("OVRLipSync.Backend"), 0,
+	TEXT("Viseme analysis backend of new lipsync contexts. 0: Oculus SDK where available, 1: portable reference"));
+
+namespace
+{
+IOVRLipSyncBackend::FFactory &GetBackendFactory()
+{
+	static IOVRLipSyncBackend::FFactory Factory;
+	return Factory;
+}
+} // namespace
+
+TUniquePtr<IOVRLipSyncBackend> IOVRLipSyncBackend::Create(const FOVRLipSyncBackendSettings &Settings)
+{
+	if (const FFactory &Factory = GetBackendFactory())
+	{
+		return Factory(Settings);
+	}
+#if OVRLIPSYNC_WITH_SDK
+	if (UsesSDK())
+	{
+		return MakeUnique<FOVRLipSyncSDKBackend>(Settings);
+	}
+#endif
+	return MakeUnique<FOVRLipSyncReferenceBackend>(Settings);
+}
+
+void IOVRLipSyncBackend::SetFactory(FFactory Factory) { GetBackendFactory() = MoveTemp(Factory); }
+
+bool IOVRLipSyncBackend::UsesSDK()
+{
+#if OVRLIPSYNC_WITH_SDK
+	return !GetBackendFactory() && CVarOVRLipSyncBackend.GetValueOnAnyThread() == 0;
+#else
+	return false;
+#endif
+}
+
+void IOVRLipSyncBackend::InvokeAsyncCallback(TConstArrayView<float> Visemes, float LaughterScore)
+{
+	if (!AsyncCallback)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Trying invoke unintialized async callback"));
+		return;
+	}
+	AsyncCallback(Visemes, LaughterScore);
+}
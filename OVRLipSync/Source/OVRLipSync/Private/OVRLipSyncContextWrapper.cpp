@@ -30,31 +30,21 @@
 UOVRLipSyncContextWrapper::UOVRLipSyncContextWrapper(ovrLipSyncContextProvider ProviderKind, int SampleRate,
 													 int BufferSize, FString ModelPath, bool EnableAcceleration)
 {
-#if !PLATFORM_ANDROID
-	auto pluginsDir = FPaths::ProjectPluginsDir();
-	auto libDir = FPaths::Combine(pluginsDir, TEXT("OVRLipSync"), TEXT("ThirdParty"), TEXT("Lib"),
-								  FPlatformProcess::GetBinariesSubdirectory());
-	TArray<char> libDirChar(libDir.GetCharArray());
-	auto rc = ovrLipSync_InitializeEx(SampleRate, BufferSize, libDirChar.GetData());
-#else
-	auto rc = ovrLipSync_Initialize(SampleRate, BufferSize);
-#endif
-	if (rc != ovrLipSyncSuccess)
-	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Can't initialize ovrLipSync: %d"), rc);
-		return;
-	}
-	rc = ModelPath.IsEmpty()
-			 ? ovrLipSync_CreateContextEx(&LipSyncContext, ProviderKind, SampleRate, EnableAcceleration)
-			 : ovrLipSync_CreateContextWithModelFile(&LipSyncContext, ProviderKind, TCHAR_TO_ANSI(*ModelPath),
-													 SampleRate, EnableAcceleration);
-	if (rc != ovrLipSyncSuccess)
-	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Can't create ovrLipSync context: %d"), rc);
-	}
+	FOVRLipSyncBackendSettings Settings;
+	Settings.Provider = ProviderKind;
+	Settings.SampleRate = SampleRate;
+	Settings.BufferSize = BufferSize;
+	Settings.ModelPath = MoveTemp(ModelPath);
+	Settings.Accelerate = EnableAcceleration;
+	Backend = IOVRLipSyncBackend::Create(Settings);
+}
+
+UOVRLipSyncContextWrapper::UOVRLipSyncContextWrapper(TUniquePtr<IOVRLipSyncBackend> InBackend)
+	: Backend(MoveTemp(InBackend))
+{
 }
 
-UOVRLipSyncContextWrapper::~UOVRLipSyncContextWrapper() { ovrLipSync_DestroyContext(LipSyncContext); }
+UOVRLipSyncContextWrapper::~UOVRLipSyncContextWrapper() = default;
 
 void UOVRLipSyncContextWrapper::ProcessFrame(const int16_t *AudioBuffer, int AudioBufferSize, TArray<float> &Visemes,
 											 float &LaughterScore, int32_t &FrameDelay, bool Stereo)
@@ -63,56 +53,29 @@ void UOVRLipSyncContextWrapper::ProcessFrame(const int16_t *AudioBuffer, int Aud
 	{
 		Visemes.SetNumZeroed(ovrLipSyncViseme_Count);
 	}
-	ovrLipSyncFrame frame = {};
-	frame.visemes = Visemes.GetData();
-	frame.visemesLength = Visemes.Num();
-	auto rc = ovrLipSync_ProcessFrameEx(LipSyncContext, AudioBuffer, AudioBufferSize,
-										Stereo ? ovrLipSyncAudioDataType_S16_Stereo : ovrLipSyncAudioDataType_S16_Mono,
-										&frame);
-	if (rc != ovrLipSyncSuccess)
+	if (!IsValid())
 	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to process frame: %d"), rc);
 		return;
 	}
-	LaughterScore = frame.laughterScore;
-	FrameDelay = frame.frameDelay;
-}
-
-namespace
-{
-void ProcessFrameCallback(void *opaque, const ovrLipSyncFrame *pFrame, ovrLipSyncResult result)
-{
-	if (result != ovrLipSyncSuccess)
+	int32 BackendFrameDelay = 0;
+	if (Backend->ProcessFrame(AudioBuffer, AudioBufferSize, Stereo, Visemes, LaughterScore, BackendFrameDelay))
 	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Async prediction failed: %d"), result);
-		return;
+		FrameDelay = BackendFrameDelay;
 	}
-	auto wrapper = reinterpret_cast<UOVRLipSyncContextWrapper *>(opaque);
-	TArray<float> Visemes(pFrame->visemes, pFrame->visemesLength);
-	wrapper->InvokeAsyncCallback(Visemes, pFrame->laughterScore);
 }
-} // namespace
-
-void UOVRLipSyncContextWrapper::SetAsyncCallback(const AsyncCallbackType &Callback) { AsyncCallback = Callback; }
 
-void UOVRLipSyncContextWrapper::InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore)
+void UOVRLipSyncContextWrapper::SetAsyncCallback(const AsyncCallbackType &Callback)
 {
-	if (!AsyncCallback)
+	if (Backend)
 	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Trying invoke unintialized async callback"));
-		return;
+		Backend->SetAsyncCallback(Callback);
 	}
-	AsyncCallback(Visemes, LaughterScore);
 }
 
 void UOVRLipSyncContextWrapper::ProcessFrameAsync(const int16_t *AudioBuffer, int AudioBufferSize, bool Stereo)
 {
-	auto rc = ovrLipSync_ProcessFrameAsync(
-		LipSyncContext, AudioBuffer, AudioBufferSize,
-		Stereo ? ovrLipSyncAudioDataType_S16_Stereo : ovrLipSyncAudioDataType_S16_Mono, ProcessFrameCallback, this);
-	if (rc != ovrLipSyncSuccess)
+	if (IsValid())
 	{
-		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to start async prediction: %d"), rc);
-		return;
+		Backend->ProcessFrameAsync(AudioBuffer, AudioBufferSize, Stereo);
 	}
 }
@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncFrame.cpp
+ * Content     :   OVRLipSync frame sequence storage
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "OVRLipSyncFrame.h"
+#include "OVRLipSyncModule.h"
+#include "Serialization/CustomVersion.h"
+
+namespace
+{
+struct FOVRLipSyncCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+		// UOVRLipSyncFrameSequence stores its scores in one delta / run-length encoded buffer
+		CompactFrameSequence,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+const FGuid FOVRLipSyncCustomVersion::GUID(0x6A0F3E21, 0x4B7C4D55, 0x9E1A2C37, 0x58D0B4F1);
+FCustomVersionRegistration GRegisterOVRLipSyncCustomVersion(FOVRLipSyncCustomVersion::GUID,
+															FOVRLipSyncCustomVersion::LatestVersion, TEXT("OVRLipSyncVer"));
+
+template <typename ValueType> void DecodeValues(const uint8 *Src, int32 Count, float Scale, float *OutScores)
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		ValueType Value;
+		FMemory::Memcpy(&Value, Src + Index * sizeof(ValueType), sizeof(ValueType));
+		OutScores[Index] = static_cast<float>(Value) * Scale;
+	}
+}
+
+// Scores are handled as little endian words of BytesPerScore bytes by the disk format
+uint32 ReadWord(const uint8 *Src, int32 BytesPerScore)
+{
+	uint32 Value = 0;
+	for (int32 Byte = 0; Byte < BytesPerScore; ++Byte)
+	{
+		Value |= uint32(Src[Byte]) << (8 * Byte);
+	}
+	return Value;
+}
+
+void WriteWord(uint8 *Dest, uint32 Value, int32 BytesPerScore)
+{
+	for (int32 Byte = 0; Byte < BytesPerScore; ++Byte)
+	{
+		Dest[Byte] = uint8(Value >> (8 * Byte));
+	}
+}
+
+void AppendVarInt(TArray<uint8> &Data, uint32 Value)
+{
+	while (Value >= 0x80)
+	{
+		Data.Add(uint8(Value | 0x80));
+		Value >>= 7;
+	}
+	Data.Add(uint8(Value));
+}
+
+bool ReadVarInt(const TArray<uint8> &Data, int32 &Pos, uint32 &OutValue)
+{
+	OutValue = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		if (Pos >= Data.Num())
+		{
+			return false;
+		}
+		const uint8 Byte = Data[Pos++];
+		OutValue |= uint32(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+} // namespace
+
+void UOVRLipSyncFrameSequence::Reset()
+{
+	Scores.Reset();
+	NumFrames = 0;
+}
+
+void UOVRLipSyncFrameSequence::Reserve(int32 InNumFrames)
+{
+	Scores.Reserve(InNumFrames * NumScores * GetBytesPerScore());
+}
+
+void UOVRLipSyncFrameSequence::Add(TConstArrayView<float> Visemes, float LaughterScore)
+{
+	const int32 BytesPerScore = GetBytesPerScore();
+	uint8 *Dest = Scores.GetData() + Scores.AddUninitialized(NumScores * BytesPerScore);
+	for (int32 Viseme = 0; Viseme < NumVisemes; ++Viseme)
+	{
+		EncodeScore(Dest + Viseme * BytesPerScore, Visemes.IsValidIndex(Viseme) ? Visemes[Viseme] : 0.0f);
+	}
+	EncodeScore(Dest + NumVisemes * BytesPerScore, LaughterScore);
+	++NumFrames;
+}
+
+void UOVRLipSyncFrameSequence::GetFrame(int32 Index, TArrayView<float> OutVisemes, float &OutLaughterScore) const
+{
+	check(Index >= 0 && Index < NumFrames);
+	float Frame[NumScores];
+	DecodeScores(Index * NumScores, NumScores, Frame);
+	FMemory::Memcpy(OutVisemes.GetData(), Frame, FMath::Min(OutVisemes.Num(), NumVisemes) * sizeof(float));
+	OutLaughterScore = Frame[NumVisemes];
+}
+
+bool UOVRLipSyncFrameSequence::Sample(float Time, TArrayView<float> OutVisemes, float &OutLaughterScore) const
+{
+	const float FramePosition = Time * FramesPerSecond;
+	if (!(FramePosition >= 0.0f) || FramePosition >= NumFrames)
+	{
+		return false;
+	}
+
+	const int32 Index = FMath::Min(FMath::FloorToInt32(FramePosition), NumFrames - 1);
+	const int32 NextIndex = FMath::Min(Index + 1, NumFrames - 1);
+	const float Alpha = FramePosition - Index;
+
+	float Frames[2][NumScores];
+	DecodeScores(Index * NumScores, NumScores, Frames[0]);
+	DecodeScores(NextIndex * NumScores, NumScores, Frames[1]);
+	const int32 Count = FMath::Min(OutVisemes.Num(), NumVisemes);
+	for (int32 Viseme = 0; Viseme < Count; ++Viseme)
+	{
+		OutVisemes[Viseme] = FMath::Lerp(Frames[0][Viseme], Frames[1][Viseme], Alpha);
+	}
+	OutLaughterScore = FMath::Lerp(Frames[0][NumVisemes], Frames[1][NumVisemes], Alpha);
+	return true;
+}
+
+int32 UOVRLipSyncFrameSequence::GetBytesPerScore(EOVRLipSyncFrameQuantization InQuantization)
+{
+	switch (InQuantization)
+	{
+	case EOVRLipSyncFrameQuantization::Bits16:
+		return sizeof(uint16);
+	case EOVRLipSyncFrameQuantization::Bits8:
+		return sizeof(uint8);
+	default:
+		return sizeof(float);
+	}
+}
+
+float UOVRLipSyncFrameSequence::DecodeScore(int32 ScoreIndex) const
+{
+	check(ScoreIndex >= 0 && ScoreIndex < NumFrames * NumScores);
+	float Score;
+	DecodeScores(ScoreIndex, 1, &Score);
+	return Score;
+}
+
+void UOVRLipSyncFrameSequence::DecodeScores(int32 FirstScore, int32 Count, float *OutScores) const
+{
+	const uint8 *Src = Scores.GetData() + FirstScore * GetBytesPerScore();
+	switch (EncodedQuantization)
+	{
+	case EOVRLipSyncFrameQuantization::Bits16:
+		DecodeValues<uint16>(Src, Count, 1.0f / 65535.0f, OutScores);
+		break;
+	case EOVRLipSyncFrameQuantization::Bits8:
+		DecodeValues<uint8>(Src, Count, 1.0f / 255.0f, OutScores);
+		break;
+	default:
+		FMemory::Memcpy(OutScores, Src, Count * sizeof(float));
+		break;
+	}
+}
+
+void UOVRLipSyncFrameSequence::EncodeScore(uint8 *Dest, float Score) const
+{
+	switch (EncodedQuantization)
+	{
+	case EOVRLipSyncFrameQuantization::Bits16:
+	{
+		const uint16 Value = uint16(FMath::RoundToInt(FMath::Clamp(Score, 0.0f, 1.0f) * 65535.0f));
+		FMemory::Memcpy(Dest, &Value, sizeof(Value));
+		break;
+	}
+	case EOVRLipSyncFrameQuantization::Bits8:
+		*Dest = uint8(FMath::RoundToInt(FMath::Clamp(Score, 0.0f, 1.0f) * 255.0f));
+		break;
+	default:
+		FMemory::Memcpy(Dest, &Score, sizeof(Score));
+		break;
+	}
+}
+
+void UOVRLipSyncFrameSequence::SetQuantization(EOVRLipSyncFrameQuantization InQuantization)
+{
+	Quantization = InQuantization;
+	if (InQuantization == EncodedQuantization)
+	{
+		return;
+	}
+
+	TArray<float> Decoded;
+	Decoded.SetNumUninitialized(NumFrames * NumScores);
+	DecodeScores(0, Decoded.Num(), Decoded.GetData());
+
+	EncodedQuantization = InQuantization;
+	const int32 BytesPerScore = GetBytesPerScore();
+	Scores.SetNumUninitialized(Decoded.Num() * BytesPerScore);
+	for (int32 Index = 0; Index < Decoded.Num(); ++Index)
+	{
+		EncodeScore(Scores.GetData() + Index * BytesPerScore, Decoded[Index]);
+	}
+	Scores.Shrink();
+}
+
+void UOVRLipSyncFrameSequence::EncodeDeltaRuns(TArray<uint8> &OutData) const
+{
+	// Each run is [zero deltas count][literal deltas count][literal deltas], counts as varints
+	const int32 BytesPerScore = GetBytesPerScore();
+	const uint32 Mask = BytesPerScore == 4 ? 0xFFFFFFFFu : (1u << (8 * BytesPerScore)) - 1;
+	const int32 NumTotalScores = NumFrames * NumScores;
+	auto GetDelta = [&](int32 Index)
+	{
+		const uint32 Value = ReadWord(Scores.GetData() + Index * BytesPerScore, BytesPerScore);
+		const uint32 Previous =
+			Index >= NumScores ? ReadWord(Scores.GetData() + (Index - NumScores) * BytesPerScore, BytesPerScore) : 0;
+		return (Value - Previous) & Mask;
+	};
+
+	int32 Index = 0;
+	while (Index < NumTotalScores)
+	{
+		int32 NumZeros = 0;
+		while (Index + NumZeros < NumTotalScores && GetDelta(Index + NumZeros) == 0)
+		{
+			++NumZeros;
+		}
+		Index += NumZeros;
+
+		int32 NumLiterals = 0;
+		while (Index + NumLiterals < NumTotalScores && GetDelta(Index + NumLiterals) != 0)
+		{
+			++NumLiterals;
+		}
+
+		AppendVarInt(OutData, NumZeros);
+		AppendVarInt(OutData, NumLiterals);
+		uint8 *Dest = OutData.GetData() + OutData.AddUninitialized(NumLiterals * BytesPerScore);
+		for (int32 Literal = 0; Literal < NumLiterals; ++Literal)
+		{
+			WriteWord(Dest + Literal * BytesPerScore, GetDelta(Index + Literal), BytesPerScore);
+		}
+		Index += NumLiterals;
+	}
+}
+
+bool UOVRLipSyncFrameSequence::DecodeDeltaRuns(const TArray<uint8> &Data)
+{
+	const int32 BytesPerScore = GetBytesPerScore();
+	if (NumFrames < 0 || NumFrames > MAX_int32 / (NumScores * BytesPerScore))
+	{
+		return false;
+	}
+
+	const int32 NumTotalScores = NumFrames * NumScores;
+	Scores.SetNumUninitialized(NumTotalScores * BytesPerScore);
+	uint8 *Dest = Scores.GetData();
+	auto GetPrevious = [&](int32 Index)
+	{ return Index >= NumScores ? ReadWord(Dest + (Index - NumScores) * BytesPerScore, BytesPerScore) : 0; };
+
+	int32 Pos = 0;
+	int32 Index = 0;
+	while (Index < NumTotalScores)
+	{
+		uint32 NumZeros, NumLiterals;
+		if (!ReadVarInt(Data, Pos, NumZeros) || !ReadVarInt(Data, Pos, NumLiterals) || NumZeros + NumLiterals == 0 ||
+			uint64(NumZeros) + NumLiterals > uint64(NumTotalScores - Index) ||
+			uint64(NumLiterals) * BytesPerScore > uint64(Data.Num() - Pos))
+		{
+			return false;
+		}
+
+		for (const int32 End = Index + NumZeros; Index < End; ++Index)
+		{
+			WriteWord(Dest + Index * BytesPerScore, GetPrevious(Index), BytesPerScore);
+		}
+		for (const int32 End = Index + NumLiterals; Index < End; ++Index, Pos += BytesPerScore)
+		{
+			WriteWord(Dest + Index * BytesPerScore, GetPrevious(Index) + ReadWord(Data.GetData() + Pos, BytesPerScore),
+					  BytesPerScore);
+		}
+	}
+	return Pos == Data.Num();
+}
+
+void UOVRLipSyncFrameSequence::ConvertLegacyFrames()
+{
+	EncodedQuantization = Quantization;
+	Reset();
+	Reserve(FrameSequence.Num());
+	for (const FOVRLipSyncFrame &Frame : FrameSequence)
+	{
+		Add(Frame.VisemeScores, Frame.LaughterScore);
+	}
+	FrameSequence.Empty();
+}
+
+void UOVRLipSyncFrameSequence::Serialize(FArchive &Ar)
+{
+	Super::Serialize(Ar);
+	Ar.UsingCustomVersion(FOVRLipSyncCustomVersion::GUID);
+
+	if (Ar.IsLoading() && Ar.CustomVer(FOVRLipSyncCustomVersion::GUID) < FOVRLipSyncCustomVersion::CompactFrameSequence)
+	{
+		ConvertLegacyFrames();
+		return;
+	}
+	if (Ar.IsObjectReferenceCollector() || Ar.IsCountingMemory())
+	{
+		return;
+	}
+
+	uint8 SavedQuantization = uint8(EncodedQuantization);
+	Ar << SavedQuantization;
+	Ar << NumFrames;
+
+	TArray<uint8> Data;
+	if (Ar.IsSaving())
+	{
+		EncodeDeltaRuns(Data);
+	}
+	Ar << Data;
+
+	if (Ar.IsLoading())
+	{
+		EncodedQuantization = EOVRLipSyncFrameQuantization(SavedQuantization);
+		if (SavedQuantization > uint8(EOVRLipSyncFrameQuantization::Bits8) || !DecodeDeltaRuns(Data))
+		{
+			UE_LOG(LogOvrLipSync, Error, TEXT("Corrupt frame sequence data in %s"), *GetPathName());
+			Ar.SetError();
+			EncodedQuantization = EOVRLipSyncFrameQuantization::None;
+			Reset();
+		}
+		Quantization = EncodedQuantization;
+	}
+}
+
+void UOVRLipSyncFrameSequence::GetResourceSizeEx(FResourceSizeEx &CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Scores.GetAllocatedSize());
+}
+
+#if WITH_EDITOR
+void UOVRLipSyncFrameSequence::PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (Quantization != EncodedQuantization)
+	{
+		SetQuantization(Quantization);
+	}
+}
+#endif
@@ -53,6 +53,12 @@ ovrLipSyncContextProvider ContextProviderFromProviderKind(OVRLipSyncProviderKind
 	}
 }
 
+UOVRLipSyncActorComponent::UOVRLipSyncActorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
 // Called when the game starts
 void UOVRLipSyncActorComponent::BeginPlay()
 {
@@ -60,13 +66,28 @@ void UOVRLipSyncActorComponent::BeginPlay()
 
 	LipSyncContext = MakeShared<UOVRLipSyncContextWrapper>(ContextProviderFromProviderKind(ProviderKind), SampleRate,
 														   BufferSize, FString(), EnableHardwareAcceleration);
-	LipSyncContext->SetAsyncCallback([this](const TArray<float> &NewVisemes, float NewLaughterScore) {
-		Visemes = NewVisemes;
-		LaughterScore = NewLaughterScore;
-		OnVisemesReady.Broadcast();
+	// The callback runs on the SDK's thread : only publish, TickComponent hands the result to the game thread
+	LipSyncContext->SetAsyncCallback([this](TConstArrayView<float> NewVisemes, float NewLaughterScore) {
+		LatestVisemes.Publish(NewVisemes, NewLaughterScore);
 	});
 }
 
+void UOVRLipSyncActorComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+											  FActorComponentTickFunction *ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const FOVRLipSyncVisemeSlot::FFrame *Frame = LatestVisemes.Consume();
+	if (!Frame)
+	{
+		return;
+	}
+	const int32 Count = FMath::Min(Visemes.Num(), int32(ovrLipSyncViseme_Count));
+	FMemory::Memcpy(Visemes.GetData(), Frame->Visemes, Count * sizeof(float));
+	LaughterScore = Frame->LaughterScore;
+	OnVisemesReady.Broadcast();
+}
+
 void UOVRLipSyncActorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Stop();
@@ -153,6 +174,8 @@ void UOVRLipSyncActorComponent::FeedAudio(const TArray<uint8> &VoiceData)
 
 void UOVRLipSyncActorComponent::Stop()
 {
+	// A prediction still in the slot must not override the neutral pose on the next tick
+	LatestVisemes.Discard();
 	InitNeutralPose();
 	
 	if (!VoiceCapture)
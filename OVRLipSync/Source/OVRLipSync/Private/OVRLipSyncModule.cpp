@@ -30,7 +30,13 @@ DEFINE_LOG_CATEGORY(LogOvrLipSync);
 class FOVRLipSyncModule : public IModuleInterface
 {
 public:
-	void ShutdownModule() override { ovrLipSync_Shutdown(); }
+	void ShutdownModule() override
+	{
+		// Platforms without the prebuilt SDK link no shim library and run on the reference backend
+#if OVRLIPSYNC_WITH_SDK
+		ovrLipSync_Shutdown();
+#endif
+	}
 };
 
 IMPLEMENT_MODULE(FOVRLipSyncModule, OVRLipSync);
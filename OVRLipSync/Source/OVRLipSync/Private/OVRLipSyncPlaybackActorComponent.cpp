@@ -70,16 +70,29 @@ void UOVRLipSyncPlaybackActorComponent::OnAudioPlaybackPercent(const UAudioCompo
 		InitNeutralPose();
 		return;
 	}
-	auto PlayPos = SoundWave->Duration * Percent;
-	auto IntPos = static_cast<unsigned>(PlayPos * 100);
-	if (IntPos >= Sequence->Num())
+	// Sample at the exact playback time instead of stepping at the 100 Hz frame rate
+	float Sampled[UOVRLipSyncFrameSequence::NumVisemes];
+	float SampledLaughterScore;
+	if (!Sequence->Sample(SoundWave->Duration * Percent, Sampled, SampledLaughterScore))
 	{
 		InitNeutralPose();
 		return;
 	}
-	const auto &Frame = (*Sequence)[IntPos];
-	LaughterScore = Frame.LaughterScore;
-	Visemes = Frame.VisemeScores;
+
+	const int32 Count = FMath::Min(Visemes.Num(), UOVRLipSyncFrameSequence::NumVisemes);
+	float MaxChange = FMath::Abs(SampledLaughterScore - LaughterScore);
+	for (int32 Viseme = 0; Viseme < Count; ++Viseme)
+	{
+		MaxChange = FMath::Max(MaxChange, FMath::Abs(Sampled[Viseme] - Visemes[Viseme]));
+	}
+	// Small changes accumulate against the last broadcast values until they pass the threshold
+	if (MaxChange <= BroadcastThreshold)
+	{
+		return;
+	}
+
+	FMemory::Memcpy(Visemes.GetData(), Sampled, Count * sizeof(float));
+	LaughterScore = SampledLaughterScore;
 	OnVisemesReady.Broadcast();
 }
 
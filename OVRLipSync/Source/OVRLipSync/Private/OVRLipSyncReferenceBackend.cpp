@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferenceBackend.cpp
+ * Content     :   Portable reference viseme estimator
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "OVRLipSyncReferenceBackend.h"
+
+namespace
+{
+// Band edges in Hz : first formant (0-2), second formant (2-4), frication (5-6)
+constexpr float BandEdges[][2] = {{150.0f, 400.0f},	  {400.0f, 800.0f},	  {800.0f, 1300.0f},  {1300.0f, 2000.0f},
+								  {2000.0f, 3200.0f}, {3200.0f, 5000.0f}, {5000.0f, 8000.0f}};
+
+// Frame levels (dBFS) of silence and of full speech activity
+constexpr float SilenceLevel = -55.0f;
+constexpr float SpeechLevel = -35.0f;
+// Fricatives quieter than this are FF / TH rather than SS / CH
+constexpr float WeakFricativeLevel = -40.0f;
+// Level rise (dB) from one frame to the next that starts to count as a plosive
+constexpr float OnsetRise = 6.0f;
+
+// Per frame smoothing of rising and falling scores
+constexpr float Attack = 0.7f;
+constexpr float Release = 0.3f;
+
+struct FVowelPrototype
+{
+	int32 Viseme;
+	float F1;
+	float F2;
+};
+
+constexpr FVowelPrototype VowelPrototypes[] = {
+	{ovrLipSyncViseme_aa, 750.0f, 1200.0f}, {ovrLipSyncViseme_E, 550.0f, 1800.0f}, {ovrLipSyncViseme_ih, 350.0f, 2200.0f},
+	{ovrLipSyncViseme_oh, 500.0f, 900.0f},	{ovrLipSyncViseme_ou, 350.0f, 750.0f},	{ovrLipSyncViseme_RR, 450.0f, 1300.0f},
+};
+constexpr int32 NumVowelPrototypes = UE_ARRAY_COUNT(VowelPrototypes);
+
+// Width of the prototype match, in natural log of the frequency ratio
+constexpr float FormantSpread = 0.25f;
+
+float SmoothStep(float Edge0, float Edge1, float X)
+{
+	const float T = FMath::Clamp((X - Edge0) / (Edge1 - Edge0), 0.0f, 1.0f);
+	return T * T * (3.0f - 2.0f * T);
+}
+} // namespace
+
+FOVRLipSyncReferenceBackend::FOVRLipSyncReferenceBackend(const FOVRLipSyncBackendSettings &Settings)
+	: SampleRate(Settings.SampleRate)
+{
+	static_assert(UE_ARRAY_COUNT(BandEdges) == NumBands, "One pair of edges per band");
+	if (SampleRate <= 0)
+	{
+		return;
+	}
+
+	// Bands above the Nyquist frequency of low sample rates stay silent (B0 = 0)
+	const float MaxFrequency = SampleRate * 0.45f;
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		const float Low = BandEdges[Band][0];
+		const float High = FMath::Min(BandEdges[Band][1], MaxFrequency);
+		FBand &Filter = Bands[Band];
+		Filter.Center = FMath::Sqrt(BandEdges[Band][0] * BandEdges[Band][1]);
+		if (Low >= High)
+		{
+			continue;
+		}
+		const float Center = FMath::Sqrt(Low * High);
+		const float W0 = 2.0f * UE_PI * Center / SampleRate;
+		const float Alpha = FMath::Sin(W0) * (High - Low) / (2.0f * Center);
+		const float A0 = 1.0f + Alpha;
+		Filter.B0 = Alpha / A0;
+		Filter.A1 = -2.0f * FMath::Cos(W0) / A0;
+		Filter.A2 = (1.0f - Alpha) / A0;
+	}
+}
+
+bool FOVRLipSyncReferenceBackend::ProcessFrame(const int16 *Data, int32 NumSamples, bool Stereo,
+											   TArrayView<float> OutVisemes, float &OutLaughterScore,
+											   int32 &OutFrameDelay)
+{
+	if (!Data || NumSamples <= 0 || SampleRate <= 0 || OutVisemes.Num() < ovrLipSyncViseme_Count)
+	{
+		return false;
+	}
+
+	// Band energies, level and zero crossings of the (downmixed) frame
+	float BandEnergy[NumBands] = {};
+	float Energy = 0.0f;
+	const int32 NumChannels = Stereo ? 2 : 1;
+	const float Scale = 1.0f / (32768.0f * NumChannels);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const int16 *Sample = Data + Index * NumChannels;
+		const float X = (Stereo ? float(Sample[0]) + float(Sample[1]) : float(Sample[0])) * Scale;
+		Energy += X * X;
+		for (int32 Band = 0; Band < NumBands; ++Band)
+		{
+			FBand &Filter = Bands[Band];
+			const float Y = Filter.B0 * (X - Filter.X2) - Filter.A1 * Filter.Y1 - Filter.A2 * Filter.Y2;
+			Filter.X2 = Filter.X1;
+			Filter.X1 = X;
+			Filter.Y2 = Filter.Y1;
+			Filter.Y1 = Y;
+			BandEnergy[Band] += Y * Y;
+		}
+	}
+
+	const float Level = 10.0f * FMath::LogX(10.0f, Energy / NumSamples + 1e-10f);
+	const float Activity = SmoothStep(SilenceLevel, SpeechLevel, Level);
+	const float Plosive = FMath::Clamp((Level - PreviousLevel - OnsetRise) / (2.0f * OnsetRise), 0.0f, 1.0f) * Activity;
+	PreviousLevel = Level;
+
+	float TotalBandEnergy = 1e-20f;
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		TotalBandEnergy += BandEnergy[Band];
+	}
+	float Fraction[NumBands];
+	for (int32 Band = 0; Band < NumBands; ++Band)
+	{
+		Fraction[Band] = BandEnergy[Band] / TotalBandEnergy;
+	}
+
+	// Formant estimates : energy weighted log frequency centroids of the bands
+	auto Centroid = [&](int32 FirstBand, int32 LastBand)
+	{
+		float Weight = 1e-20f;
+		float LogSum = 0.0f;
+		for (int32 Band = FirstBand; Band <= LastBand; ++Band)
+		{
+			Weight += Fraction[Band];
+			LogSum += Fraction[Band] * FMath::Loge(Bands[Band].Center);
+		}
+		return LogSum / Weight;
+	};
+	const float LogF1 = Centroid(0, 2);
+	const float LogF2 = Centroid(2, 4);
+
+	float Target[ovrLipSyncViseme_Count] = {};
+	Target[ovrLipSyncViseme_sil] = 1.0f - Activity;
+
+	// Plosives, split by where the burst energy is
+	const float Bilabial = Fraction[0] + Fraction[1];
+	const float Velar = Fraction[2];
+	const float Alveolar = Fraction[3] + Fraction[4] + Fraction[5] + Fraction[6];
+	Target[ovrLipSyncViseme_PP] = Plosive * Bilabial;
+	Target[ovrLipSyncViseme_kk] = Plosive * Velar;
+	Target[ovrLipSyncViseme_DD] = Plosive * Alveolar;
+
+	// Fricatives : high band share, weak ones are labiodental / dental
+	const float Continuant = Activity - Plosive;
+	const float Frication = FMath::Clamp((Fraction[5] + Fraction[6]) * 1.25f, 0.0f, 1.0f);
+	const float Fricative = Continuant * Frication;
+	const float Weak = 1.0f - SmoothStep(WeakFricativeLevel - 5.0f, WeakFricativeLevel + 5.0f, Level);
+	const float Sibilant = Fraction[6] / (Fraction[5] + Fraction[6] + 1e-20f);
+	Target[ovrLipSyncViseme_SS] = Fricative * (1.0f - Weak) * Sibilant;
+	Target[ovrLipSyncViseme_CH] = Fricative * (1.0f - Weak) * (1.0f - Sibilant);
+	Target[ovrLipSyncViseme_FF] = Fricative * Weak * 0.6f;
+	Target[ovrLipSyncViseme_TH] = Fricative * Weak * 0.4f;
+
+	// Voiced : nasal when the lowest band dominates, otherwise the closest vowel prototypes
+	const float Voiced = Continuant - Fricative;
+	const float Nasality = FMath::Clamp((Fraction[0] - 0.6f) * 2.5f, 0.0f, 1.0f);
+	Target[ovrLipSyncViseme_nn] = Voiced * Nasality;
+
+	float Match[NumVowelPrototypes];
+	float MatchSum = 1e-20f;
+	for (int32 Vowel = 0; Vowel < NumVowelPrototypes; ++Vowel)
+	{
+		const float D1 = (LogF1 - FMath::Loge(VowelPrototypes[Vowel].F1)) / FormantSpread;
+		const float D2 = (LogF2 - FMath::Loge(VowelPrototypes[Vowel].F2)) / FormantSpread;
+		Match[Vowel] = FMath::Exp(-(D1 * D1 + D2 * D2));
+		MatchSum += Match[Vowel];
+	}
+	for (int32 Vowel = 0; Vowel < NumVowelPrototypes; ++Vowel)
+	{
+		Target[VowelPrototypes[Vowel].Viseme] = Voiced * (1.0f - Nasality) * Match[Vowel] / MatchSum;
+	}
+
+	// Smooth towards the frame's estimate and keep the scores a distribution like the SDK's
+	float Sum = 1e-20f;
+	for (int32 Viseme = 0; Viseme < ovrLipSyncViseme_Count; ++Viseme)
+	{
+		const float Rate = Target[Viseme] > Smoothed[Viseme] ? Attack : Release;
+		Smoothed[Viseme] += (Target[Viseme] - Smoothed[Viseme]) * Rate;
+		Sum += Smoothed[Viseme];
+	}
+	for (int32 Viseme = 0; Viseme < ovrLipSyncViseme_Count; ++Viseme)
+	{
+		OutVisemes[Viseme] = Smoothed[Viseme] / Sum;
+	}
+
+	OutLaughterScore = 0.0f;
+	// The estimator only looks at the current buffer, so there is no lookahead latency to report
+	OutFrameDelay = 0;
+	return true;
+}
+
+bool FOVRLipSyncReferenceBackend::ProcessFrameAsync(const int16 *Data, int32 NumSamples, bool Stereo)
+{
+	// Cheap enough to run on the calling thread
+	float Visemes[ovrLipSyncViseme_Count];
+	float LaughterScore;
+	int32 FrameDelay;
+	if (!ProcessFrame(Data, NumSamples, Stereo, Visemes, LaughterScore, FrameDelay))
+	{
+		return false;
+	}
+	InvokeAsyncCallback(Visemes, LaughterScore);
+	return true;
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncReferenceBackend.h
+ * Content     :   Portable reference viseme estimator
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include "OVRLipSyncBackend.h"
+
+// Pure C++ viseme estimator, available on every platform.
+//
+// Seven band-pass filters split each frame into formant and frication bands. The frame level gives speech activity
+// (sil), level jumps give plosives (PP / DD / kk), the high bands give fricatives (SS / CH / FF / TH) and the first
+// and second formant estimates are matched against vowel prototypes (aa / E / ih / oh / ou / RR, nn for nasal
+// spectra). Much coarser than the SDK's models and no laughter detection, meant for platforms without the SDK and for
+// reproducible headless runs of the pipeline.
+class FOVRLipSyncReferenceBackend : public IOVRLipSyncBackend
+{
+public:
+	explicit FOVRLipSyncReferenceBackend(const FOVRLipSyncBackendSettings &Settings);
+
+	virtual bool IsValid() const override { return SampleRate > 0; }
+	virtual bool ProcessFrame(const int16 *Data, int32 NumSamples, bool Stereo, TArrayView<float> OutVisemes,
+							  float &OutLaughterScore, int32 &OutFrameDelay) override;
+	virtual bool ProcessFrameAsync(const int16 *Data, int32 NumSamples, bool Stereo) override;
+
+private:
+	static constexpr int32 NumBands = 7;
+
+	// Band-pass biquad (b1 = 0, b2 = -b0), state carried across frames
+	struct FBand
+	{
+		float Center = 0.0f;
+		float B0 = 0.0f;
+		float A1 = 0.0f;
+		float A2 = 0.0f;
+		float X1 = 0.0f;
+		float X2 = 0.0f;
+		float Y1 = 0.0f;
+		float Y2 = 0.0f;
+	};
+
+	FBand Bands[NumBands];
+	float Smoothed[ovrLipSyncViseme_Count] = {};
+	// Level of the previous frame in dBFS, for onsets
+	float PreviousLevel = -100.0f;
+	int32 SampleRate = 0;
+};
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSDKBackend.cpp
+ * Content     :   Backend running the prebuilt Oculus Lipsync SDK
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "OVRLipSyncSDKBackend.h"
+
+#if OVRLIPSYNC_WITH_SDK
+#include "OVRLipSyncModule.h"
+#include "Misc/Paths.h"
+
+FOVRLipSyncSDKBackend::FOVRLipSyncSDKBackend(const FOVRLipSyncBackendSettings &Settings)
+{
+#if !PLATFORM_ANDROID
+	auto pluginsDir = FPaths::ProjectPluginsDir();
+	auto libDir = FPaths::Combine(pluginsDir, TEXT("OVRLipSync"), TEXT("ThirdParty"), TEXT("Lib"),
+								  FPlatformProcess::GetBinariesSubdirectory());
+	TArray<char> libDirChar(libDir.GetCharArray());
+	auto rc = ovrLipSync_InitializeEx(Settings.SampleRate, Settings.BufferSize, libDirChar.GetData());
+#else
+	auto rc = ovrLipSync_Initialize(Settings.SampleRate, Settings.BufferSize);
+#endif
+	if (rc != ovrLipSyncSuccess)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Can't initialize ovrLipSync: %d"), rc);
+		return;
+	}
+	rc = Settings.ModelPath.IsEmpty()
+			 ? ovrLipSync_CreateContextEx(&LipSyncContext, Settings.Provider, Settings.SampleRate, Settings.Accelerate)
+			 : ovrLipSync_CreateContextWithModelFile(&LipSyncContext, Settings.Provider,
+													 TCHAR_TO_ANSI(*Settings.ModelPath), Settings.SampleRate,
+													 Settings.Accelerate);
+	if (rc != ovrLipSyncSuccess)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Can't create ovrLipSync context: %d"), rc);
+	}
+}
+
+FOVRLipSyncSDKBackend::~FOVRLipSyncSDKBackend() { ovrLipSync_DestroyContext(LipSyncContext); }
+
+bool FOVRLipSyncSDKBackend::ProcessFrame(const int16 *Data, int32 NumSamples, bool Stereo, TArrayView<float> OutVisemes,
+										 float &OutLaughterScore, int32 &OutFrameDelay)
+{
+	ovrLipSyncFrame frame = {};
+	frame.visemes = OutVisemes.GetData();
+	frame.visemesLength = OutVisemes.Num();
+	auto rc = ovrLipSync_ProcessFrameEx(LipSyncContext, Data, NumSamples,
+										Stereo ? ovrLipSyncAudioDataType_S16_Stereo : ovrLipSyncAudioDataType_S16_Mono,
+										&frame);
+	if (rc != ovrLipSyncSuccess)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to process frame: %d"), rc);
+		return false;
+	}
+	OutLaughterScore = frame.laughterScore;
+	OutFrameDelay = frame.frameDelay;
+	return true;
+}
+
+void FOVRLipSyncSDKBackend::ProcessFrameCallback(void *Opaque, const ovrLipSyncFrame *Frame, ovrLipSyncResult Result)
+{
+	if (Result != ovrLipSyncSuccess)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Async prediction failed: %d"), Result);
+		return;
+	}
+	auto Backend = reinterpret_cast<FOVRLipSyncSDKBackend *>(Opaque);
+	Backend->InvokeAsyncCallback(TConstArrayView<float>(Frame->visemes, Frame->visemesLength), Frame->laughterScore);
+}
+
+bool FOVRLipSyncSDKBackend::ProcessFrameAsync(const int16 *Data, int32 NumSamples, bool Stereo)
+{
+	auto rc = ovrLipSync_ProcessFrameAsync(
+		LipSyncContext, Data, NumSamples,
+		Stereo ? ovrLipSyncAudioDataType_S16_Stereo : ovrLipSyncAudioDataType_S16_Mono, ProcessFrameCallback, this);
+	if (rc != ovrLipSyncSuccess)
+	{
+		UE_LOG(LogOvrLipSync, Error, TEXT("Failed to start async prediction: %d"), rc);
+		return false;
+	}
+	return true;
+}
+#endif
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncSDKBackend.h
+ * Content     :   Backend running the prebuilt Oculus Lipsync SDK
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include "OVRLipSyncBackend.h"
+
+#if OVRLIPSYNC_WITH_SDK
+class FOVRLipSyncSDKBackend : public IOVRLipSyncBackend
+{
+public:
+	explicit FOVRLipSyncSDKBackend(const FOVRLipSyncBackendSettings &Settings);
+	virtual ~FOVRLipSyncSDKBackend() override;
+
+	virtual bool IsValid() const override { return LipSyncContext != 0; }
+	virtual bool ProcessFrame(const int16 *Data, int32 NumSamples, bool Stereo, TArrayView<float> OutVisemes,
+							  float &OutLaughterScore, int32 &OutFrameDelay) override;
+	virtual bool ProcessFrameAsync(const int16 *Data, int32 NumSamples, bool Stereo) override;
+
+private:
+	static void ProcessFrameCallback(void *Opaque, const ovrLipSyncFrame *Frame, ovrLipSyncResult Result);
+
+	ovrLipSyncContext LipSyncContext = 0;
+};
+#endif
@@ -6,11 +6,17 @@
 #include "Sound/SoundSubmix.h"
 #include "Engine/Engine.h"
 #include "ISubmixBufferListener.h"
+
+#include <atomic>
+
 #include "AudioSubmixListener.generated.h"
 
 // 修改委托参数为uint8数组，直接匹配FeedAudio需要的格式
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAudioDataCaptured, const TArray<uint8>&, AudioData);
 
+// 原生版本，不拷贝数据；在音频渲染线程上广播，AudioData 只在回调期间有效
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAudioDataCapturedNative, TConstArrayView<uint8> /*AudioData*/);
+
 // 创建一个纯接口实现类，不继承UObject
 class FSubmixBufferListenerImpl : public ISubmixBufferListener
 {
@@ -44,9 +50,13 @@ public:
     void StopListening();
 
     // 音频数据捕获事件 - 输出uint8格式以匹配FeedAudio
+    // 只在有绑定时广播；动态委托每次广播都会拷贝一次数组（音频线程上的堆分配），C++ 使用者应绑定 OnAudioDataCapturedNative
     UPROPERTY(BlueprintAssignable)
     FOnAudioDataCaptured OnAudioDataCaptured;
 
+    // 同一数据的原生事件，不分配内存
+    FOnAudioDataCapturedNative OnAudioDataCapturedNative;
+
     // 目标采样率
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio Settings")
     int32 TargetSampleRate = 48000;
@@ -58,11 +68,44 @@ protected:
     virtual void BeginDestroy() override;
 
 private:
-    // 重采样音频数据 - 修改为输出uint8格式（16-bit PCM打包为字节数组）
-    void ResampleAudio(const float* InputData, int32 InputSamples, int32 InputSampleRate, TArray<uint8>& OutputData);
+    // 下混为单声道（双声道走 SIMD 快速路径），OutputData 需容纳 NumFrames 个样本
+    static void DownmixToMono(const float* InputData, int32 NumFrames, int32 NumChannels, float* OutputData);
+
+    // 按输入/目标采样率重建多相滤波器系数并清空重采样状态
+    void InitResampler(int32 InputSampleRate, int32 OutputSampleRate);
+
+    // 重采样 ResampleBuffer 中新下混的 NumFrames 个样本，直接转换为 int16 写入环形缓冲
+    void ResampleToRing(int32 NumFrames);
+
+    void WriteToRing(float Sample);
+
+    // 以 10ms 为单位广播环形缓冲中已完整的数据
+    void BroadcastRingChunks(int32 OutputSampleRate);
+
+    // 以下状态只在音频渲染线程访问（第一次 StartListening 注册监听之前除外），预先分配，处理中不再分配内存
+
+    // StartListening 请求音频线程在处理下一块前重置流状态（重采样器、环形缓冲读写位置）
+    std::atomic<bool> bResetRequested{false};
+
+    // [上一块末尾的历史样本][本块下混后的单声道样本]
+    TArray<float> ResampleBuffer;
+
+    // 多相窗函数 sinc 滤波器系数
+    TArray<float> FilterCoefficients;
+
+    // 下一个输出样本在 ResampleBuffer 中的位置，跨块保持相位
+    double ResamplePosition = 0.0;
+    double ResampleStep = 1.0;
+    int32 ResampleInputRate = 0;
+    int32 ResampleOutputRate = 0;
+
+    // 16-bit PCM 环形缓冲
+    TArray<int16> Ring;
+    int32 RingReadIndex = 0;
+    int32 RingCount = 0;
 
-    // 转换为单声道
-    void ConvertToMono(const float* InputData, int32 NumSamples, int32 NumChannels, TArray<float>& OutputData);
+    // 广播给 OnAudioDataCaptured 的字节缓冲，复用
+    TArray<uint8> OutputBytes;
 
     // 当前监听的子混音
     UPROPERTY()
@@ -10,9 +10,16 @@
 #include "CookFrameSequenceAsync.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFrameSequenceCoocked, UOVRLipSyncFrameSequence*, FrameSequence, bool, Success);
+DECLARE_MULTICAST_DELEGATE_OneParam(FFrameSequenceCookProgress, float /* Progress */);
 
 /**
- * 
+ * Cooks a viseme frame sequence from a 16-bit PCM wave.
+ *
+ * The clip is split into segments that are cooked in parallel on the task graph, each with its own lipsync
+ * context. A segment first processes a short warm-up region before its start (discarded) so the model state
+ * approximates a sequential cook, then the segments are stitched in order. Frames right after a segment
+ * boundary may therefore differ slightly from a sequential cook. The sequence object is created on the game
+ * thread.
  */
 UCLASS()
 class OVRLIPSYNC_API UCookFrameSequenceAsync : public UBlueprintAsyncActionBase
@@ -26,8 +33,20 @@ public:
     UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"), Category = "LipSync")
         static UCookFrameSequenceAsync* CookFrameSequence(const TArray<uint8>& RawSamples);
 
+    /** Called on the game thread while cooking with the cooked fraction (0..1) */
+    FFrameSequenceCookProgress OnFrameSequenceCookProgress;
+
+    UFUNCTION(BlueprintPure, Category = "LipSync")
+        float GetProgress() const { return Progress; }
+
     TArray<uint8> RawSamples;
     bool UseOfflineModel;
 
     virtual void Activate() override;
+
+private:
+    void ReportProgress(float InProgress);
+    void Finish(UOVRLipSyncFrameSequence* Sequence, bool Success);
+
+    float Progress = 0.0f;
 };
@@ -53,6 +53,16 @@ public:
 					  AutoCreateRefTerm = "MorphTargetNames"))
 	void AssignVisemesToMorphTargets(USkeletalMeshComponent *Mesh, const TArray<FString> &MorphTargetNames);
 
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Resolve the mesh and morph target names once for ApplyBoundMorphTargets. Empty names "
+								"use the viseme names, a null mesh the owner's skeletal mesh",
+					  AutoCreateRefTerm = "MorphTargetNames"))
+	bool BindMorphTargets(USkeletalMeshComponent *Mesh, const TArray<FString> &MorphTargetNames);
+
+	UFUNCTION(BlueprintCallable, Category = "LipSync",
+			  Meta = (Tooltip = "Set the morph targets bound with BindMorphTargets to the predicted viseme scores"))
+	void ApplyBoundMorphTargets();
+
 	UPROPERTY(BlueprintAssignable, Category = "LipSync",
 			  Meta = (Tooltip = "Event triggered when new prediction is ready"))
 	FOVRLipSyncVisemesDataReadyDelegate OnVisemesReady;
@@ -65,4 +75,14 @@ protected:
 	TArray<float> Visemes;
 
 	static const TArray<FString> VisemeNames;
+
+private:
+	// Mapping resolved by BindMorphTargets, BoundMorphTargets[i] receives Visemes[i] (NAME_None is skipped)
+	TWeakObjectPtr<USkeletalMeshComponent> BoundMesh;
+	TArray<FName> BoundMorphTargets;
+	// Names the mapping was built from, lets AssignVisemesToMorphTargets reuse it
+	TArray<FString> BoundMorphTargetNames;
+	// Arguments the mapping was built from: a null mesh (owner's skeletal mesh) and empty names (viseme names)
+	bool bBoundFromOwnerMesh = false;
+	bool bBoundDefaultNames = false;
 };
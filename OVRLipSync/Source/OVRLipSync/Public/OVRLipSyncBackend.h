@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncBackend.h
+ * Content     :   Viseme analysis backend interface
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSync.h"
+
+// Parameters a backend is created with, mirrors the SDK context creation
+struct FOVRLipSyncBackendSettings
+{
+	ovrLipSyncContextProvider Provider = ovrLipSyncContextProvider_Enhanced;
+	int32 SampleRate = 48000;
+	int32 BufferSize = 4096;
+	// Offline model file, empty to use the SDK's built-in model
+	FString ModelPath;
+	bool Accelerate = true;
+};
+
+// Viseme analysis behind UOVRLipSyncContextWrapper.
+//
+// The default backend is the prebuilt Oculus SDK where it exists (OVRLIPSYNC_WITH_SDK) and the portable reference
+// estimator everywhere else. OVRLipSync.Backend 1 forces the reference backend, SetFactory plugs in another one.
+class OVRLIPSYNC_API IOVRLipSyncBackend
+{
+public:
+	using AsyncCallbackType = TFunction<void(TConstArrayView<float> Visemes, float LaughterScore)>;
+	using FFactory = TFunction<TUniquePtr<IOVRLipSyncBackend>(const FOVRLipSyncBackendSettings &Settings)>;
+
+	virtual ~IOVRLipSyncBackend() = default;
+
+	// False when the backend could not be created (e.g. SDK initialization failed)
+	virtual bool IsValid() const = 0;
+
+	// Analyzes NumSamples samples (per channel) of 16-bit PCM. OutVisemes receives ovrLipSyncViseme_Count scores
+	virtual bool ProcessFrame(const int16 *Data, int32 NumSamples, bool Stereo, TArrayView<float> OutVisemes,
+							  float &OutLaughterScore, int32 &OutFrameDelay) = 0;
+
+	// Like ProcessFrame, the result is passed to the async callback, possibly on another thread
+	virtual bool ProcessFrameAsync(const int16 *Data, int32 NumSamples, bool Stereo) = 0;
+
+	void SetAsyncCallback(const AsyncCallbackType &Callback) { AsyncCallback = Callback; }
+
+	// Creates the backend selected for this platform, or the one of the factory set with SetFactory
+	static TUniquePtr<IOVRLipSyncBackend> Create(const FOVRLipSyncBackendSettings &Settings);
+
+	// Replaces the default backend selection, an unbound factory restores it. Game thread only
+	static void SetFactory(FFactory Factory);
+
+	// Whether Create makes SDK backends
+	static bool UsesSDK();
+
+protected:
+	void InvokeAsyncCallback(TConstArrayView<float> Visemes, float LaughterScore);
+
+private:
+	AsyncCallbackType AsyncCallback;
+};
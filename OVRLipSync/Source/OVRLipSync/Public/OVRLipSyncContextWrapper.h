@@ -24,24 +24,29 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "OVRLipSync.h"
+#include "OVRLipSyncBackend.h"
 #include "OVRLipSyncModule.h"
 class OVRLIPSYNC_API UOVRLipSyncContextWrapper
 {
 public:
+	// Runs on the backend IOVRLipSyncBackend::Create selects for this platform
 	UOVRLipSyncContextWrapper(ovrLipSyncContextProvider Provider, int SampleRate = 48000, int BufferSize = 4096,
 							  FString ModelPath = FString(), bool Accelerate = true);
+	// Runs on the given backend, e.g. to benchmark or regression test one backend headlessly
+	explicit UOVRLipSyncContextWrapper(TUniquePtr<IOVRLipSyncBackend> InBackend);
 	~UOVRLipSyncContextWrapper();
 
+	bool IsValid() const { return Backend && Backend->IsValid(); }
+
 	void ProcessFrame(const int16_t *Data, int DataSize, TArray<float> &Visemes, float &LaughterScore,
 					  int32_t &FrameDelay, bool Stereo = false);
 
 	// Async processing
-	using AsyncCallbackType = TFunction<void(const TArray<float> &Visemes, float LaughterScore)>;
+	// Called on the backend's prediction thread, Visemes only lives for the duration of the call
+	using AsyncCallbackType = IOVRLipSyncBackend::AsyncCallbackType;
 	void SetAsyncCallback(const AsyncCallbackType &AsyncCallback);
-	void InvokeAsyncCallback(const TArray<float> &Visemes, float LaughterScore);
 	void ProcessFrameAsync(const int16_t *Data, int DataSize, bool Stereo = false);
 
 private:
-	AsyncCallbackType AsyncCallback;
-	ovrLipSyncContext LipSyncContext = 0;
+	TUniquePtr<IOVRLipSyncBackend> Backend;
 };
@@ -24,8 +24,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OVRLipSync.h"
 #include "OVRLipSyncFrame.generated.h"
 
+// Frame of the original sequence format, only kept to load sequences saved before the compact format
 USTRUCT()
 struct OVRLIPSYNC_API FOVRLipSyncFrame
 {
@@ -43,14 +45,88 @@ struct OVRLIPSYNC_API FOVRLipSyncFrame
 	}
 };
 
+// Storage precision of the scores of a frame sequence
+UENUM()
+enum class EOVRLipSyncFrameQuantization : uint8
+{
+	// 32-bit float, lossless
+	None,
+	// 16 bits per score
+	Bits16,
+	// 8 bits per score
+	Bits8,
+};
+
+// Viseme scores cooked at 100 frames per second.
+//
+// Frames are stored in one contiguous buffer with a fixed stride: ovrLipSyncViseme_Count viseme scores followed by
+// the laughter score, each as a float or quantized to 16 or 8 bits. On disk the scores are delta encoded against the
+// previous frame and runs of unchanged scores (silence) are run-length encoded.
 UCLASS(BlueprintType)
 class OVRLIPSYNC_API UOVRLipSyncFrameSequence : public UObject
 {
 	GENERATED_BODY()
 public:
+	static constexpr int32 NumVisemes = ovrLipSyncViseme_Count;
+	// Visemes and laughter
+	static constexpr int32 NumScores = NumVisemes + 1;
+	static constexpr int32 FramesPerSecond = 100;
+
+	// Legacy per frame storage, moved to the compact storage when loaded
 	UPROPERTY()
 	TArray<FOVRLipSyncFrame> FrameSequence;
-	unsigned Num() const { return FrameSequence.Num(); }
-	void Add(const TArray<float> &Visemes, float LaughterScore) { FrameSequence.Emplace(Visemes, LaughterScore); }
-	const FOVRLipSyncFrame &operator[](unsigned idx) const { return FrameSequence[idx]; }
+
+	int32 Num() const { return NumFrames; }
+	void Reset();
+	void Reserve(int32 InNumFrames);
+
+	// Appends a frame. Missing visemes are zero, extra ones are ignored
+	void Add(TConstArrayView<float> Visemes, float LaughterScore);
+
+	// Decodes frame Index into OutVisemes (at most NumVisemes are written)
+	void GetFrame(int32 Index, TArrayView<float> OutVisemes, float &OutLaughterScore) const;
+
+	// Linearly interpolates the frames around Time (seconds). Returns false when Time is outside the sequence
+	bool Sample(float Time, TArrayView<float> OutVisemes, float &OutLaughterScore) const;
+
+	float GetViseme(int32 Index, int32 Viseme) const { return DecodeScore(Index * NumScores + Viseme); }
+	float GetLaughterScore(int32 Index) const { return DecodeScore(Index * NumScores + NumVisemes); }
+
+	EOVRLipSyncFrameQuantization GetQuantization() const { return Quantization; }
+
+	// Converts the stored frames to another precision
+	void SetQuantization(EOVRLipSyncFrameQuantization InQuantization);
+
+	// UObject interface
+	virtual void Serialize(FArchive &Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx &CumulativeResourceSize) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent &PropertyChangedEvent) override;
+#endif
+	// End of UObject interface
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "LipSync")
+	EOVRLipSyncFrameQuantization Quantization = EOVRLipSyncFrameQuantization::None;
+
+private:
+	int32 GetBytesPerScore() const { return GetBytesPerScore(EncodedQuantization); }
+	static int32 GetBytesPerScore(EOVRLipSyncFrameQuantization InQuantization);
+	float DecodeScore(int32 ScoreIndex) const;
+	void DecodeScores(int32 FirstScore, int32 Count, float *OutScores) const;
+	void EncodeScore(uint8 *Dest, float Score) const;
+
+	// On disk format of Scores : per score delta to the previous frame, zero runs length encoded
+	void EncodeDeltaRuns(TArray<uint8> &OutData) const;
+	bool DecodeDeltaRuns(const TArray<uint8> &Data);
+
+	// Moves FrameSequence to the compact storage
+	void ConvertLegacyFrames();
+
+	// NumFrames * NumScores scores in EncodedQuantization
+	TArray<uint8> Scores;
+	int32 NumFrames = 0;
+
+	// Precision of Scores. Differs from Quantization only while it is edited
+	EOVRLipSyncFrameQuantization EncodedQuantization = EOVRLipSyncFrameQuantization::None;
 };
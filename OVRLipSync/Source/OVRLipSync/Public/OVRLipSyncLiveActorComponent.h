@@ -24,6 +24,7 @@
 #pragma once
 
 #include "OVRLipSyncActorComponentBase.h"
+#include "OVRLipSyncVisemeSlot.h"
 #include "OVRLipSyncLiveActorComponent.generated.h"
 
 class IVoiceCapture;
@@ -43,6 +44,8 @@ class OVRLIPSYNC_API UOVRLipSyncActorComponent : public UOVRLipSyncActorComponen
 	GENERATED_BODY()
 
 public:
+	UOVRLipSyncActorComponent();
+
 	UPROPERTY(EditAnywhere, Category = "LipSync")
 	FString DefaultDeviceName = "";
 
@@ -76,12 +79,17 @@ protected:
 	virtual void BeginPlay() override;
 	// Called when the game ends
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// Delivers the newest prediction on the game thread
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+							   FActorComponentTickFunction *ThisTickFunction) override;
 
 	UFUNCTION()
 	void OnVoiceCaptureTimer();
 
 private:
 	TSharedPtr<UOVRLipSyncContextWrapper> LipSyncContext;
+	// Written by the async prediction callback, consumed once per tick
+	FOVRLipSyncVisemeSlot LatestVisemes;
 
 	TSharedPtr<IVoiceCapture> VoiceCapture;
 	FTimerHandle VoiceCaptureTimer;
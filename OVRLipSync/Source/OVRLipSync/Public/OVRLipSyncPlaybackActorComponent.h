@@ -44,6 +44,10 @@ public:
 	UPROPERTY(BlueprintReadonly, Category = "LipSync")
 	UAudioComponent *AudioComponent;
 
+	UPROPERTY(EditAnywhere, Category = "LipSync", Meta = (ClampMin = "0.0",
+			  Tooltip = "OnVisemesReady is only broadcast when a score changed by more than this since the last broadcast"))
+	float BroadcastThreshold = 0.001f;
+
 	UFUNCTION(BlueprintCallable, Category = "LipSync", Meta = (Tooltip = "Start playback of the canned sequence synchronized with AudioComponent"))
 	void Start(UAudioComponent *InAudioComponent, UOVRLipSyncFrameSequence *InSequence);
 
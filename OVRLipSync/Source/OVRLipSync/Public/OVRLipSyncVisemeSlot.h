@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Filename    :   OVRLipSyncVisemeSlot.h
+ * Content     :   Latest viseme frame handed from the SDK to the game thread
+ * Created     :   Aug 9th, 2018
+ * Copyright   :   Copyright Facebook Technologies, LLC and its affiliates.
+ *                 All rights reserved.
+ *
+ * Licensed under the Oculus Audio SDK License Version 3.3 (the "License");
+ * you may not use the Oculus Audio SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/audio-3.3/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus Audio SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OVRLipSync.h"
+
+#include <atomic>
+
+// Single producer / single consumer latest-value slot (triple buffer).
+//
+// The producer (the SDK's async prediction thread) publishes frames without locking or allocating, the consumer
+// (the game thread) takes the newest published frame. Frames published between two reads are dropped.
+class FOVRLipSyncVisemeSlot
+{
+public:
+	struct FFrame
+	{
+		float Visemes[ovrLipSyncViseme_Count] = {};
+		float LaughterScore = 0.0f;
+	};
+
+	// Producer side
+	void Publish(TConstArrayView<float> Visemes, float LaughterScore)
+	{
+		FFrame &Frame = Frames[WriteIndex];
+		const int32 Count = FMath::Min(Visemes.Num(), int32(ovrLipSyncViseme_Count));
+		FMemory::Memcpy(Frame.Visemes, Visemes.GetData(), Count * sizeof(float));
+		FMemory::Memzero(Frame.Visemes + Count, (ovrLipSyncViseme_Count - Count) * sizeof(float));
+		Frame.LaughterScore = LaughterScore;
+		WriteIndex = Shared.exchange(WriteIndex | NewFrameFlag, std::memory_order_acq_rel) & IndexMask;
+	}
+
+	// Consumer side. Returns nullptr when nothing was published since the last call
+	const FFrame *Consume()
+	{
+		if ((Shared.load(std::memory_order_relaxed) & NewFrameFlag) == 0)
+		{
+			return nullptr;
+		}
+		ReadIndex = Shared.exchange(ReadIndex, std::memory_order_acq_rel) & IndexMask;
+		return &Frames[ReadIndex];
+	}
+
+	// Drops a published frame that was not consumed yet. Consumer side
+	void Discard() { Consume(); }
+
+private:
+	static constexpr uint8 IndexMask = 0x3;
+	static constexpr uint8 NewFrameFlag = 0x4;
+
+	FFrame Frames[3];
+	// Index of the frame neither side owns, with NewFrameFlag while it holds an unread frame
+	std::atomic<uint8> Shared{0};
+	uint8 WriteIndex = 1;
+	uint8 ReadIndex = 2;
+};